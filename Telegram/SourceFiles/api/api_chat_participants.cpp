@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "api/api_chat_participants.h"
 
+#include "api/api_hash.h"
 #include "apiwrap.h"
 #include "boxes/add_contact_box.h" // ShowAddParticipantsError
 #include "data/data_changes.h"
@@ -116,6 +117,8 @@ void ApplyLastList(
 			| MegagroupInfo::LastParticipantsOnceReceived;
 
 	auto botStatus = channel->mgInfo->botStatus;
+	auto added = base::flat_set<not_null<UserData*>>();
+	added.reserve(list.size());
 	for (const auto &p : list) {
 		const auto participant = channel->owner().peer(p.id());
 		const auto user = participant->asUser();
@@ -128,8 +131,7 @@ void ApplyLastList(
 				Data::ChannelAdminChanges(channel).add(p.userId(), p.rank());
 			}
 		}
-		if (user
-			&& !base::contains(channel->mgInfo->lastParticipants, user)) {
+		if (user && added.emplace(user).second) {
 			channel->mgInfo->lastParticipants.push_back(user);
 			if (adminRights.flags) {
 				channel->mgInfo->lastAdmins.emplace(
@@ -369,8 +371,20 @@ void ChatParticipants::requestLast(not_null<ChannelData*> channel) {
 		return;
 	}
 
+	// Pass the hash of the already received list, so an unchanged list
+	// comes back as channelParticipantsNotModified instead of a full
+	// slice that we would parse and apply for no visible change.
+	const auto &cached = channel->mgInfo->lastParticipants;
+	const auto hashUsable = !cached.empty()
+		&& (channel->mgInfo->lastParticipantsStatus
+			& MegagroupInfo::LastParticipantsOnceReceived);
 	const auto offset = 0;
-	const auto participantsHash = uint64(0);
+	const auto participantsHash = hashUsable
+		? CountHash(cached | ranges::views::transform([](
+				not_null<UserData*> user) {
+			return peerToUser(user->id).bare;
+		}))
+		: uint64(0);
 	const auto requestId = _api.request(MTPchannels_GetParticipants(
 		channel->inputChannel,
 		MTP_channelParticipantsRecent(),
@@ -383,9 +397,12 @@ void ChatParticipants::requestLast(not_null<ChannelData*> channel) {
 		result.match([&](const MTPDchannels_channelParticipants &data) {
 			const auto &[availableCount, list] = Parse(channel, data);
 			ApplyLastList(channel, availableCount, list);
-		}, [](const MTPDchannels_channelParticipantsNotModified &) {
-			LOG(("API Error: "
-				"channels.channelParticipantsNotModified received!"));
+		}, [&](const MTPDchannels_channelParticipantsNotModified &) {
+			// Our cached list hash matched, the list didn't change.
+			channel->mgInfo->lastParticipantsStatus
+				= MegagroupInfo::LastParticipantsUpToDate
+					| MegagroupInfo::LastParticipantsOnceReceived;
+			channel->mgInfo->lastParticipantsCount = channel->membersCount();
 		});
 	}).fail([this, channel] {
 		_participantsRequests.remove(channel);
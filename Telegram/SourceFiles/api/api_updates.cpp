@@ -463,17 +463,21 @@ void Updates::differenceDone(const MTPupdates_Difference &result) {
 	} break;
 	case mtpc_updates_differenceSlice: {
 		auto &d = result.c_updates_differenceSlice();
-		feedDifference(d.vusers(), d.vchats(), d.vnew_messages(), d.vother_updates());
-
 		auto &s = d.vintermediate_state().c_updates_state();
 		setState(s.vpts().v, s.vdate().v, s.vqts().v, s.vseq().v);
 
-		_ptsWaiter.setRequesting(false);
-
 		MTP_LOG(0, ("getDifference "
 			"{ good - after a slice of difference was received }%1"
 			).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
-		getDifference();
+
+		// The next slice is requested from the intermediate state before
+		// the received one is applied, so on long catch-ups the network
+		// round trip overlaps with the main-thread apply instead of
+		// waiting for it. The pts waiter stays in the requesting state
+		// until the final slice, updates apply without gap checks anyway.
+		sendDifferenceRequest();
+
+		feedDifference(d.vusers(), d.vchats(), d.vnew_messages(), d.vother_updates());
 	} break;
 	case mtpc_updates_difference: {
 		auto &d = result.c_updates_difference();
@@ -664,6 +668,10 @@ void Updates::getDifference() {
 
 	_ptsWaiter.setRequesting(true);
 
+	sendDifferenceRequest();
+}
+
+void Updates::sendDifferenceRequest() {
 	api().request(MTPupdates_GetDifference(
 		MTP_flags(0),
 		MTP_int(_ptsWaiter.current()),
@@ -992,6 +1000,12 @@ void Updates::handleSendActionUpdate(
 	if (action.type() == mtpc_speakingInGroupCallAction) {
 		handleSpeakingInCall(peer, fromId, from);
 	}
+	if (session().windows().empty()) {
+		// Typing previews and emoji interactions only feed the UI, so
+		// don't animate and accumulate them for accounts that are not
+		// shown in any window, busy chats send them all the time.
+		return;
+	}
 	if (!from || !from->isUser() || from->isSelf()) {
 		return;
 	} else if (action.type() == mtpc_sendMessageEmojiInteraction) {
@@ -104,6 +104,7 @@ private:
 		ChannelDifferenceRequest from = ChannelDifferenceRequest::Unknown);
 	void differenceDone(const MTPupdates_Difference &result);
 	void differenceFail(const MTP::Error &error);
+	void sendDifferenceRequest();
 	void feedDifference(
 		const MTPVector<MTPUser> &users,
 		const MTPVector<MTPChat> &chats,
@@ -47,6 +47,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_histories.h"
 #include "data/data_wall_paper.h"
 #include "data/stickers/data_stickers.h"
+#include "dialogs/dialogs_indexed_list.h"
 #include "dialogs/dialogs_key.h"
 #include "core/core_cloud_password.h"
 #include "core/application.h"
@@ -105,6 +106,12 @@ constexpr auto kNotifySettingSaveTimeout = crl::time(1000);
 constexpr auto kDialogsFirstLoad = 20;
 constexpr auto kDialogsPerPage = 500;
 
+// Resolved link previews are remembered for a while, a no-preview
+// answer is remembered for a shorter time in case the page appears.
+constexpr auto kWebPagePreviewCacheTime = 60 * 60 * crl::time(1000);
+constexpr auto kWebPagePreviewNegativeCacheTime = 5 * 60 * crl::time(1000);
+constexpr auto kWebPagePreviewCacheLimit = 1024;
+
 using PhotoFileLocationId = Data::PhotoFileLocationId;
 using DocumentFileLocationId = Data::DocumentFileLocationId;
 using UpdatedFileReferences = Data::UpdatedFileReferences;
@@ -675,10 +682,12 @@ void ApiWrap::requestContacts() {
 		return;
 	}
 	_contactsRequestId = request(MTPcontacts_GetContacts(
-		MTP_long(0) // hash
+		MTP_long(countContactsHash())
 	)).done([=](const MTPcontacts_Contacts &result) {
 		_contactsRequestId = 0;
 		if (result.type() == mtpc_contacts_contactsNotModified) {
+			// The snapshot-restored contacts match the server state.
+			_session->data().contactsLoaded() = true;
 			return;
 		}
 		Assert(result.type() == mtpc_contacts_contacts);
@@ -693,11 +702,27 @@ void ApiWrap::requestContacts() {
 			}
 		}
 		_session->data().contactsLoaded() = true;
+		_session->local().writeContactsSnapshot();
 	}).fail([=] {
 		_contactsRequestId = 0;
 	}).send();
 }
 
+uint64 ApiWrap::countContactsHash() const {
+	auto ids = std::vector<BareId>();
+	const auto list = _session->data().contactsList();
+	ids.reserve(list->size());
+	for (const auto &row : *list) {
+		if (const auto history = row->history()) {
+			if (const auto user = history->peer->asUser()) {
+				ids.push_back(peerToUser(user->id).bare);
+			}
+		}
+	}
+	ranges::sort(ids);
+	return Api::CountHash(ids);
+}
+
 void ApiWrap::requestDialogs(Data::Folder *folder) {
 	if (folder && !_foldersLoadState.contains(folder)) {
 		_foldersLoadState.emplace(folder, DialogsLoadState());
@@ -2158,6 +2183,30 @@ void ApiWrap::clearWebPageRequests() {
 	_webPagesTimer.cancel();
 }
 
+std::optional<WebPageId> ApiWrap::webPagePreviewCached(
+		const QString &links) const {
+	const auto i = _webPagePreviewCache.find(links);
+	if (i == end(_webPagePreviewCache)) {
+		return std::nullopt;
+	} else if (i->second.till <= crl::now()) {
+		_webPagePreviewCache.erase(i);
+		return std::nullopt;
+	}
+	return i->second.id;
+}
+
+void ApiWrap::cacheWebPagePreview(const QString &links, WebPageId id) {
+	if (_webPagePreviewCache.size() >= kWebPagePreviewCacheLimit) {
+		_webPagePreviewCache.clear();
+	}
+	_webPagePreviewCache[links] = WebPagePreviewCacheEntry{
+		id,
+		crl::now() + (id
+			? kWebPagePreviewCacheTime
+			: kWebPagePreviewNegativeCacheTime),
+	};
+}
+
 void ApiWrap::resolveWebPages() {
 	auto ids = QVector<MTPInputMessage>(); // temp_req_id = -1
 	using IndexAndMessageIds = QPair<int32, QVector<MTPInputMessage>>;
@@ -218,6 +218,12 @@ public:
 	void clearWebPageRequest(WebPageData *page);
 	void clearWebPageRequests();
 
+	// Resolved link previews are shared by all the compose boxes,
+	// id == 0 means the server returned no preview for these links.
+	[[nodiscard]] std::optional<WebPageId> webPagePreviewCached(
+		const QString &links) const;
+	void cacheWebPagePreview(const QString &links, WebPageId id);
+
 	void scheduleStickerSetRequest(uint64 setId, uint64 access);
 	void requestStickerSets();
 	void saveStickerSets(
@@ -442,6 +448,8 @@ private:
 		const QDate &date,
 		Callback &&callback);
 
+	[[nodiscard]] uint64 countContactsHash() const;
+
 	void sharedMediaDone(
 		not_null<PeerData*> peer,
 		SharedMediaType type,
@@ -532,6 +540,14 @@ private:
 	QMap<WebPageData*, mtpRequestId> _webPagesPending;
 	base::Timer _webPagesTimer;
 
+	struct WebPagePreviewCacheEntry {
+		WebPageId id = 0;
+		crl::time till = 0;
+	};
+	mutable base::flat_map<
+		QString,
+		WebPagePreviewCacheEntry> _webPagePreviewCache;
+
 	QMap<uint64, QPair<uint64, mtpRequestId> > _stickerSetRequests;
 
 	QMap<ChannelData*, mtpRequestId> _channelAmInRequests;
@@ -0,0 +1,101 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace Benchmarks {
+namespace {
+
+// The clock is sampled once per batch to keep it out of tight loops.
+constexpr auto kBatchSize = qint64(64);
+constexpr auto kMinRunNs = qint64(300) * 1000 * 1000;
+
+struct Case {
+	const char *name = nullptr;
+	void (*body)(State &state) = nullptr;
+};
+
+[[nodiscard]] std::vector<Case> &Registry() {
+	static auto result = std::vector<Case>();
+	return result;
+}
+
+[[nodiscard]] qint64 NowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+bool State::next() {
+	if (!_startNs) {
+		_startNs = NowNs();
+		return true;
+	}
+	++_iterations;
+	if ((_iterations % kBatchSize) != 0) {
+		return true;
+	}
+	const auto now = NowNs();
+	if (now - _startNs >= kMinRunNs) {
+		_finishNs = now;
+		return false;
+	}
+	return true;
+}
+
+bool Register(const char *name, void (*body)(State &state)) {
+	Registry().push_back({ name, body });
+	return true;
+}
+
+int RunAll(const QString &jsonPath) {
+	auto list = QJsonArray();
+	for (const auto &single : Registry()) {
+		auto state = State();
+		single.body(state);
+		const auto iterations = state.iterations();
+		const auto perIteration = iterations
+			? (state.elapsedNs() / double(iterations))
+			: 0.;
+		printf(
+			"%-32s %12lld iterations %16.1f ns/iteration\n",
+			single.name,
+			(long long)iterations,
+			perIteration);
+		list.push_back(QJsonObject{
+			{ "name", single.name },
+			{ "iterations", iterations },
+			{ "ns_per_iteration", perIteration },
+		});
+	}
+	const auto document = QJsonDocument(QJsonObject{
+		{ "benchmarks", list },
+	});
+	const auto json = document.toJson(QJsonDocument::Indented);
+	if (jsonPath.isEmpty()) {
+		printf("%s", json.constData());
+		return 0;
+	}
+	auto file = QFile(jsonPath);
+	if (!file.open(QIODevice::WriteOnly) || !file.write(json)) {
+		printf("Could not write results to '%s'.\n", jsonPath.toUtf8().constData());
+		return -1;
+	}
+	printf("Results written to '%s'.\n", jsonPath.toUtf8().constData());
+	return 0;
+}
+
+} // namespace Benchmarks
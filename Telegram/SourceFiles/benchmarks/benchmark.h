@@ -0,0 +1,54 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <QtCore/QString>
+
+namespace Benchmarks {
+
+// Drives the measured loop of a single benchmark case:
+//
+//   BENCHMARK(TextLayoutPlain) {
+//       const auto input = PrepareInput();
+//       while (state.next()) {
+//           ... one measured iteration ...
+//       }
+//   }
+//
+// The loop runs until enough time was sampled for a stable result.
+class State final {
+public:
+	[[nodiscard]] bool next();
+
+	[[nodiscard]] qint64 iterations() const {
+		return _iterations;
+	}
+	[[nodiscard]] qint64 elapsedNs() const {
+		return _finishNs - _startNs;
+	}
+
+private:
+	qint64 _iterations = 0;
+	qint64 _startNs = 0;
+	qint64 _finishNs = 0;
+
+};
+
+bool Register(const char *name, void (*body)(State &state));
+
+// Runs all the registered cases and writes the results as JSON, to the
+// given path or to stdout when the path is empty.
+int RunAll(const QString &jsonPath);
+
+} // namespace Benchmarks
+
+#define BENCHMARK(name) \
+	static void Benchmark##name(::Benchmarks::State &state); \
+	static const auto kRegistered##name \
+		= ::Benchmarks::Register(#name, Benchmark##name); \
+	static void Benchmark##name(::Benchmarks::State &state)
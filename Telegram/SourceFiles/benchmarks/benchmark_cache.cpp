@@ -0,0 +1,116 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include "storage/cache/storage_cache_database.h"
+#include "storage/storage_encryption.h"
+#include "base/bytes.h"
+
+#include <crl/crl.h>
+#include <QtCore/QTemporaryDir>
+
+namespace Benchmarks {
+namespace {
+
+constexpr auto kValueSize = 16 * 1024;
+constexpr auto kKeptValues = 256;
+
+[[nodiscard]] Storage::EncryptionKey GenerateKey() {
+	auto data = bytes::vector(Storage::EncryptionKey::kSize);
+	bytes::set_random(data);
+	return Storage::EncryptionKey(std::move(data));
+}
+
+[[nodiscard]] Storage::Cache::Database::Settings DatabaseSettings() {
+	auto result = Storage::Cache::Database::Settings();
+	result.clearOnWrongKey = true;
+	result.totalSizeLimit = 64 * 1024 * 1024;
+	result.totalTimeLimit = 0;
+	result.maxDataSize = 8 * 1024 * 1024;
+	return result;
+}
+
+// The database works on its own thread, so each call is waited out
+// through a semaphore - the latency of a single full round-trip is
+// exactly what the client code experiences.
+class Waiter final {
+public:
+	void done() {
+		_semaphore.release();
+	}
+	void wait() {
+		_semaphore.acquire();
+	}
+
+private:
+	crl::semaphore _semaphore;
+
+};
+
+[[nodiscard]] Storage::Cache::Key ValueKey(qint64 index) {
+	return Storage::Cache::Key{
+		quint64(index % kKeptValues) + 1,
+		quint64(index % kKeptValues) + 1,
+	};
+}
+
+} // namespace
+
+BENCHMARK(CacheWrite) {
+	auto dir = QTemporaryDir();
+	auto database = Storage::Cache::Database(
+		dir.filePath("cache"),
+		DatabaseSettings());
+	auto waiter = Waiter();
+	database.open(GenerateKey(), [&](Storage::Cache::Error) {
+		waiter.done();
+	});
+	waiter.wait();
+
+	auto value = QByteArray(kValueSize, char(0x37));
+	while (state.next()) {
+		database.put(
+			ValueKey(state.iterations()),
+			Storage::Cache::Database::TaggedValue(base::duplicate(value), 0),
+			[&](Storage::Cache::Error) { waiter.done(); });
+		waiter.wait();
+	}
+	database.close([&] { waiter.done(); });
+	waiter.wait();
+}
+
+BENCHMARK(CacheRead) {
+	auto dir = QTemporaryDir();
+	auto database = Storage::Cache::Database(
+		dir.filePath("cache"),
+		DatabaseSettings());
+	auto waiter = Waiter();
+	database.open(GenerateKey(), [&](Storage::Cache::Error) {
+		waiter.done();
+	});
+	waiter.wait();
+
+	const auto value = QByteArray(kValueSize, char(0x37));
+	for (auto i = qint64(); i != kKeptValues; ++i) {
+		database.put(
+			ValueKey(i),
+			Storage::Cache::Database::TaggedValue(base::duplicate(value), 0),
+			[&](Storage::Cache::Error) { waiter.done(); });
+		waiter.wait();
+	}
+	while (state.next()) {
+		database.get(ValueKey(state.iterations()), [&](QByteArray &&data) {
+			waiter.done();
+		});
+		waiter.wait();
+	}
+	database.close([&] { waiter.done(); });
+	waiter.wait();
+}
+
+} // namespace Benchmarks
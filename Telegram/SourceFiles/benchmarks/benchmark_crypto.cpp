@@ -0,0 +1,75 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include "mtproto/details/mtproto_aes_ige.h"
+#include "base/openssl_help.h"
+
+#include <cstdio>
+
+namespace Benchmarks {
+namespace {
+
+// An upload part, the unit the crypto pipeline works on.
+constexpr auto kPartSize = 128 * 1024;
+
+struct Sample {
+	QByteArray data;
+	uchar key[32] = { 0 };
+	uchar iv[32] = { 0 };
+};
+
+[[nodiscard]] Sample GenerateSample() {
+	auto result = Sample();
+	result.data = QByteArray(kPartSize, Qt::Uninitialized);
+	bytes::set_random(bytes::make_detached_span(result.data));
+	bytes::set_random(bytes::make_span(result.key));
+	bytes::set_random(bytes::make_span(result.iv));
+	return result;
+}
+
+} // namespace
+
+BENCHMARK(CryptoIgeEncryptPart) {
+	printf(
+		"AES-IGE hardware path: %s.\n",
+		MTP::details::AesIgeHardwareAvailable() ? "yes" : "no");
+	const auto sample = GenerateSample();
+	auto encrypted = QByteArray(kPartSize, Qt::Uninitialized);
+	while (state.next()) {
+		MTP::details::AesIgeEncrypt(
+			sample.data.constData(),
+			encrypted.data(),
+			kPartSize,
+			sample.key,
+			sample.iv);
+	}
+}
+
+BENCHMARK(CryptoIgeDecryptPart) {
+	const auto sample = GenerateSample();
+	auto decrypted = QByteArray(kPartSize, Qt::Uninitialized);
+	while (state.next()) {
+		MTP::details::AesIgeDecrypt(
+			sample.data.constData(),
+			decrypted.data(),
+			kPartSize,
+			sample.key,
+			sample.iv);
+	}
+}
+
+BENCHMARK(CryptoSha256Part) {
+	const auto sample = GenerateSample();
+	const auto span = bytes::make_span(sample.data);
+	while (state.next()) {
+		[[maybe_unused]] const auto hash = openssl::Sha256(span);
+	}
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,73 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include "ui/image/image.h"
+
+#include <QtGui/QLinearGradient>
+#include <QtGui/QPainter>
+
+namespace Benchmarks {
+namespace {
+
+constexpr auto kSourceSize = 1280;
+constexpr auto kThumbnailSize = 320;
+
+[[nodiscard]] QImage GenerateSource() {
+	auto result = QImage(
+		kSourceSize,
+		kSourceSize,
+		QImage::Format_ARGB32_Premultiplied);
+	auto p = QPainter(&result);
+	auto gradient = QLinearGradient(0, 0, kSourceSize, kSourceSize);
+	gradient.setColorAt(0., Qt::cyan);
+	gradient.setColorAt(1., Qt::magenta);
+	p.fillRect(result.rect(), gradient);
+	return result;
+}
+
+} // namespace
+
+BENCHMARK(ImagePrepareScale) {
+	const auto image = Image(GenerateSource());
+	while (state.next()) {
+		[[maybe_unused]] const auto pixmap = image.prepare(
+			kThumbnailSize,
+			kThumbnailSize,
+			{});
+	}
+}
+
+BENCHMARK(ImagePrepareRounded) {
+	const auto image = Image(GenerateSource());
+	const auto args = Images::PrepareArgs{
+		.options = Images::Option::RoundLarge,
+		.outer = QSize(kThumbnailSize, kThumbnailSize),
+	};
+	while (state.next()) {
+		[[maybe_unused]] const auto pixmap = image.prepare(
+			kThumbnailSize,
+			kThumbnailSize,
+			args);
+	}
+}
+
+BENCHMARK(ImagePrepareBlurred) {
+	const auto image = Image(GenerateSource());
+	const auto args = Images::PrepareArgs{
+		.options = Images::Option::Blur,
+	};
+	while (state.next()) {
+		[[maybe_unused]] const auto pixmap = image.prepare(
+			kThumbnailSize,
+			kThumbnailSize,
+			args);
+	}
+}
+
+} // namespace Benchmarks
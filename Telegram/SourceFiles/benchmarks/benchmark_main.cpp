@@ -0,0 +1,25 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include "ui/emoji_config.h"
+#include "ui/style/style_core.h"
+
+#include <QtGui/QGuiApplication>
+
+int main(int argc, char *argv[]) {
+	auto app = QGuiApplication(argc, argv);
+
+	// Text layout and image prepare read fonts and metrics from the
+	// style, so the same environment as the client itself is set up.
+	style::startManager(style::kScaleDefault);
+	Ui::Emoji::Init();
+
+	const auto jsonPath = (argc > 1) ? QString::fromUtf8(argv[1]) : QString();
+	return Benchmarks::RunAll(jsonPath);
+}
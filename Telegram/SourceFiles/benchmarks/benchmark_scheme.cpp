@@ -0,0 +1,69 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include "scheme.h"
+
+namespace Benchmarks {
+namespace {
+
+[[nodiscard]] MTPMessage SampleMessage(int id) {
+	auto entities = QVector<MTPMessageEntity>();
+	entities.push_back(MTP_messageEntityBold(MTP_int(0), MTP_int(20)));
+	entities.push_back(MTP_messageEntityUrl(MTP_int(30), MTP_int(20)));
+	return MTP_message(
+		MTP_flags(MTPDmessage::Flag::f_entities
+			| MTPDmessage::Flag::f_views),
+		MTP_int(id),
+		MTP_peerUser(MTP_long(1)),
+		MTP_peerChannel(MTP_long(1)),
+		MTPMessageFwdHeader(),
+		MTP_long(0), // via_bot_id
+		MTPMessageReplyHeader(),
+		MTP_int(1600000000), // date
+		MTP_string("A rather usual message text of a couple of lines, "
+			"with a https://telegram.org link somewhere inside."),
+		MTPMessageMedia(),
+		MTPReplyMarkup(),
+		MTP_vector<MTPMessageEntity>(entities),
+		MTP_int(100), // views
+		MTP_int(0), // forwards
+		MTPMessageReplies(),
+		MTPint(), // edit_date
+		MTP_string(),
+		MTP_long(0), // grouped_id
+		MTPMessageReactions(),
+		MTPVector<MTPRestrictionReason>(),
+		MTPint()); // ttl_period
+}
+
+} // namespace
+
+BENCHMARK(SchemeWriteMessage) {
+	const auto message = SampleMessage(1);
+	auto buffer = mtpBuffer();
+	while (state.next()) {
+		buffer.resize(0);
+		message.write(buffer);
+	}
+}
+
+BENCHMARK(SchemeReadMessage) {
+	auto buffer = mtpBuffer();
+	SampleMessage(1).write(buffer);
+	while (state.next()) {
+		auto from = buffer.constData();
+		const auto end = from + buffer.size();
+		auto message = MTPMessage();
+		if (!message.read(from, end)) {
+			break;
+		}
+	}
+}
+
+} // namespace Benchmarks
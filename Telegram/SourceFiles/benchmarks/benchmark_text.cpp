@@ -0,0 +1,89 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "benchmarks/benchmark.h"
+
+#include "ui/text/text.h"
+#include "ui/text/text_entity.h"
+#include "styles/style_widgets.h"
+
+namespace Benchmarks {
+namespace {
+
+constexpr auto kLayoutWidth = 400;
+
+[[nodiscard]] QString PlainSample() {
+	auto result = QString();
+	for (auto i = 0; i != 8; ++i) {
+		result += "A rather usual message text of a couple of lines, "
+			"with no formatting, no links and no emoji in it. ";
+	}
+	return result;
+}
+
+[[nodiscard]] TextWithEntities MarkedSample() {
+	auto result = TextWithEntities{ PlainSample() };
+	result.text += "https://telegram.org and some @mention with #tag";
+	const auto length = int(result.text.size());
+	result.entities.push_back(EntityInText(EntityType::Bold, 0, 60));
+	result.entities.push_back(EntityInText(EntityType::Italic, 70, 40));
+	result.entities.push_back(
+		EntityInText(EntityType::Code, 120, 20));
+	result.entities.push_back(
+		EntityInText(EntityType::Url, length - 48, 20));
+	return result;
+}
+
+} // namespace
+
+BENCHMARK(TextLayoutPlain) {
+	const auto options = TextParseOptions{
+		TextParseMultiline,
+		0,
+		0,
+		Qt::LayoutDirectionAuto
+	};
+	const auto sample = PlainSample();
+	auto string = Ui::Text::String(kLayoutWidth);
+	while (state.next()) {
+		string.setText(st::defaultTextStyle, sample, options);
+	}
+}
+
+BENCHMARK(TextLayoutMarked) {
+	const auto options = TextParseOptions{
+		TextParseMultiline | TextParseLinks | TextParseHashtags
+			| TextParseMentions,
+		0,
+		0,
+		Qt::LayoutDirectionAuto
+	};
+	const auto sample = MarkedSample();
+	auto string = Ui::Text::String(kLayoutWidth);
+	while (state.next()) {
+		string.setMarkedText(st::defaultTextStyle, sample, options);
+	}
+}
+
+BENCHMARK(TextCountHeight) {
+	const auto options = TextParseOptions{
+		TextParseMultiline,
+		0,
+		0,
+		Qt::LayoutDirectionAuto
+	};
+	auto string = Ui::Text::String(kLayoutWidth);
+	string.setText(st::defaultTextStyle, PlainSample(), options);
+	auto width = kLayoutWidth;
+	while (state.next()) {
+		// The width changes each iteration so the result is not cached.
+		width = (width == kLayoutWidth) ? (kLayoutWidth / 2) : kLayoutWidth;
+		[[maybe_unused]] const auto height = string.countHeight(width);
+	}
+}
+
+} // namespace Benchmarks
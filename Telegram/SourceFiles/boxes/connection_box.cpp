@@ -1071,7 +1071,13 @@ ProxiesBoxController::ProxiesBoxController(not_null<Main::Account*> account)
 	_list = ranges::views::all(
 		_settings.list()
 	) | ranges::views::transform([&](const ProxyData &proxy) {
-		return Item{ ++_idCounter, proxy };
+		auto result = Item{ ++_idCounter, proxy };
+		if (const auto ping = _settings.lastPing(proxy)) {
+			result.state = ItemState::Available;
+			result.ping = ping;
+			result.stale = true;
+		}
+		return result;
 	}) | ranges::to_vector;
 
 	_settings.connectionTypeChanges(
@@ -1170,7 +1176,10 @@ void ProxiesBoxController::refreshChecker(Item &item) {
 	const auto dcId = mtproto->mainDcId();
 	const auto forFiles = false;
 
-	item.state = ItemState::Checking;
+	if (!item.stale) {
+		// Keep showing the last measured ping while rechecking.
+		item.state = ItemState::Checking;
+	}
 	const auto setup = [&](Checker &checker, const bytes::vector &secret) {
 		checker = MTP::details::AbstractConnection::Create(
 			mtproto,
@@ -1217,6 +1226,7 @@ void ProxiesBoxController::refreshChecker(Item &item) {
 		connect(item.checker, Variants::IPv4);
 		connect(item.checkerv6, Variants::IPv6);
 		if (!item.checker && !item.checkerv6) {
+			item.stale = false;
 			item.state = ItemState::Unavailable;
 		}
 	}
@@ -1230,9 +1240,12 @@ void ProxiesBoxController::setupChecker(int id, const Checker &checker) {
 		const auto pingTime = pointer->pingTime();
 		item->checker = nullptr;
 		item->checkerv6 = nullptr;
-		if (item->state == ItemState::Checking) {
+		if (item->state == ItemState::Checking || item->stale) {
+			item->stale = false;
 			item->state = ItemState::Available;
 			item->ping = pingTime;
+			_settings.setLastPing(item->data, pingTime);
+			saveDelayed();
 			updateView(*item);
 		}
 	});
@@ -1245,7 +1258,8 @@ void ProxiesBoxController::setupChecker(int id, const Checker &checker) {
 		}
 		if (!item->checker
 			&& !item->checkerv6
-			&& item->state == ItemState::Checking) {
+			&& (item->state == ItemState::Checking || item->stale)) {
+			item->stale = false;
 			item->state = ItemState::Unavailable;
 			updateView(*item);
 		}
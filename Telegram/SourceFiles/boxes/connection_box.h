@@ -91,6 +91,10 @@ private:
 		ItemState state = ItemState::Checking;
 		int ping = 0;
 
+		// Ping carried over from the previous session, shown while the
+		// running health check confirms or corrects it.
+		bool stale = false;
+
 	};
 
 	std::vector<Item>::iterator findById(int id);
@@ -1752,20 +1752,41 @@ void PeerListContent::searchQueryChanged(QString query) {
 	const auto searchWordsList = TextUtilities::PrepareSearchWords(query);
 	const auto normalizedQuery = searchWordsList.join(' ');
 	if (_normalizedSearchQuery != normalizedQuery) {
+		// Typing only narrows the matches, so a query that extends the
+		// previous one is checked against the previous results instead
+		// of the whole first-letter bucket - each keystroke filters a
+		// shrinking list even in a very large member picker.
+		auto narrowedList = std::vector<not_null<PeerListRow*>>();
+		const auto narrowing = _controller->searchInLocal()
+			&& !_normalizedSearchQuery.isEmpty()
+			&& normalizedQuery.startsWith(_normalizedSearchQuery);
+		if (narrowing) {
+			narrowedList.reserve(_filterResults.size());
+			for (const auto row : _filterResults) {
+				if (!row->isSearchResult()) {
+					narrowedList.push_back(row);
+				}
+			}
+		}
 		setSearchQuery(query, normalizedQuery);
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty());
 
 			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
-			for (const auto &searchWord : searchWordsList) {
-				auto searchWordStart = searchWord[0].toLower();
-				auto it = _searchIndex.find(searchWordStart);
-				if (it == _searchIndex.cend()) {
-					// Some word can't be found in any row.
-					minimalList = nullptr;
-					break;
-				} else if (!minimalList || minimalList->size() > it->second.size()) {
-					minimalList = &it->second;
+			if (narrowing) {
+				minimalList = &narrowedList;
+			} else {
+				for (const auto &searchWord : searchWordsList) {
+					auto searchWordStart = searchWord[0].toLower();
+					auto it = _searchIndex.find(searchWordStart);
+					if (it == _searchIndex.cend()) {
+						// Some word can't be found in any row.
+						minimalList = nullptr;
+						break;
+					} else if (!minimalList
+						|| minimalList->size() > it->second.size()) {
+						minimalList = &it->second;
+					}
 				}
 			}
 			if (minimalList) {
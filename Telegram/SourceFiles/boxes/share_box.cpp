@@ -672,12 +672,14 @@ ShareBox::Inner::Inner(QWidget *parent, const Descriptor &descriptor)
 	if (_descriptor.filterCallback(self)) {
 		_chatsIndexed->addToEnd(self->owner().history(self));
 	}
+	auto keys = std::vector<Dialogs::Key>();
 	const auto addList = [&](not_null<Dialogs::IndexedList*> list) {
+		keys.reserve(keys.size() + list->size());
 		for (const auto &row : list->all()) {
 			if (const auto history = row->history()) {
 				if (!history->peer->isSelf()
 					&& _descriptor.filterCallback(history->peer)) {
-					_chatsIndexed->addToEnd(history);
+					keys.emplace_back(history);
 				}
 			}
 		}
@@ -688,6 +690,7 @@ ShareBox::Inner::Inner(QWidget *parent, const Descriptor &descriptor)
 		addList(folder->chatsList()->indexed());
 	}
 	addList(_descriptor.session->data().contactsNoChatsList());
+	_chatsIndexed->addToEndBulk(keys);
 
 	_filter = qsl("a");
 	updateFilter();
@@ -1274,6 +1277,7 @@ void FastShareMessage(
 		not_null<PeerData*> peer;
 		MessageIdsList msgIds;
 		base::flat_set<mtpRequestId> requests;
+		std::vector<not_null<PeerData*>> failures;
 	};
 	const auto show = std::make_shared<Window::Show>(controller);
 	const auto history = item->history();
@@ -1385,6 +1389,26 @@ void FastShareMessage(
 			}
 			return result;
 		};
+		const auto checkDone = [=] {
+			if (!data->requests.empty() || !show->valid()) {
+				return;
+			}
+			if (data->failures.empty()) {
+				Ui::Toast::Show(
+					show->toastParent(),
+					tr::lng_share_done(tr::now));
+				show->hideLayer();
+			} else {
+				auto text = TextWithEntities();
+				text.append(tr::lng_share_failed(tr::now));
+				for (const auto peer : base::take(data->failures)) {
+					text.append("\n").append(Ui::Text::Bold(peer->name));
+				}
+				show->showBox(
+					Ui::MakeInformBox(text),
+					Ui::LayerOption::KeepOther);
+			}
+		};
 		auto &api = owner->session().api();
 		auto &histories = owner->histories();
 		const auto requestType = Data::Histories::RequestType::Send;
@@ -1415,16 +1439,12 @@ void FastShareMessage(
 				)).done([=](const MTPUpdates &updates, mtpRequestId reqId) {
 					history->session().api().applyUpdates(updates);
 					data->requests.remove(reqId);
-					if (data->requests.empty()) {
-						if (show->valid()) {
-							Ui::Toast::Show(
-								show->toastParent(),
-								tr::lng_share_done(tr::now));
-							show->hideLayer();
-						}
-					}
+					checkDone();
 					finish();
-				}).fail([=] {
+				}).fail([=](const MTP::Error &error, mtpRequestId reqId) {
+					data->requests.remove(reqId);
+					data->failures.push_back(peer);
+					checkDone();
 					finish();
 				}).afterRequest(history->sendRequestId).send();
 				return history->sendRequestId;
@@ -758,7 +758,7 @@ not_null<Lottie::MultiPlayer*> StickerSetBox::Inner::getLottiePlayer() {
 	if (!_lottiePlayer) {
 		_lottiePlayer = std::make_unique<Lottie::MultiPlayer>(
 			Lottie::Quality::Default,
-			Lottie::MakeFrameRenderer());
+			ChatHelpers::PanelLottieRenderer());
 		_lottiePlayer->updates(
 		) | rpl::start_with_next([=] {
 			updateItems();
@@ -111,6 +111,12 @@ private:
 
 	QImage _bottomShadow;
 
+	// Rotating a full frame allocates, so the result is kept while the
+	// overlaying controls trigger repaints of the same frame.
+	QImage _rotatedFrame;
+	int _rotatedFrameIndex = -1;
+	int _rotatedFrameRotation = 0;
+
 };
 
 Panel::Incoming::RendererGL::RendererGL(not_null<Incoming*> owner)
@@ -458,7 +464,13 @@ void Panel::Incoming::RendererSW::paintFallback(
 				p.restore();
 			}
 		} else if (rotation) {
-			p.drawImage(rect, RotateFrameImage(image, rotation));
+			if (_rotatedFrameIndex != data.index
+				|| _rotatedFrameRotation != rotation) {
+				_rotatedFrameIndex = data.index;
+				_rotatedFrameRotation = rotation;
+				_rotatedFrame = RotateFrameImage(image, rotation);
+			}
+			p.drawImage(rect, _rotatedFrame);
 		} else {
 			p.drawImage(rect, image);
 		}
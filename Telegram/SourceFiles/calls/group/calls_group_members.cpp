@@ -854,11 +854,13 @@ bool Members::Controller::isMe(not_null<PeerData*> participantPeer) const {
 void Members::Controller::prepareRows(not_null<Data::GroupCall*> real) {
 	auto foundMe = false;
 	auto changed = false;
+	// The sounding map is rebuilt from scratch below - removing the
+	// rows from it one by one rescanned the whole map for each row.
+	_soundingRowBySsrc.clear();
 	auto count = delegate()->peerListFullRowsCount();
 	for (auto i = 0; i != count;) {
 		const auto row = static_cast<Row*>(
 			delegate()->peerListRowAt(i).get());
-		removeRowFromSoundingMap(row);
 		const auto participantPeer = row->peer();
 		const auto me = isMe(participantPeer);
 		if (me) {
@@ -38,7 +38,10 @@ struct LangPackEmoji {
 struct LangPackData {
 	int version = 0;
 	int maxKeyLength = 0;
-	std::map<QString, std::vector<LangPackEmoji>> emoji;
+
+	// A sorted contiguous index, so that a prefix query walks adjacent
+	// memory instead of chasing per-node heap allocations.
+	base::flat_map<QString, std::vector<LangPackEmoji>> emoji;
 };
 
 [[nodiscard]] bool MustAddPostfix(const QString &text) {
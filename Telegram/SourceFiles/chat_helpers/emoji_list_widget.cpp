@@ -404,6 +404,11 @@ EmojiListWidget::EmojiListWidget(
 			: Ui::Emoji::GetSectionCount(section);
 	}
 
+	style::PaletteChanged(
+	) | rpl::start_with_next([=] {
+		invalidateSectionCaches();
+	}, lifetime());
+
 	_picker->chosen(
 	) | rpl::start_with_next([=](EmojiPtr emoji) {
 		colorChosen(emoji);
@@ -425,6 +430,14 @@ void EmojiListWidget::visibleTopBottomUpdated(
 	if (_footer) {
 		_footer->setCurrentSectionIcon(currentSection(visibleTop));
 	}
+
+	// Keep the rasters only for the sections around the visible area.
+	enumerateSections([&](const SectionInfo &info) {
+		if (info.rowsBottom < visibleTop || info.rowsTop >= visibleBottom) {
+			_sectionCaches[info.section] = SectionCache();
+		}
+		return true;
+	});
 }
 
 object_ptr<TabbedSelector::InnerFooter> EmojiListWidget::createFooter() {
@@ -526,15 +539,7 @@ void EmojiListWidget::paintEvent(QPaintEvent *e) {
 	}
 	p.fillRect(r, st::emojiPanBg);
 
-	auto fromColumn = floorclamp(r.x() - _rowsLeft, _singleSize.width(), 0, _columnCount);
-	auto toColumn = ceilclamp(r.x() + r.width() - _rowsLeft, _singleSize.width(), 0, _columnCount);
-	if (rtl()) {
-		qSwap(fromColumn, toColumn);
-		fromColumn = _columnCount - fromColumn;
-		toColumn = _columnCount - toColumn;
-	}
-
-	enumerateSections([this, &p, r, fromColumn, toColumn](const SectionInfo &info) {
+	enumerateSections([this, &p, r](const SectionInfo &info) {
 		if (r.top() >= info.rowsBottom) {
 			return true;
 		} else if (r.top() + r.height() <= info.top) {
@@ -549,37 +554,122 @@ void EmojiListWidget::paintEvent(QPaintEvent *e) {
 			ensureLoaded(info.section);
 			auto fromRow = floorclamp(r.y() - info.rowsTop, _singleSize.height(), 0, info.rowsCount);
 			auto toRow = ceilclamp(r.y() + r.height() - info.rowsTop, _singleSize.height(), 0, info.rowsCount);
-			for (auto i = fromRow; i < toRow; ++i) {
-				for (auto j = fromColumn; j < toColumn; ++j) {
-					auto index = i * _columnCount + j;
-					if (index >= info.count) break;
-
-					const auto selectedIndex = Layout::PositionToIndex(
-						info.section,
-						index);
-					auto selected = (selectedIndex == _selected)
-						|| (!_picker->isHidden()
-							&& selectedIndex == _pickerSel);
-
-					auto w = QPoint(_rowsLeft + j * _singleSize.width(), info.rowsTop + i * _singleSize.height());
-					if (selected) {
-						auto tl = w;
-						if (rtl()) tl.setX(width() - tl.x() - _singleSize.width());
-						Ui::FillRoundRect(p, QRect(tl, _singleSize), st::emojiPanHover, Ui::StickerHoverCorners);
-					}
-					Ui::Emoji::Draw(
-						p,
-						_emoji[info.section][index],
-						_esize,
-						w.x() + (_singleSize.width() - (_esize / cIntRetinaFactor())) / 2,
-						w.y() + (_singleSize.height() - (_esize / cIntRetinaFactor())) / 2);
+			if (fromRow < toRow) {
+				validateSectionCache(info, fromRow, toRow);
+				const auto ratio = cIntRetinaFactor();
+				const auto single = _singleSize.height();
+				p.drawImage(
+					QRect(
+						0,
+						info.rowsTop + fromRow * single,
+						width(),
+						(toRow - fromRow) * single),
+					_sectionCaches[info.section].image,
+					QRect(
+						0,
+						fromRow * single * ratio,
+						width() * ratio,
+						(toRow - fromRow) * single * ratio));
+			}
+			const auto paintSelected = [&](int selectedIndex) {
+				const auto &[section, sel] = Layout::IndexToPosition(
+					selectedIndex);
+				if (section != info.section || sel >= info.count) {
+					return;
+				}
+				const auto row = sel / _columnCount;
+				if (row < fromRow || row >= toRow) {
+					return;
 				}
+				auto w = QPoint(
+					_rowsLeft + (sel % _columnCount) * _singleSize.width(),
+					info.rowsTop + row * _singleSize.height());
+				p.fillRect(QRect(w, _singleSize), st::emojiPanBg);
+				auto tl = w;
+				if (rtl()) tl.setX(width() - tl.x() - _singleSize.width());
+				Ui::FillRoundRect(p, QRect(tl, _singleSize), st::emojiPanHover, Ui::StickerHoverCorners);
+				Ui::Emoji::Draw(
+					p,
+					_emoji[info.section][sel],
+					_esize,
+					w.x() + (_singleSize.width() - (_esize / cIntRetinaFactor())) / 2,
+					w.y() + (_singleSize.height() - (_esize / cIntRetinaFactor())) / 2);
+			};
+			if (_selected >= 0) {
+				paintSelected(_selected);
+			}
+			if (!_picker->isHidden()
+				&& _pickerSel >= 0
+				&& _pickerSel != _selected) {
+				paintSelected(_pickerSel);
 			}
 		}
 		return true;
 	});
 }
 
+void EmojiListWidget::validateSectionCache(
+		const SectionInfo &info,
+		int fromRow,
+		int toRow) {
+	Expects(info.section >= 0 && info.section < kEmojiSectionCount);
+
+	const auto ratio = cIntRetinaFactor();
+	auto &cache = _sectionCaches[info.section];
+	if (cache.width != width()
+		|| int(cache.rowsReady.size()) != info.rowsCount) {
+		cache.width = width();
+		cache.rowsReady.assign(info.rowsCount, false);
+		cache.image = QImage(
+			width() * ratio,
+			info.rowsCount * _singleSize.height() * ratio,
+			QImage::Format_ARGB32_Premultiplied);
+		cache.image.setDevicePixelRatio(cRetinaFactor());
+	}
+	auto p = std::optional<Painter>();
+	for (auto i = fromRow; i < toRow; ++i) {
+		if (cache.rowsReady[i]) {
+			continue;
+		}
+		cache.rowsReady[i] = true;
+		if (!p) {
+			p.emplace(&cache.image);
+		}
+		const auto top = i * _singleSize.height();
+		p->fillRect(0, top, width(), _singleSize.height(), st::emojiPanBg);
+		for (auto j = 0; j != _columnCount; ++j) {
+			const auto index = i * _columnCount + j;
+			if (index >= info.count) {
+				break;
+			}
+			Ui::Emoji::Draw(
+				*p,
+				_emoji[info.section][index],
+				_esize,
+				_rowsLeft
+					+ j * _singleSize.width()
+					+ (_singleSize.width() - (_esize / ratio)) / 2,
+				top + (_singleSize.height() - (_esize / ratio)) / 2);
+		}
+	}
+}
+
+void EmojiListWidget::invalidateCachedCell(int section, int sel) {
+	Expects(section >= 0 && section < kEmojiSectionCount);
+
+	auto &rows = _sectionCaches[section].rowsReady;
+	const auto row = sel / _columnCount;
+	if (row >= 0 && row < int(rows.size())) {
+		rows[row] = false;
+	}
+}
+
+void EmojiListWidget::invalidateSectionCaches() {
+	for (auto &cache : _sectionCaches) {
+		cache = SectionCache();
+	}
+}
+
 bool EmojiListWidget::checkPickerHide() {
 	if (!_picker->isHidden() && _pickerSel >= 0) {
 		_picker->hideAnimated();
@@ -713,6 +803,7 @@ void EmojiListWidget::colorChosen(EmojiPtr emoji) {
 		const auto &[section, sel] = Layout::IndexToPosition(_pickerSel);
 		if (section >= 0 && section < kEmojiSectionCount) {
 			_emoji[section][sel] = emoji;
+			invalidateCachedCell(section, sel);
 			rtlupdate(emojiRect(section, sel));
 		}
 	}
@@ -790,12 +881,14 @@ void EmojiListWidget::processHideFinished() {
 		_pickerSel = -1;
 	}
 	clearSelection();
+	invalidateSectionCaches();
 }
 
 void EmojiListWidget::refreshRecent() {
 	clearSelection();
 	_emoji[0] = Core::App().settings().recentEmojiSection();
 	_counts[0] = _emoji[0].size();
+	_sectionCaches[0] = SectionCache();
 	resizeToWidth(width());
 }
 
@@ -86,6 +86,15 @@ private:
 		int rowsBottom = 0;
 	};
 
+	// One backing raster per section, rendered row by row on demand,
+	// so that scrolling blits a single image instead of drawing every
+	// visible emoji separately. Selected cells are painted over it.
+	struct SectionCache {
+		QImage image;
+		std::vector<bool> rowsReady;
+		int width = 0;
+	};
+
 	template <typename Callback>
 	bool enumerateSections(Callback callback) const;
 	SectionInfo sectionInfo(int section) const;
@@ -97,6 +106,9 @@ private:
 	bool checkPickerHide();
 
 	void ensureLoaded(int section);
+	void validateSectionCache(const SectionInfo &info, int fromRow, int toRow);
+	void invalidateCachedCell(int section, int sel);
+	void invalidateSectionCaches();
 	void updateSelected();
 	void setSelected(int newSelected);
 
@@ -108,6 +120,7 @@ private:
 
 	int _counts[kEmojiSectionCount];
 	QVector<EmojiPtr> _emoji[kEmojiSectionCount];
+	SectionCache _sectionCaches[kEmojiSectionCount];
 
 	int _rowsLeft = 0;
 	int _columnCount = 1;
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_chat.h"
 #include "data/data_user.h"
 #include "data/data_peer_values.h"
+#include "data/data_changes.h"
 #include "data/data_file_origin.h"
 #include "data/data_session.h"
 #include "data/stickers/data_stickers.h"
@@ -107,7 +108,6 @@ private:
 	void setupWebm(StickerSuggestion &suggestion);
 	void repaintSticker(not_null<DocumentData*> document);
 	void repaintStickerAtIndex(int index);
-	std::shared_ptr<Lottie::FrameRenderer> getLottieRenderer();
 	void clipCallback(
 		Media::Clip::Notification notification,
 		not_null<DocumentData*> document);
@@ -119,7 +119,6 @@ private:
 	const not_null<BotCommandRows*> _brows;
 	const not_null<StickerRows*> _srows;
 	rpl::lifetime _stickersLifetime;
-	std::weak_ptr<Lottie::FrameRenderer> _lottieRenderer;
 	base::unique_qptr<Ui::PopupMenu> _menu;
 	int _stickersPerRow = 1;
 	int _recentInlineBotsInRows = 0;
@@ -189,6 +188,16 @@ FieldAutocomplete::FieldAutocomplete(
 	) | rpl::start_with_next(crl::guard(_inner, [=] {
 		_inner->onParentGeometryChanged();
 	}), lifetime());
+
+	_controller->session().changes().peerUpdates(
+		Data::PeerUpdate::Flag::Name
+		| Data::PeerUpdate::Flag::Username
+		| Data::PeerUpdate::Flag::FullInfo
+		| Data::PeerUpdate::Flag::Members
+	) | rpl::start_with_next([=](const Data::PeerUpdate &) {
+		// Don't refine from possibly outdated rows after such updates.
+		_mentionRowsComplete = false;
+	}, lifetime());
 }
 
 not_null<Window::SessionController*> FieldAutocomplete::controller() const {
@@ -378,18 +387,6 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 	if (_emoji) {
 		srows = getStickerSuggestions();
 	} else if (_type == Type::Mentions) {
-		int maxListSize = _addInlineBots ? cRecentInlineBots().size() : 0;
-		if (_chat) {
-			maxListSize += (_chat->participants.empty() ? _chat->lastAuthors.size() : _chat->participants.size());
-		} else if (_channel && _channel->isMegagroup()) {
-			if (!_channel->lastParticipantsRequestNeeded()) {
-				maxListSize += _channel->mgInfo->lastParticipants.size();
-			}
-		}
-		if (maxListSize) {
-			mrows.reserve(maxListSize);
-		}
-
 		auto filterNotPassedByUsername = [this](UserData *user) -> bool {
 			if (user->username.startsWith(_filter, Qt::CaseInsensitive)) {
 				bool exactUsername = (user->username.size() == _filter.size());
@@ -408,6 +405,51 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 		};
 
 		bool listAllSuggestions = _filter.isEmpty();
+		if (mentionRowsRefinable()) {
+			// The query only grew, so the matches form a subset of the
+			// rows we already have - refilter those instead of walking
+			// the full participant lists on every keystroke.
+			mrows.reserve(_mrows.size());
+			auto index = 0;
+			for (const auto &row : _mrows) {
+				const auto fromRecentBots = (index++ < _recentInlineBotsInRows);
+				if (row.user->isInaccessible()) {
+					continue;
+				} else if (!listAllSuggestions
+					&& (fromRecentBots
+						? filterNotPassedByUsername(row.user)
+						: filterNotPassedByName(row.user))) {
+					continue;
+				}
+				if (fromRecentBots) {
+					++recentInlineBots;
+				}
+				mrows.push_back(row);
+			}
+			_mentionRowsFilter = _filter;
+			rowsUpdated(
+				std::move(mrows),
+				std::move(hrows),
+				std::move(brows),
+				std::move(srows),
+				resetScroll);
+			_recentInlineBotsInRows = recentInlineBots;
+			_inner->setRecentInlineBotsInRows(recentInlineBots);
+			return;
+		}
+		int maxListSize = _addInlineBots ? cRecentInlineBots().size() : 0;
+		if (_chat) {
+			maxListSize += (_chat->participants.empty() ? _chat->lastAuthors.size() : _chat->participants.size());
+		} else if (_channel && _channel->isMegagroup()) {
+			if (!_channel->lastParticipantsRequestNeeded()) {
+				maxListSize += _channel->mgInfo->lastParticipants.size();
+			}
+		}
+		if (maxListSize) {
+			mrows.reserve(maxListSize);
+		}
+
+		auto complete = true;
 		if (_addInlineBots) {
 			for (const auto user : cRecentInlineBots()) {
 				if (user->isInaccessible()
@@ -426,6 +468,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			};
 			mrows.reserve(mrows.size() + (_chat->participants.empty() ? _chat->lastAuthors.size() : _chat->participants.size()));
 			if (_chat->noParticipantInfo()) {
+				complete = false;
 				_chat->session().api().requestFullPeer(_chat);
 			} else if (!_chat->participants.empty()) {
 				for (const auto &user : _chat->participants) {
@@ -448,6 +491,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			}
 		} else if (_channel && _channel->isMegagroup()) {
 			if (_channel->lastParticipantsRequestNeeded()) {
+				complete = false;
 				_channel->session().api().chatParticipants().requestLast(
 					_channel);
 			} else {
@@ -460,6 +504,14 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 				}
 			}
 		}
+		_mentionRowsChat = _chat;
+		_mentionRowsUser = _user;
+		_mentionRowsChannel = _channel;
+		_mentionRowsFilter = _filter;
+		_mentionRowsRecentBots = _addInlineBots
+			? int(cRecentInlineBots().size())
+			: 0;
+		_mentionRowsComplete = complete;
 	} else if (_type == Type::Hashtags) {
 		bool listAllSuggestions = _filter.isEmpty();
 		auto &recent(cRecentWriteHashtags());
@@ -580,9 +632,20 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 		std::move(brows),
 		std::move(srows),
 		resetScroll);
+	_recentInlineBotsInRows = recentInlineBots;
 	_inner->setRecentInlineBotsInRows(recentInlineBots);
 }
 
+bool FieldAutocomplete::mentionRowsRefinable() const {
+	return (_mentionRowsChat == _chat)
+		&& (_mentionRowsUser == _user)
+		&& (_mentionRowsChannel == _channel)
+		&& _mentionRowsComplete
+		&& (_mentionRowsRecentBots
+			== (_addInlineBots ? int(cRecentInlineBots().size()) : 0))
+		&& _filter.startsWith(_mentionRowsFilter);
+}
+
 void FieldAutocomplete::rowsUpdated(
 		MentionRows &&mrows,
 		HashtagRows &&hrows,
@@ -1299,16 +1362,6 @@ void FieldAutocomplete::Inner::rowsUpdated() {
 	}
 }
 
-auto FieldAutocomplete::Inner::getLottieRenderer()
--> std::shared_ptr<Lottie::FrameRenderer> {
-	if (auto result = _lottieRenderer.lock()) {
-		return result;
-	}
-	auto result = Lottie::MakeFrameRenderer();
-	_lottieRenderer = result;
-	return result;
-}
-
 void FieldAutocomplete::Inner::setupLottie(StickerSuggestion &suggestion) {
 	const auto document = suggestion.document;
 	suggestion.lottie = ChatHelpers::LottiePlayerFromDocument(
@@ -1316,7 +1369,7 @@ void FieldAutocomplete::Inner::setupLottie(StickerSuggestion &suggestion) {
 		ChatHelpers::StickerLottieSize::InlineResults,
 		stickerBoundingBox() * cIntRetinaFactor(),
 		Lottie::Quality::Default,
-		getLottieRenderer());
+		ChatHelpers::PanelLottieRenderer());
 
 	suggestion.lottie->updates(
 	) | rpl::start_with_next([=] {
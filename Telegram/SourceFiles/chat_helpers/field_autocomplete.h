@@ -157,6 +157,7 @@ private:
 	void updateFiltered(bool resetScroll = false);
 	void recount(bool resetScroll = false);
 	StickerRows getStickerSuggestions();
+	[[nodiscard]] bool mentionRowsRefinable() const;
 
 	const not_null<Window::SessionController*> _controller;
 	QPixmap _cache;
@@ -185,6 +186,17 @@ private:
 	QRect _boundings;
 	bool _addInlineBots;
 
+	// State of the last full mention rows rebuild. While the query only
+	// grows the matches form a subset of _mrows, so keystrokes refilter
+	// those instead of walking the full participant lists again.
+	ChatData *_mentionRowsChat = nullptr;
+	UserData *_mentionRowsUser = nullptr;
+	ChannelData *_mentionRowsChannel = nullptr;
+	QString _mentionRowsFilter;
+	int _mentionRowsRecentBots = 0;
+	int _recentInlineBotsInRows = 0;
+	bool _mentionRowsComplete = false;
+
 	bool _hiding = false;
 
 	Ui::Animations::Simple _a_opacity;
@@ -264,8 +264,8 @@ bool DictionaryExists(int langId) {
 		return true;
 	}
 	const auto folder = DictPathByLangId(langId) + '/';
+	const auto name = Spellchecker::LocaleFromLangId(langId).name();
 	return ranges::none_of(kDictExtensions, [&](const auto &ext) {
-		const auto name = Spellchecker::LocaleFromLangId(langId).name();
 		return !QFile(folder + name + '.' + ext).exists();
 	});
 }
@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_document.h"
 #include "core/core_settings.h"
 #include "core/application.h"
+#include "core/idle_tasks.h"
 #include "base/call_delayed.h"
 #include "apiwrap.h"
 #include "styles/style_chat.h"
@@ -29,6 +30,7 @@ namespace Stickers {
 namespace {
 
 constexpr auto kRefreshTimeout = 7200 * crl::time(1000);
+constexpr auto kRefreshSliceSize = 128;
 
 [[nodiscard]] std::optional<int> IndexFromEmoticon(const QString &emoticon) {
 	if (emoticon.size() < 2) {
@@ -341,8 +343,32 @@ void EmojiPack::refreshItems(EmojiPtr emoji) {
 
 void EmojiPack::refreshItems(
 		const base::flat_set<not_null<HistoryItem*>> &list) {
+	// Rebuild the views in the visible viewport synchronously, so the
+	// change applies to what the user is looking at in a single frame,
+	// and spread the off-screen ones over idle slices - a full emoji
+	// set refresh may touch thousands of items across all histories.
+	auto deferred = std::vector<FullMsgId>();
 	for (const auto &item : list) {
-		_session->data().requestItemViewRefresh(item);
+		if (_session->data().queryItemVisibility(item)) {
+			_session->data().requestItemViewRefresh(item);
+		} else {
+			deferred.push_back(item->fullId());
+		}
+	}
+	const auto session = _session;
+	for (auto from = 0, till = int(deferred.size())
+		; from < till
+		; from += kRefreshSliceSize) {
+		auto slice = std::vector<FullMsgId>(
+			begin(deferred) + from,
+			begin(deferred) + std::min(from + kRefreshSliceSize, till));
+		Core::App().idleTasks().add(crl::guard(session, [=] {
+			for (const auto &fullId : slice) {
+				if (const auto item = session->data().message(fullId)) {
+					session->data().requestItemViewRefresh(item);
+				}
+			}
+		}));
 	}
 }
 
@@ -3333,12 +3333,7 @@ void StickersListWidget::showPreview() {
 
 auto StickersListWidget::getLottieRenderer()
 -> std::shared_ptr<Lottie::FrameRenderer> {
-	if (auto result = _lottieRenderer.lock()) {
-		return result;
-	}
-	auto result = Lottie::MakeFrameRenderer();
-	_lottieRenderer = result;
-	return result;
+	return PanelLottieRenderer();
 }
 
 void StickersListWidget::showStickerSet(uint64 setId) {
@@ -345,7 +345,6 @@ private:
 	base::flat_set<uint64> _installedLocallySets;
 	std::vector<bool> _custom;
 	base::flat_set<not_null<DocumentData*>> _favedStickersMap;
-	std::weak_ptr<Lottie::FrameRenderer> _lottieRenderer;
 
 	crl::time _lastScrolledAt = 0;
 	crl::time _lastFullUpdatedAt = 0;
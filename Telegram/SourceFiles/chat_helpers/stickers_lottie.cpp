@@ -23,10 +23,23 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace ChatHelpers {
 namespace {
 
-constexpr auto kDontCacheLottieAfterArea = 512 * 512;
+// Covers chat-size stickers up to 4x scale factors, so high-DPI setups
+// play frequently used packs from the disk cache instead of spending
+// CPU on re-rendering them from Bodymovin JSON every session.
+constexpr auto kDontCacheLottieAfterArea = 1024 * 1024;
 
 } // namespace
 
+std::shared_ptr<Lottie::FrameRenderer> PanelLottieRenderer() {
+	static auto Renderer = std::weak_ptr<Lottie::FrameRenderer>();
+	if (auto result = Renderer.lock()) {
+		return result;
+	}
+	auto result = Lottie::MakeFrameRenderer();
+	Renderer = result;
+	return result;
+}
+
 template <typename Method>
 auto LottieCachedFromContent(
 		Method &&method,
@@ -62,6 +62,11 @@ enum class StickerLottieSize : uchar {
 	EmojiInteractionReserved3,
 };
 
+// A renderer shared by all the sticker / emoji panels, so that several
+// open panels feed one raster thread instead of spawning one each and
+// oversubscribing the cores chat animations are rendered on.
+[[nodiscard]] std::shared_ptr<Lottie::FrameRenderer> PanelLottieRenderer();
+
 [[nodiscard]] std::unique_ptr<Lottie::SinglePlayer> LottiePlayerFromDocument(
 	not_null<Data::DocumentMedia*> media,
 	StickerLottieSize sizeTag,
@@ -0,0 +1,58 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/animation_budget.h"
+
+namespace Core {
+namespace {
+
+// A paint taking longer than this misses 60 fps by a wide margin even
+// leaving some headroom for the rest of the update cycle.
+constexpr auto kFrameTimeBudget = crl::time(24);
+
+// Demote only after this many over-budget paints in a row, a single
+// spike (history jump, section switch) shouldn't freeze animations.
+constexpr auto kDemoteAfterFrames = 6;
+
+// Lift the limit only after the paints stay in budget for this long.
+constexpr auto kRecoverDelay = crl::time(2000);
+
+} // namespace
+
+void AnimationBudget::reportFrameTime(crl::time elapsed) {
+	const auto now = crl::now();
+	if (elapsed > kFrameTimeBudget) {
+		_lastOverBudget = now;
+		if (!_limited && ++_overBudgetCount >= kDemoteAfterFrames) {
+			_limited = true;
+		}
+	} else if (_limited) {
+		if (_lastOverBudget + kRecoverDelay <= now) {
+			_limited = false;
+			_overBudgetCount = 0;
+		}
+	} else {
+		_overBudgetCount = 0;
+	}
+}
+
+bool AnimationBudget::demoted(QRect geometry, QRect viewport) const {
+	if (!_limited) {
+		return false;
+	} else if (viewport.isEmpty()) {
+		return true;
+	}
+	// Keep the middle half of the viewport animated, the eye is there.
+	const auto central = QRect(
+		viewport.x(),
+		viewport.y() + viewport.height() / 4,
+		viewport.width(),
+		viewport.height() / 2);
+	return !central.intersects(geometry);
+}
+
+} // namespace Core
@@ -0,0 +1,37 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core {
+
+// Watches how long the heavy paint surfaces spend on a single frame and,
+// when they keep missing the budget, demotes autoplaying media: the
+// animations near the viewport center keep playing while the ones by the
+// edges freeze on their current frame, recovering automatically once the
+// painting gets back in budget.
+class AnimationBudget final {
+public:
+	// Called from the paint surfaces with the time one paint took.
+	void reportFrameTime(crl::time elapsed);
+
+	[[nodiscard]] bool limited() const {
+		return _limited;
+	}
+
+	// True for animations that should freeze right now, 'geometry' and
+	// 'viewport' must be in the same coordinates (see PaintContext).
+	[[nodiscard]] bool demoted(QRect geometry, QRect viewport) const;
+
+private:
+	crl::time _lastOverBudget = 0;
+	int _overBudgetCount = 0;
+	bool _limited = false;
+
+};
+
+} // namespace Core
@@ -19,6 +19,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/qt_signal_producer.h"
 #include "base/unixtime.h"
 #include "core/update_checker.h"
+#include "core/animation_budget.h"
+#include "core/idle_tasks.h"
 #include "core/shortcuts.h"
 #include "core/sandbox.h"
 #include "core/local_url_handlers.h"
@@ -137,6 +139,8 @@ Application::Application(not_null<Launcher*> launcher)
 , _platformIntegration(Platform::Integration::Create())
 , _databases(std::make_unique<Storage::Databases>())
 , _animationsManager(std::make_unique<Ui::Animations::Manager>())
+, _idleTasks(std::make_unique<IdleTasks>())
+, _animationBudget(std::make_unique<AnimationBudget>())
 , _clearEmojiImageLoaderTimer([=] { clearEmojiSourceImages(); })
 , _audio(std::make_unique<Media::Audio::Instance>())
 , _fallbackProductionConfig(
@@ -101,6 +101,8 @@ class Instance;
 
 namespace Core {
 
+class AnimationBudget;
+class IdleTasks;
 class Launcher;
 struct LocalUrlHandler;
 
@@ -139,6 +141,12 @@ public:
 	[[nodiscard]] Ui::Animations::Manager &animationManager() const {
 		return *_animationsManager;
 	}
+	[[nodiscard]] IdleTasks &idleTasks() const {
+		return *_idleTasks;
+	}
+	[[nodiscard]] AnimationBudget &animationBudget() const {
+		return *_animationBudget;
+	}
 	[[nodiscard]] Window::Notifications::System &notifications() const {
 		Expects(_notifications != nullptr);
 
@@ -350,6 +358,8 @@ private:
 
 	const std::unique_ptr<Storage::Databases> _databases;
 	const std::unique_ptr<Ui::Animations::Manager> _animationsManager;
+	const std::unique_ptr<IdleTasks> _idleTasks;
+	const std::unique_ptr<AnimationBudget> _animationBudget;
 	crl::object_on_queue<Stickers::EmojiImageLoader> _emojiImageLoader;
 	base::Timer _clearEmojiImageLoaderTimer;
 	const std::unique_ptr<Media::Audio::Instance> _audio;
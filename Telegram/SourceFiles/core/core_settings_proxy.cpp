@@ -56,6 +56,13 @@ namespace {
 	return proxy;
 }
 
+[[nodiscard]] QString ProxyPingKey(const MTP::ProxyData &proxy) {
+	return QString("%1:%2:%3"
+	).arg(proxy.host
+	).arg(proxy.port
+	).arg(int(proxy.type));
+}
+
 [[nodiscard]] QByteArray SerializeProxyData(const MTP::ProxyData &proxy) {
 	auto result = QByteArray();
 	const auto size = 1 * sizeof(qint32)
@@ -103,6 +110,17 @@ QByteArray SettingsProxy::serialize() const {
 		_list
 	) | ranges::views::transform(SerializeProxyData) | ranges::to_vector;
 
+	// Only pings of still configured proxies are written out, so removed
+	// entries don't accumulate in the settings forever.
+	auto pings = std::vector<std::pair<QString, qint32>>();
+	pings.reserve(_list.size());
+	for (const auto &proxy : _list) {
+		const auto i = _lastPings.find(ProxyPingKey(proxy));
+		if (i != end(_lastPings)) {
+			pings.push_back(*i);
+		}
+	}
+
 	const auto size = 3 * sizeof(qint32)
 		+ Serialize::bytearraySize(serializedSelected)
 		+ 1 * sizeof(qint32)
@@ -110,7 +128,16 @@ QByteArray SettingsProxy::serialize() const {
 			serializedList,
 			0,
 			ranges::plus(),
-			&Serialize::bytearraySize);
+			&Serialize::bytearraySize)
+		+ 1 * sizeof(qint32)
+		+ ranges::accumulate(
+			pings,
+			0,
+			ranges::plus(),
+			[](const auto &pair) {
+				return Serialize::stringSize(pair.first)
+					+ int(sizeof(qint32));
+			});
 	result.reserve(size);
 
 	stream.setVersion(QDataStream::Qt_5_1);
@@ -123,6 +150,10 @@ QByteArray SettingsProxy::serialize() const {
 	for (const auto &i : serializedList) {
 		stream << i;
 	}
+	stream << qint32(pings.size());
+	for (const auto &[key, ping] : pings) {
+		stream << key << ping;
+	}
 
 	stream.device()->close();
 	return result;
@@ -155,6 +186,19 @@ bool SettingsProxy::setFromSerialized(const QByteArray &serialized) {
 				_list.push_back(DeserializeProxyData(data));
 			}
 		}
+		if (stream.status() == QDataStream::Ok && !stream.atEnd()) {
+			auto pingCount = qint32(0);
+			stream >> pingCount;
+			for (auto i = 0; i != pingCount; ++i) {
+				auto key = QString();
+				auto ping = qint32(0);
+				stream >> key >> ping;
+				if (stream.status() != QDataStream::Ok) {
+					break;
+				}
+				_lastPings.emplace(key, ping);
+			}
+		}
 	}
 
 	if (stream.status() != QDataStream::Ok) {
@@ -215,6 +259,15 @@ void SettingsProxy::setSelected(MTP::ProxyData value) {
 	_selected = value;
 }
 
+int SettingsProxy::lastPing(const MTP::ProxyData &proxy) const {
+	const auto i = _lastPings.find(ProxyPingKey(proxy));
+	return (i != end(_lastPings)) ? i->second : 0;
+}
+
+void SettingsProxy::setLastPing(const MTP::ProxyData &proxy, int ping) {
+	_lastPings[ProxyPingKey(proxy)] = ping;
+}
+
 const std::vector<MTP::ProxyData> &SettingsProxy::list() const {
 	return _list;
 }
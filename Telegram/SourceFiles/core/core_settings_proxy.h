@@ -38,6 +38,10 @@ public:
 	[[nodiscard]] const std::vector<MTP::ProxyData> &list() const;
 	[[nodiscard]] std::vector<MTP::ProxyData> &list();
 
+	// Last successful health check result in milliseconds, 0 if unknown.
+	[[nodiscard]] int lastPing(const MTP::ProxyData &proxy) const;
+	void setLastPing(const MTP::ProxyData &proxy, int ping);
+
 	[[nodiscard]] QByteArray serialize() const;
 	bool setFromSerialized(const QByteArray &serialized);
 
@@ -47,6 +51,7 @@ private:
 	MTP::ProxyData::Settings _settings = MTP::ProxyData::Settings::System;
 	MTP::ProxyData _selected;
 	std::vector<MTP::ProxyData> _list;
+	base::flat_map<QString, qint32> _lastPings;
 
 	rpl::event_stream<> _connectionTypeChanges;
 
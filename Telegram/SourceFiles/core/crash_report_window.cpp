@@ -17,6 +17,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "platform/platform_specific.h"
 #include "base/zlib_help.h"
 
+#include <crl/crl_async.h>
+#include <crl/crl_on_main.h>
 #include <QtWidgets/QFileDialog>
 #include <QtGui/QScreen>
 #include <QtGui/QDesktopServices>
@@ -27,6 +29,30 @@ namespace {
 
 constexpr auto kDefaultProxyPort = 80;
 
+[[nodiscard]] QByteArray CompressMinidump(
+		const QString &path,
+		const QString &dmpName) {
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return QByteArray();
+	}
+	const QByteArray minidump = file.readAll();
+	file.close();
+
+	zlib::FileToWrite minidumpZip;
+
+	zip_fileinfo zfi = { { 0, 0, 0, 0, 0, 0 }, 0, 0, 0 };
+	QByteArray dmpNameUtf = dmpName.toUtf8();
+	minidumpZip.openNewFile(dmpNameUtf.constData(), &zfi, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION);
+	minidumpZip.writeInFile(minidump.constData(), minidump.size());
+	minidumpZip.closeFile();
+	minidumpZip.close();
+
+	return (minidumpZip.error() == ZIP_OK)
+		? minidumpZip.result()
+		: QByteArray();
+}
+
 } // namespace
 
 PreLaunchWindow *PreLaunchWindowInstance = nullptr;
@@ -581,32 +607,40 @@ void LastCrashedWindow::checkingFinished() {
 
 	QString dmpName = minidumpFileName();
 	if (!dmpName.isEmpty()) {
-		QFile file(_minidumpFull);
-		if (file.open(QIODevice::ReadOnly)) {
-			QByteArray minidump = file.readAll();
-			file.close();
-
-			QString zipName = QString(dmpName).replace(qstr(".dmp"), qstr(".zip"));
-
-			zlib::FileToWrite minidumpZip;
-
-			zip_fileinfo zfi = { { 0, 0, 0, 0, 0, 0 }, 0, 0, 0 };
-			QByteArray dmpNameUtf = dmpName.toUtf8();
-			minidumpZip.openNewFile(dmpNameUtf.constData(), &zfi, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION);
-			minidumpZip.writeInFile(minidump.constData(), minidump.size());
-			minidumpZip.closeFile();
-			minidumpZip.close();
-
-			if (minidumpZip.error() == ZIP_OK) {
-				QHttpPart dumpPart;
-				dumpPart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/octet-stream"));
-				dumpPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant(qsl("form-data; name=\"dump\"; filename=\"%1\"").arg(zipName)));
-				dumpPart.setBody(minidumpZip.result());
-				multipart->append(dumpPart);
-
-				_minidump.setText(qsl("+ %1 (%2 KB)").arg(zipName).arg(minidumpZip.result().size() / 1024));
-			}
-		}
+		// Deflating a multi-megabyte dump froze the window for seconds,
+		// so the zip is produced on a worker thread and the upload
+		// starts when the compressed dump lands back on the main one.
+		const auto path = _minidumpFull;
+		const auto weak = QPointer<LastCrashedWindow>(this);
+		crl::async([=] {
+			auto zipped = CompressMinidump(path, dmpName);
+			crl::on_main([=] {
+				if (const auto strong = weak.data()) {
+					strong->sendFullReport(multipart, dmpName, zipped);
+				} else {
+					delete multipart;
+				}
+			});
+		});
+		return;
+	}
+	sendFullReport(multipart, QString(), QByteArray());
+}
+
+void LastCrashedWindow::sendFullReport(
+		QHttpMultiPart *multipart,
+		const QString &dmpName,
+		const QByteArray &zipped) {
+	if (!zipped.isEmpty()) {
+		QString zipName = QString(dmpName).replace(qstr(".dmp"), qstr(".zip"));
+
+		QHttpPart dumpPart;
+		dumpPart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/octet-stream"));
+		dumpPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant(qsl("form-data; name=\"dump\"; filename=\"%1\"").arg(zipName)));
+		dumpPart.setBody(zipped);
+		multipart->append(dumpPart);
+
+		_minidump.setText(qsl("+ %1 (%2 KB)").arg(zipName).arg(zipped.size() / 1024));
 	}
 
 	_sendReply = _sendManager.post(QNetworkRequest(qsl("https://tdesktop.com/crash.php?act=report")), multipart);
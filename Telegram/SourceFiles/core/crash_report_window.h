@@ -112,6 +112,10 @@ public:
 	void processContinue();
 
 	void checkingFinished();
+	void sendFullReport(
+		QHttpMultiPart *multipart,
+		const QString &dmpName,
+		const QByteArray &zipped);
 	void sendingError(QNetworkReply::NetworkError e);
 	void sendingFinished();
 	void sendingProgress(qint64 uploaded, qint64 total);
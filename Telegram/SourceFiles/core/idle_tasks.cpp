@@ -0,0 +1,61 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/idle_tasks.h"
+
+#include "core/application.h"
+
+namespace Core {
+namespace {
+
+// Tasks wait for this long without user input before running.
+constexpr auto kIdleTrigger = crl::time(1000);
+
+// A single run spends at most this long before rescheduling the rest.
+constexpr auto kSliceBudget = crl::time(8);
+
+// Leftover tasks try again after this delay, so repaints fit between.
+constexpr auto kSliceInterval = crl::time(100);
+
+} // namespace
+
+IdleTasks::IdleTasks()
+: _timer([=] { check(); }) {
+}
+
+void IdleTasks::add(FnMut<void()> task) {
+	_tasks.push_back(std::move(task));
+	if (!_timer.isActive()) {
+		_timer.callOnce(kIdleTrigger);
+	}
+}
+
+void IdleTasks::check() {
+	const auto idle = crl::now() - App().lastNonIdleTime();
+	if (idle >= kIdleTrigger) {
+		runSlice();
+	} else {
+		_timer.callOnce(kIdleTrigger - idle);
+	}
+}
+
+void IdleTasks::runSlice() {
+	const auto till = crl::now() + kSliceBudget;
+	while (!_tasks.empty()) {
+		auto task = std::move(_tasks.front());
+		_tasks.pop_front();
+		task();
+		if (crl::now() >= till) {
+			break;
+		}
+	}
+	if (!_tasks.empty()) {
+		_timer.callOnce(kSliceInterval);
+	}
+}
+
+} // namespace Core
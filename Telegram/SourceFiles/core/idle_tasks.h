@@ -0,0 +1,32 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/timer.h"
+
+namespace Core {
+
+// Runs deferrable maintenance tasks when the user has been idle for a
+// short while, slicing each run by a time budget so a burst of queued
+// work never delays the next frame once the user comes back.
+class IdleTasks final {
+public:
+	IdleTasks();
+
+	void add(FnMut<void()> task);
+
+private:
+	void check();
+	void runSlice();
+
+	std::deque<FnMut<void()>> _tasks;
+	base::Timer _timer;
+
+};
+
+} // namespace Core
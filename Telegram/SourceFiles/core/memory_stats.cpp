@@ -0,0 +1,155 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/memory_stats.h"
+
+#include <QtCore/QFile>
+
+#ifdef Q_OS_UNIX
+#include <dlfcn.h>
+#endif // Q_OS_UNIX
+
+#ifdef Q_OS_LINUX
+#include <malloc.h>
+#include <stdio.h>
+#endif // Q_OS_LINUX
+
+namespace Core::MemoryStats {
+namespace {
+
+// jemalloc entry points, resolved at runtime - the release Linux
+// builds link jemalloc, while dev builds run on the system allocator.
+using MallctlSignature = int (*)(
+	const char *name,
+	void *oldp,
+	size_t *oldlenp,
+	void *newp,
+	size_t newlen);
+using StatsPrintSignature = void (*)(
+	void (*callback)(void *opaque, const char *chunk),
+	void *opaque,
+	const char *opts);
+
+[[nodiscard]] MallctlSignature Mallctl() {
+#ifdef Q_OS_UNIX
+	static const auto result = reinterpret_cast<MallctlSignature>(
+		dlsym(RTLD_DEFAULT, "mallctl"));
+	return result;
+#else // Q_OS_UNIX
+	return nullptr;
+#endif // !Q_OS_UNIX
+}
+
+[[nodiscard]] StatsPrintSignature MallocStatsPrint() {
+#ifdef Q_OS_UNIX
+	static const auto result = reinterpret_cast<StatsPrintSignature>(
+		dlsym(RTLD_DEFAULT, "malloc_stats_print"));
+	return result;
+#else // Q_OS_UNIX
+	return nullptr;
+#endif // !Q_OS_UNIX
+}
+
+// Refreshes the snapshot the stats.* counters are served from.
+void RefreshEpoch(MallctlSignature mallctl) {
+	auto epoch = uint64_t(1);
+	auto size = sizeof(epoch);
+	mallctl("epoch", &epoch, &size, &epoch, sizeof(epoch));
+}
+
+[[nodiscard]] std::optional<size_t> ReadCounter(
+		MallctlSignature mallctl,
+		const char *name) {
+	auto value = size_t(0);
+	auto size = sizeof(value);
+	if (mallctl(name, &value, &size, nullptr, 0) != 0) {
+		return std::nullopt;
+	}
+	return value;
+}
+
+} // namespace
+
+QByteArray Dump() {
+	if (const auto print = MallocStatsPrint()) {
+		if (const auto mallctl = Mallctl()) {
+			RefreshEpoch(mallctl);
+		}
+		auto result = QByteArray();
+		const auto append = [](void *opaque, const char *chunk) {
+			static_cast<QByteArray*>(opaque)->append(chunk);
+		};
+		// 'J' selects the machine-readable JSON format with the full
+		// arena / size-class breakdown included.
+		print(append, &result, "J");
+		return result;
+	}
+#ifdef Q_OS_LINUX
+	char *buffer = nullptr;
+	auto size = size_t(0);
+	if (const auto stream = open_memstream(&buffer, &size)) {
+		malloc_info(0, stream);
+		fclose(stream);
+		auto result = QByteArray(buffer, int(size));
+		free(buffer);
+		return result;
+	}
+#endif // Q_OS_LINUX
+	return QByteArray();
+}
+
+QString Brief() {
+	const auto mallctl = Mallctl();
+	if (!mallctl) {
+		return qsl("System allocator, no jemalloc in this build.");
+	}
+	RefreshEpoch(mallctl);
+	const auto allocated = ReadCounter(mallctl, "stats.allocated");
+	const auto active = ReadCounter(mallctl, "stats.active");
+	const auto resident = ReadCounter(mallctl, "stats.resident");
+	if (!allocated || !active || !resident) {
+		return qsl("jemalloc is linked, but stats are not available.");
+	}
+	const auto mb = [](size_t value) {
+		return QString::number(value / (1024 * 1024));
+	};
+	return qsl("jemalloc: %1 MB allocated, %2 MB active, %3 MB resident."
+	).arg(mb(*allocated)).arg(mb(*active)).arg(mb(*resident));
+}
+
+std::optional<bool> ToggleHeapProfile() {
+	const auto mallctl = Mallctl();
+	if (!mallctl) {
+		return std::nullopt;
+	}
+	auto active = false;
+	auto size = sizeof(active);
+	if (mallctl("prof.active", &active, &size, nullptr, 0) != 0) {
+		return std::nullopt;
+	}
+	auto enable = !active;
+	if (mallctl("prof.active", nullptr, nullptr, &enable, sizeof(enable)) != 0) {
+		return std::nullopt;
+	}
+	return enable;
+}
+
+QString CaptureHeapProfile() {
+	const auto mallctl = Mallctl();
+	if (!mallctl) {
+		return QString();
+	}
+	const auto path = cWorkingDir() + qsl("heap_profile.dump");
+	const auto utf8 = QFile::encodeName(path);
+	auto name = utf8.constData();
+	if (mallctl("prof.dump", nullptr, nullptr, &name, sizeof(name)) != 0) {
+		return QString();
+	}
+	return path;
+}
+
+} // namespace Core::MemoryStats
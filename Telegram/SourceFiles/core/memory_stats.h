@@ -0,0 +1,29 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core::MemoryStats {
+
+// Machine-readable allocator statistics: the full jemalloc stats dump
+// (arenas, fragmentation, per-size-class usage) when the binary runs
+// with jemalloc, the glibc malloc_info XML otherwise. The allocator is
+// detected at runtime, release Linux builds link jemalloc while dev
+// builds usually don't.
+[[nodiscard]] QByteArray Dump();
+
+// One-line summary for a toast: resident / active / allocated.
+[[nodiscard]] QString Brief();
+
+// Toggles jemalloc heap profiling, returns the new state or nullopt
+// when profiling is not available (no jemalloc or built without prof).
+std::optional<bool> ToggleHeapProfile();
+
+// Writes a heap profile next to the working dir, empty path on error.
+[[nodiscard]] QString CaptureHeapProfile();
+
+} // namespace Core::MemoryStats
@@ -7,9 +7,41 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "core/mime_type.h"
 
+#include "base/flat_map.h"
+
 #include <QtCore/QMimeDatabase>
+#include <QtCore/QMutex>
 
 namespace Core {
+namespace {
+
+constexpr auto kMimeTypesCacheLimit = 64;
+
+// QMimeDatabase queries may probe the on-disk mime database, and name
+// lookups repeat for every document in a files list, so memoize them.
+// Guarded by a mutex - file send preparation asks from worker threads.
+[[nodiscard]] QMimeType MimeTypeForNameCached(const QString &mime) {
+	static auto Mutex = QMutex();
+	static auto Cache = base::flat_map<QString, QMimeType>();
+
+	QMutexLocker lock(&Mutex);
+	const auto i = Cache.find(mime);
+	if (i != Cache.end()) {
+		return i->second;
+	}
+	lock.unlock();
+
+	const auto result = QMimeDatabase().mimeTypeForName(mime);
+
+	lock.relock();
+	if (Cache.size() >= kMimeTypesCacheLimit) {
+		Cache.clear();
+	}
+	Cache.emplace(mime, result);
+	return result;
+}
+
+} // namespace
 
 MimeType::MimeType(const QMimeType &type) : _typeStruct(type) {
 }
@@ -66,9 +98,9 @@ MimeType MimeTypeForName(const QString &mime) {
 	} else if (mime == qstr("application/x-tdesktop-palette")) {
 		return MimeType(MimeType::Known::TDesktopPalette);
 	} else if (mime == qstr("audio/mpeg3")) {
-		return MimeType(QMimeDatabase().mimeTypeForName("audio/mp3"));
+		return MimeType(MimeTypeForNameCached("audio/mp3"));
 	}
-	return MimeType(QMimeDatabase().mimeTypeForName(mime));
+	return MimeType(MimeTypeForNameCached(mime));
 }
 
 MimeType MimeTypeForFile(const QFileInfo &file) {
@@ -0,0 +1,262 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/perf_trace.h"
+
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace Core::Trace {
+namespace {
+
+constexpr auto kRingSize = 8192;
+
+struct Event {
+	const char *name = nullptr;
+	int64 startUs = 0;
+	int64 durationUs = 0;
+	quint64 thread = 0;
+};
+
+constexpr auto kCounterSlots = 64;
+
+struct Counter {
+	const char *name = nullptr;
+	int64 count = 0;
+	int64 firstUs = 0;
+	int64 lastUs = 0;
+};
+
+constexpr auto kJankSlots = 64;
+
+struct Jank {
+	const char *className = nullptr;
+	int eventType = 0;
+	int64 count = 0;
+	int64 totalUs = 0;
+	int64 maxUs = 0;
+	const char *worstScope = nullptr;
+	int64 worstScopeUs = 0;
+};
+
+std::atomic<bool> TracingEnabled/* = false*/;
+
+QMutex RingMutex;
+std::array<Event, kRingSize> Ring; // Guarded by RingMutex.
+int RingNext/* = 0*/; // Guarded by RingMutex.
+int RingCount/* = 0*/; // Guarded by RingMutex.
+std::array<Counter, kCounterSlots> Counters; // Guarded by RingMutex.
+std::array<Jank, kJankSlots> Janks; // Guarded by RingMutex.
+
+} // namespace
+
+void Toggle(bool enabled) {
+	TracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Enabled() {
+	return TracingEnabled.load(std::memory_order_relaxed);
+}
+
+int64 NowUs() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Record(const char *name, int64 startUs, int64 durationUs) {
+	const auto thread = quint64(
+		reinterpret_cast<quintptr>(QThread::currentThreadId()));
+
+	QMutexLocker lock(&RingMutex);
+	Ring[RingNext] = { name, startUs, durationUs, thread };
+	RingNext = (RingNext + 1) % kRingSize;
+	if (RingCount < kRingSize) {
+		++RingCount;
+	}
+}
+
+void Count(const char *name) {
+	if (!Enabled()) {
+		return;
+	}
+	const auto nowUs = NowUs();
+
+	QMutexLocker lock(&RingMutex);
+	for (auto &counter : Counters) {
+		if (!counter.name) {
+			counter = { name, 1, nowUs, nowUs };
+			return;
+		} else if (counter.name == name
+			|| !strcmp(counter.name, name)) {
+			++counter.count;
+			counter.lastUs = nowUs;
+			return;
+		}
+	}
+}
+
+void RecordLongDispatch(
+		const char *className,
+		int eventType,
+		int64 startUs,
+		int64 durationUs) {
+	QMutexLocker lock(&RingMutex);
+
+	// Janks are rare, so a ring scan for the longest scope that ran
+	// inside the dispatch window is fine. Empty while not tracing.
+	auto worstScope = (const char*)nullptr;
+	auto worstScopeUs = int64(0);
+	const auto oldest = (RingCount < kRingSize) ? 0 : RingNext;
+	for (auto i = 0; i != RingCount; ++i) {
+		const auto &event = Ring[(oldest + i) % kRingSize];
+		if (event.startUs >= startUs
+			&& event.startUs <= startUs + durationUs
+			&& event.durationUs > worstScopeUs) {
+			worstScope = event.name;
+			worstScopeUs = event.durationUs;
+		}
+	}
+
+	for (auto &jank : Janks) {
+		if (!jank.className) {
+			jank = {
+				className,
+				eventType,
+				1,
+				durationUs,
+				durationUs,
+				worstScope,
+				worstScopeUs,
+			};
+			return;
+		} else if (jank.eventType == eventType
+			&& (jank.className == className
+				|| !strcmp(jank.className, className))) {
+			++jank.count;
+			jank.totalUs += durationUs;
+			if (jank.maxUs < durationUs) {
+				jank.maxUs = durationUs;
+			}
+			if (jank.worstScopeUs < worstScopeUs) {
+				jank.worstScope = worstScope;
+				jank.worstScopeUs = worstScopeUs;
+			}
+			return;
+		}
+	}
+}
+
+QByteArray JankReport() {
+	QMutexLocker lock(&RingMutex);
+
+	auto sorted = std::vector<const Jank*>();
+	sorted.reserve(kJankSlots);
+	for (const auto &jank : Janks) {
+		if (!jank.className) {
+			break;
+		}
+		sorted.push_back(&jank);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](
+			const Jank *a,
+			const Jank *b) {
+		return a->totalUs > b->totalUs;
+	});
+
+	auto result = QByteArray();
+	for (const auto jank : sorted) {
+		result.append(jank->className);
+		result.append(" event(");
+		result.append(QByteArray::number(jank->eventType));
+		result.append("): ");
+		result.append(QByteArray::number(qlonglong(jank->count)));
+		result.append(" x, total ");
+		result.append(QByteArray::number(jank->totalUs / 1000., 'f', 1));
+		result.append(" ms, max ");
+		result.append(QByteArray::number(jank->maxUs / 1000., 'f', 1));
+		result.append(" ms");
+		if (jank->worstScope) {
+			result.append(", worst scope: ");
+			result.append(jank->worstScope);
+			result.append(" (");
+			result.append(
+				QByteArray::number(jank->worstScopeUs / 1000., 'f', 1));
+			result.append(" ms)");
+		}
+		result.append('\n');
+	}
+	return result;
+}
+
+void ClearJankReport() {
+	QMutexLocker lock(&RingMutex);
+	Janks.fill({});
+}
+
+QByteArray ExportJson() {
+	auto result = QByteArray();
+	result.reserve(RingCount * 96 + 32);
+	result.append("{\"traceEvents\":[");
+
+	QMutexLocker lock(&RingMutex);
+	const auto oldest = (RingCount < kRingSize)
+		? 0
+		: RingNext;
+	for (auto i = 0; i != RingCount; ++i) {
+		const auto &event = Ring[(oldest + i) % kRingSize];
+		if (i > 0) {
+			result.append(',');
+		}
+		result.append("{\"name\":\"");
+		result.append(event.name);
+		result.append("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+		result.append(QByteArray::number(qulonglong(event.thread)));
+		result.append(",\"ts\":");
+		result.append(QByteArray::number(qlonglong(event.startUs)));
+		result.append(",\"dur\":");
+		result.append(QByteArray::number(qlonglong(event.durationUs)));
+		result.append('}');
+	}
+	result.append("],\"eventCounters\":[");
+	auto first = true;
+	for (const auto &counter : Counters) {
+		if (!counter.name) {
+			break;
+		}
+		if (!first) {
+			result.append(',');
+		}
+		first = false;
+		const auto elapsedUs = counter.lastUs - counter.firstUs;
+		const auto perSecond = (elapsedUs > 0)
+			? ((counter.count - 1) * 1'000'000. / elapsedUs)
+			: 0.;
+		result.append("{\"name\":\"");
+		result.append(counter.name);
+		result.append("\",\"count\":");
+		result.append(QByteArray::number(qlonglong(counter.count)));
+		result.append(",\"perSecond\":");
+		result.append(QByteArray::number(perSecond, 'f', 1));
+		result.append('}');
+	}
+	result.append("]}");
+	return result;
+}
+
+void Clear() {
+	QMutexLocker lock(&RingMutex);
+	RingNext = RingCount = 0;
+	Counters.fill({});
+}
+
+} // namespace Core::Trace
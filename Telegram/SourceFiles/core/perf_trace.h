@@ -0,0 +1,70 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core::Trace {
+
+// Lightweight scoped tracing for frame drops investigation: events go
+// to a fixed ring buffer and export in the chrome://tracing JSON
+// format. Costs one relaxed atomic load per scope while disabled.
+
+void Toggle(bool enabled);
+[[nodiscard]] bool Enabled();
+
+void Record(const char *name, int64 startUs, int64 durationUs);
+[[nodiscard]] QByteArray ExportJson();
+void Clear();
+
+// Event-rate counters for streams that fire too often to trace one by
+// one, like the per-item repaint requests: Count() bumps a named
+// counter and the totals with the observed rates go into the export
+// next to the trace events.
+void Count(const char *name);
+
+// Always-on main-thread watchdog aggregation: Core::Sandbox reports
+// every top-level event dispatch that overran the jank threshold.
+// Offenders group by (receiver class, event type); while tracing is
+// enabled the longest scope recorded inside the dispatch window is
+// kept as well, to point past QWidget straight at the slow code.
+void RecordLongDispatch(
+	const char *className,
+	int eventType,
+	int64 startUs,
+	int64 durationUs);
+[[nodiscard]] QByteArray JankReport();
+void ClearJankReport();
+
+[[nodiscard]] int64 NowUs();
+
+class Scope final {
+public:
+	explicit Scope(const char *name)
+	: _name(Enabled() ? name : nullptr)
+	, _startUs(_name ? NowUs() : 0) {
+	}
+	Scope(const Scope &other) = delete;
+	Scope &operator=(const Scope &other) = delete;
+	~Scope() {
+		if (_name) {
+			Record(_name, _startUs, NowUs() - _startUs);
+		}
+	}
+
+private:
+	const char *_name = nullptr;
+	int64 _startUs = 0;
+
+};
+
+} // namespace Core::Trace
+
+#define TDESKTOP_TRACE_CONCAT_HELPER(a, b) a##b
+#define TDESKTOP_TRACE_CONCAT(a, b) TDESKTOP_TRACE_CONCAT_HELPER(a, b)
+#define TRACE_SCOPE(name) \
+	const auto TDESKTOP_TRACE_CONCAT(traceScope, __LINE__) \
+		= ::Core::Trace::Scope(name)
@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/launcher.h"
 #include "core/local_url_handlers.h"
+#include "core/perf_trace.h"
 #include "core/update_checker.h"
 #include "base/timer.h"
 #include "base/concurrent_timer.h"
@@ -38,6 +39,10 @@ namespace {
 
 constexpr auto kEmptyPidForCommandResponse = 0ULL;
 
+// A main-thread event dispatch longer than this is aggregated into the
+// jank report, see the 'jankreport' debug code.
+constexpr auto kJankThresholdUs = int64(50 * 1000);
+
 QChar _toHex(ushort v) {
 	v = v & 0x000F;
 	return QChar::fromLatin1((v >= 10) ? ('a' + (v - 10)) : ('0' + v));
@@ -592,15 +597,39 @@ bool Sandbox::notify(QObject *receiver, QEvent *e) {
 		return notifyOrInvoke(receiver, e);
 	}
 
-	const auto wrap = createEventNestingLevel();
-	if (e->type() == QEvent::UpdateRequest) {
-		const auto weak = QPointer<QObject>(receiver);
-		_widgetUpdateRequests.fire({});
-		if (!weak) {
-			return true;
+	// Watchdog: time outermost dispatches only, so one slow handler is
+	// reported once and not through every nested notify() around it.
+	// The class name pointer stays valid if the receiver dies inside.
+	const auto outermost = (_eventNestingLevel == 0);
+	const auto eventType = int(e->type());
+	const auto className = outermost
+		? receiver->metaObject()->className()
+		: nullptr;
+	const auto startUs = outermost ? Trace::NowUs() : 0;
+
+	auto result = true;
+	{
+		const auto wrap = createEventNestingLevel();
+		if (e->type() == QEvent::UpdateRequest) {
+			const auto weak = QPointer<QObject>(receiver);
+			_widgetUpdateRequests.fire({});
+			if (!weak) {
+				return true;
+			}
+		}
+		result = notifyOrInvoke(receiver, e);
+	}
+	if (outermost) {
+		const auto durationUs = Trace::NowUs() - startUs;
+		if (durationUs >= kJankThresholdUs) {
+			Trace::RecordLongDispatch(
+				className,
+				eventType,
+				startUs,
+				durationUs);
 		}
 	}
-	return notifyOrInvoke(receiver, e);
+	return result;
 }
 
 void Sandbox::processPostponedCalls(int level) {
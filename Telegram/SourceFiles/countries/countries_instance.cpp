@@ -264,6 +264,8 @@ void CountriesInstance::setList(std::vector<Info> &&infos) {
 	_list = std::move(infos);
 	_byCode.clear();
 	_byISO2.clear();
+	_byCallingCode.clear();
+	_maxCallingCodeLength = 0;
 	_updated.fire({});
 }
 
@@ -289,6 +291,26 @@ const CountriesInstance::Map &CountriesInstance::byISO2() {
 	return _byISO2;
 }
 
+const CountriesInstance::ByCallingCodeMap &CountriesInstance::byCallingCode() {
+	if (_byCallingCode.empty()) {
+		auto index = 0;
+		for (const auto &entry : list()) {
+			for (const auto &code : entry.codes) {
+				_byCallingCode[code.callingCode].push_back({
+					&entry,
+					&code,
+					index,
+				});
+				accumulate_max(
+					_maxCallingCodeLength,
+					int(code.callingCode.size()));
+			}
+			++index;
+		}
+	}
+	return _byCallingCode;
+}
+
 QString CountriesInstance::validPhoneCode(QString fullCode) {
 	const auto &listByCode = byCode();
 	while (fullCode.length()) {
@@ -321,29 +343,43 @@ FormatResult CountriesInstance::format(FormatArgs args) {
 	}
 	const auto &phoneNumber = args.phone;
 
+	// Only the calling codes that are prefixes of the phone number can
+	// match, so instead of scanning the whole list the candidates come
+	// from a few by-calling-code map lookups. Ties on the total matched
+	// length are resolved towards the earliest list entry, like the old
+	// full scan did.
 	const Info *bestCountryPtr = nullptr;
 	const CallingCodeInfo *bestCallingCodePtr = nullptr;
 	auto bestLength = size_t(0);
-	[[maybe_unused]] auto isPrefix = false;
-	for (const auto &country : list()) {
-		for (auto &callingCode : country.codes) {
-			if (phoneNumber.startsWith(callingCode.callingCode)) {
-				const auto codeSize = callingCode.callingCode.size();
-				for (const auto &prefix : callingCode.prefixes) {
-					if (prefix.startsWith(base::StringViewMid(phoneNumber, codeSize))) {
-						isPrefix = true;
-					}
-					if ((codeSize + prefix.size()) > bestLength &&
-							base::StringViewMid(phoneNumber, codeSize).startsWith(prefix)) {
-						bestCountryPtr = &country;
-						bestCallingCodePtr = &callingCode;
-						bestLength = codeSize + prefix.size();
-					}
+	auto bestListIndex = 0;
+	const auto &listByCallingCode = byCallingCode();
+	const auto longest = std::min(
+		int(phoneNumber.size()),
+		_maxCallingCodeLength);
+	for (auto length = longest; length != 0; --length) {
+		const auto i = listByCallingCode.constFind(
+			phoneNumber.mid(0, length));
+		if (i == listByCallingCode.cend()) {
+			continue;
+		}
+		for (const auto &entry : *i) {
+			const auto codeSize = entry.code->callingCode.size();
+			for (const auto &prefix : entry.code->prefixes) {
+				const auto total = size_t(codeSize + prefix.size());
+				const auto better = (total > bestLength)
+					|| ((total == bestLength)
+						&& bestCountryPtr
+						&& (entry.listIndex < bestListIndex));
+				if (better
+					&& base::StringViewMid(
+						phoneNumber,
+						codeSize).startsWith(prefix)) {
+					bestCountryPtr = entry.country;
+					bestCallingCodePtr = entry.code;
+					bestLength = total;
+					bestListIndex = entry.listIndex;
 				}
 			}
-			if (callingCode.callingCode.startsWith(phoneNumber)) {
-				isPrefix = true;
-			}
 		}
 	}
 	if (bestCountryPtr == nullptr) {
@@ -41,6 +41,12 @@ struct FormatArgs {
 class CountriesInstance final {
 public:
 	using Map = QHash<QString, const Info *>;
+	struct CallingCodeEntry {
+		const Info *country = nullptr;
+		const CallingCodeInfo *code = nullptr;
+		int listIndex = 0;
+	};
+	using ByCallingCodeMap = QHash<QString, std::vector<CallingCodeEntry>>;
 
 	CountriesInstance();
 	[[nodiscard]] const std::vector<Info> &list();
@@ -48,6 +54,7 @@ public:
 
 	[[nodiscard]] const Map &byCode();
 	[[nodiscard]] const Map &byISO2();
+	[[nodiscard]] const ByCallingCodeMap &byCallingCode();
 
 	[[nodiscard]] QString validPhoneCode(QString fullCode);
 	[[nodiscard]] QString countryNameByISO2(const QString &iso);
@@ -62,6 +69,8 @@ private:
 
 	Map _byCode;
 	Map _byISO2;
+	ByCallingCodeMap _byCallingCode;
+	int _maxCallingCodeLength = 0;
 
 	rpl::event_stream<> _updated;
 
@@ -176,6 +176,16 @@ const Set &Full::setOrDefault(Source source, Type type) const {
 
 void Full::setBytesLimit(Source source, Type type, int bytesLimit) {
 	set(source).setBytesLimit(type, bytesLimit);
+	bumpVersion();
+}
+
+int Full::version() const {
+	return _version;
+}
+
+void Full::bumpVersion() {
+	static auto GlobalVersion = 0;
+	_version = ++GlobalVersion;
 }
 
 bool Full::shouldDownload(Source source, Type type, int fileSize) const {
@@ -242,6 +252,7 @@ bool Full::setFromSerialized(const QByteArray &serialized) {
 		}
 	}
 	_data = temp._data;
+	bumpVersion();
 	return true;
 }
 
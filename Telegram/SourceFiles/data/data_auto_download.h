@@ -93,6 +93,10 @@ public:
 	[[nodiscard]] QByteArray serialize() const;
 	bool setFromSerialized(const QByteArray &serialized);
 
+	// Bumped to a globally unique value on each change, so decisions
+	// computed from the settings can be memoized against it.
+	[[nodiscard]] int version() const;
+
 	[[nodiscard]] static Full FullDisabled();
 
 private:
@@ -100,7 +104,10 @@ private:
 	[[nodiscard]] Set &set(Source source);
 	[[nodiscard]] const Set &setOrDefault(Source source, Type type) const;
 
+	void bumpVersion();
+
 	std::array<Set, kSourcesCount> _data;
+	int _version = 0;
 
 };
 
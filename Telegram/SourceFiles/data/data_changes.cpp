@@ -10,6 +10,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 
 namespace Data {
+namespace {
+
+// Update storms in busy channels used to schedule a delivery for every
+// event loop turn, repainting dialog rows hundreds of times per second.
+// Keep merging flags for up to a frame before sending them out.
+constexpr auto kNotifyCoalesceDelay = crl::time(11);
+
+} // namespace
 
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::updated(
@@ -83,7 +91,9 @@ void Changes::Manager<DataType, UpdateType>::sendNotifications() {
 	}
 }
 
-Changes::Changes(not_null<Main::Session*> session) : _session(session) {
+Changes::Changes(not_null<Main::Session*> session)
+: _session(session)
+, _notifyTimer([=] { sendNotifications(); }) {
 }
 
 Main::Session &Changes::session() const {
@@ -225,19 +235,31 @@ rpl::producer<EntryUpdate> Changes::realtimeEntryUpdates(
 }
 
 void Changes::scheduleNotifications() {
-	if (!_notify) {
-		_notify = true;
+	if (_notify) {
+		return;
+	}
+	_notify = true;
+	const auto elapsed = crl::now() - _lastNotifyTime;
+	if (elapsed >= kNotifyCoalesceDelay) {
 		crl::on_main(&session(), [=] {
 			sendNotifications();
 		});
+	} else {
+		_notifyTimer.callOnce(kNotifyCoalesceDelay - elapsed);
 	}
 }
 
+void Changes::flush() {
+	_notifyTimer.cancel();
+	sendNotifications();
+}
+
 void Changes::sendNotifications() {
 	if (!_notify) {
 		return;
 	}
 	_notify = false;
+	_lastNotifyTime = crl::now();
 	_peerChanges.sendNotifications();
 	_historyChanges.sendNotifications();
 	_messageChanges.sendNotifications();
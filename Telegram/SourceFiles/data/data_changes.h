@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/flags.h"
+#include "base/timer.h"
 
 class History;
 class PeerData;
@@ -248,6 +249,10 @@ public:
 
 	void sendNotifications();
 
+	// Delivers everything scheduled right now, bypassing the
+	// frame-aligned coalescing. Mostly useful in tests.
+	void flush();
+
 private:
 	template <typename DataType, typename UpdateType>
 	class Manager final {
@@ -294,6 +299,8 @@ private:
 	Manager<HistoryItem, MessageUpdate> _messageChanges;
 	Manager<Dialogs::Entry, EntryUpdate> _entryChanges;
 
+	base::Timer _notifyTimer;
+	crl::time _lastNotifyTime = 0;
 	bool _notify = false;
 
 };
@@ -329,6 +329,7 @@ void ChatFilters::set(ChatFilter filter) {
 void ChatFilters::applyInsert(ChatFilter filter, int position) {
 	Expects(position >= 0 && position <= _list.size());
 
+	_membershipMasks.clear();
 	_list.insert(
 		begin(_list) + position,
 		ChatFilter(filter.id(), {}, {}, {}, {}, {}, {}));
@@ -347,6 +348,7 @@ void ChatFilters::remove(FilterId id) {
 void ChatFilters::applyRemove(int position) {
 	Expects(position >= 0 && position < _list.size());
 
+	_membershipMasks.clear();
 	const auto i = begin(_list) + position;
 	applyChange(*i, ChatFilter(i->id(), {}, {}, {}, {}, {}, {}));
 	_list.erase(i);
@@ -368,6 +370,7 @@ bool ChatFilters::applyChange(ChatFilter &filter, ChatFilter &&updated) {
 		return false;
 	}
 	if (rulesChanged) {
+		_membershipMasks.clear();
 		const auto filterList = _owner->chatsFilters().chatsList(id);
 		const auto feedHistory = [&](not_null<History*> history) {
 			const auto now = updated.contains(history);
@@ -439,6 +442,7 @@ bool ChatFilters::applyOrder(const QVector<MTPint> &order) {
 		++begin;
 	}
 	if (changed) {
+		_membershipMasks.clear();
 		_listChanged.fire({});
 	}
 	return true;
@@ -564,11 +568,29 @@ bool ChatFilters::loadNextExceptions(bool chatsListLoaded) {
 }
 
 void ChatFilters::refreshHistory(not_null<History*> history) {
+	_membershipMasks.remove(history);
 	if (history->inChatList() && !list().empty()) {
 		_owner->refreshChatListEntry(history);
 	}
 }
 
+uint64 ChatFilters::membershipMask(not_null<History*> history) {
+	const auto i = _membershipMasks.find(history);
+	if (i != end(_membershipMasks)) {
+		return i->second;
+	}
+	auto result = uint64();
+	auto index = 0;
+	for (const auto &filter : _list) {
+		if (filter.contains(history)) {
+			result |= (uint64(1) << index);
+		}
+		++index;
+	}
+	_membershipMasks.emplace(history, result);
+	return result;
+}
+
 void ChatFilters::requestSuggested() {
 	if (_suggestedRequestId) {
 		return;
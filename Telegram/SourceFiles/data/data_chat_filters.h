@@ -108,6 +108,11 @@ public:
 
 	void refreshHistory(not_null<History*> history);
 
+	// Bit i is set if list()[i] contains the history. Cached between the
+	// events that may change the outcome, so chat list position updates
+	// don't re-test the history against every filter's rules.
+	[[nodiscard]] uint64 membershipMask(not_null<History*> history);
+
 	[[nodiscard]] not_null<Dialogs::MainList*> chatsList(FilterId filterId);
 
 	const ChatFilter &applyUpdatedPinned(
@@ -136,6 +141,7 @@ private:
 	const not_null<Session*> _owner;
 
 	std::vector<ChatFilter> _list;
+	base::flat_map<not_null<History*>, uint64> _membershipMasks;
 	base::flat_map<FilterId, std::unique_ptr<Dialogs::MainList>> _chatsLists;
 	rpl::event_stream<> _listChanged;
 	mtpRequestId _loadRequestId = 0;
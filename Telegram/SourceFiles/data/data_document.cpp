@@ -723,6 +723,10 @@ void DocumentData::destroyLoader() {
 	}
 }
 
+int32 DocumentData::getDC() const {
+	return _dc;
+}
+
 bool DocumentData::loading() const {
 	return (_loader != nullptr);
 }
@@ -1123,6 +1127,7 @@ Image *DocumentData::getReplyPreview(
 	} else if (!_replyPreview) {
 		_replyPreview = std::make_unique<Data::ReplyPreview>(this);
 	}
+	owner().registerReplyPreviewUsage(this);
 	return _replyPreview->image(origin, context);
 }
 
@@ -1139,6 +1144,10 @@ bool DocumentData::replyPreviewLoaded() const {
 	return _replyPreview->loaded();
 }
 
+void DocumentData::clearReplyPreview() {
+	_replyPreview = nullptr;
+}
+
 StickerData *DocumentData::sticker() const {
 	return (type == StickerDocument)
 		? static_cast<StickerData*>(_additional.get())
@@ -1313,6 +1322,10 @@ Storage::Cache::Key DocumentData::cacheKey() const {
 	}
 }
 
+Storage::Cache::Key DocumentData::waveformCacheKey() const {
+	return Data::DocumentWaveformCacheKey(_dc, id);
+}
+
 uint8 DocumentData::cacheTag() const {
 	if (type == StickerDocument) {
 		return Data::kStickerCacheTag;
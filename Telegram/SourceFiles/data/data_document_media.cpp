@@ -268,15 +268,45 @@ void DocumentMedia::checkStickerLarge() {
 	if (data->isAnimated() || !loaded()) {
 		return;
 	}
-	if (_bytes.isEmpty()) {
-		const auto &loc = _owner->location(true);
-		if (loc.accessEnable()) {
-			_sticker = std::make_unique<Image>(loc.name());
-			loc.accessDisable();
+	if (_flags & Flag::StickerLargeDecoding) {
+		return;
+	}
+	// Decoding a large WEBP blocks the main thread for a while and a
+	// stickers-heavy chat asks for dozens at once, so the decode goes
+	// to a worker, one in-flight decode per document, and the result
+	// lands in whatever media view is active when it finishes.
+	_flags |= Flag::StickerLargeDecoding;
+	const auto document = _owner;
+	const auto guard = base::make_weak(&document->session());
+	const auto bytes = _bytes;
+	auto location = bytes.isEmpty()
+		? std::make_unique<Core::FileLocation>(document->location(true))
+		: nullptr;
+	crl::async([=, location = std::move(location)] {
+		const auto filepath = (location && location->accessEnable())
+			? location->name()
+			: QString();
+		auto image = bytes.isEmpty()
+			? Images::Read({ .path = filepath }).image
+			: Images::Read({ .content = bytes }).image;
+		if (!filepath.isEmpty()) {
+			location->accessDisable();
 		}
-	} else {
-		_sticker = std::make_unique<Image>(_bytes);
+		crl::on_main(guard, [=, image = std::move(image)]() mutable {
+			if (const auto active = document->activeMediaView()) {
+				active->setStickerLarge(std::move(image));
+			}
+		});
+	});
+}
+
+void DocumentMedia::setStickerLarge(QImage image) {
+	_flags &= ~Flag::StickerLargeDecoding;
+	if (_sticker || image.isNull()) {
+		return;
 	}
+	_sticker = std::make_unique<Image>(std::move(image));
+	_owner->session().notifyDownloaderTaskFinished();
 }
 
 void DocumentMedia::automaticLoad(
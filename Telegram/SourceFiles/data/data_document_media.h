@@ -69,6 +69,7 @@ public:
 	[[nodiscard]] Image *getStickerSmall();
 	[[nodiscard]] Image *getStickerLarge();
 	void checkStickerLarge(not_null<FileLoader*> loader);
+	void setStickerLarge(QImage image);
 
 	void setBytes(const QByteArray &bytes);
 	[[nodiscard]] QByteArray bytes() const;
@@ -86,6 +87,7 @@ public:
 private:
 	enum class Flag : uchar {
 		GoodThumbnailWanted = 0x01,
+		StickerLargeDecoding = 0x02,
 	};
 	inline constexpr bool is_flag_type(Flag) { return true; };
 	using Flags = base::flags<Flag>;
@@ -137,6 +137,34 @@ const Group *Groups::find(not_null<const HistoryItem*> item) const {
 	return nullptr;
 }
 
+std::vector<Ui::GroupMediaLayout> Groups::mosaicLayout(
+		not_null<const HistoryItem*> item,
+		const std::vector<QSize> &sizes,
+		int widthMax,
+		int widthMin,
+		int spacing) const {
+	const auto group = find(item);
+	if (!group) {
+		return Ui::LayoutMediaGroup(sizes, widthMax, widthMin, spacing);
+	}
+	auto &mosaic = group->mosaic;
+	if (mosaic.sizes != sizes
+		|| mosaic.widthMax != widthMax
+		|| mosaic.widthMin != widthMin
+		|| mosaic.spacing != spacing) {
+		mosaic.sizes = sizes;
+		mosaic.widthMax = widthMax;
+		mosaic.widthMin = widthMin;
+		mosaic.spacing = spacing;
+		mosaic.layout = Ui::LayoutMediaGroup(
+			sizes,
+			widthMax,
+			widthMin,
+			spacing);
+	}
+	return mosaic.layout;
+}
+
 void Groups::refreshViews(const HistoryItemsList &items) {
 	if (items.empty()) {
 		return;
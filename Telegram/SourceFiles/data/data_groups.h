@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "data/data_types.h"
+#include "ui/grouped_layout.h"
 
 namespace Data {
 
@@ -15,6 +16,18 @@ class Session;
 
 struct Group {
 	HistoryItemsList items;
+
+	// The mosaic geometry is the same in every section showing this
+	// album, so it is computed once and shared by all the views. The
+	// inputs fully determine the result, they work as the cache key.
+	struct Mosaic {
+		std::vector<QSize> sizes;
+		std::vector<Ui::GroupMediaLayout> layout;
+		int widthMax = 0;
+		int widthMin = 0;
+		int spacing = 0;
+	};
+	mutable Mosaic mosaic;
 };
 
 class Groups {
@@ -30,6 +43,13 @@ public:
 
 	[[nodiscard]] const Group *find(not_null<const HistoryItem*> item) const;
 
+	[[nodiscard]] std::vector<Ui::GroupMediaLayout> mosaicLayout(
+		not_null<const HistoryItem*> item,
+		const std::vector<QSize> &sizes,
+		int widthMax,
+		int widthMin,
+		int spacing) const;
+
 	not_null<HistoryItem*> findItemToEdit(not_null<HistoryItem*> item) const;
 
 private:
@@ -25,6 +25,7 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kDialogsEntriesPerRequest = 100;
 
 } // namespace
 
@@ -322,35 +323,44 @@ void Histories::sendDialogRequests() {
 		return false;
 	}) | ranges::to_vector;
 
-	auto peers = QVector<MTPInputDialogPeer>();
 	const auto dialogPeer = [](not_null<History*> history) {
 		return MTP_inputDialogPeer(history->peer->input);
 	};
-	ranges::transform(
-		histories,
-		ranges::back_inserter(peers),
-		dialogPeer);
 	for (auto &[history, callbacks] : base::take(_dialogRequestsPending)) {
 		_dialogRequests.emplace(history, std::move(callbacks));
 	}
 
-	const auto finalize = [=] {
-		for (const auto &history : histories) {
-			const auto state = lookup(history);
-			if (!state || !state->postponedRequestEntry) {
-				dialogEntryApplied(history);
-				history->updateChatListExistence();
+	// Pipeline several bounded requests instead of one huge one, so on
+	// initial sync of accounts with thousands of dialogs the responses
+	// arrive and get applied incrementally.
+	const auto count = int(histories.size());
+	for (auto from = 0; from < count; from += kDialogsEntriesPerRequest) {
+		const auto till = std::min(from + kDialogsEntriesPerRequest, count);
+		auto chunk = std::vector<not_null<History*>>(
+			begin(histories) + from,
+			begin(histories) + till);
+		auto peers = QVector<MTPInputDialogPeer>();
+		peers.reserve(chunk.size());
+		ranges::transform(chunk, ranges::back_inserter(peers), dialogPeer);
+
+		const auto finalize = [=, chunk = std::move(chunk)] {
+			for (const auto &history : chunk) {
+				const auto state = lookup(history);
+				if (!state || !state->postponedRequestEntry) {
+					dialogEntryApplied(history);
+					history->updateChatListExistence();
+				}
 			}
-		}
-	};
-	session().api().request(MTPmessages_GetPeerDialogs(
-		MTP_vector(std::move(peers))
-	)).done([=](const MTPmessages_PeerDialogs &result) {
-		applyPeerDialogs(result);
-		finalize();
-	}).fail([=] {
-		finalize();
-	}).send();
+		};
+		session().api().request(MTPmessages_GetPeerDialogs(
+			MTP_vector(std::move(peers))
+		)).done([=](const MTPmessages_PeerDialogs &result) {
+			applyPeerDialogs(result);
+			finalize();
+		}).fail([=] {
+			finalize();
+		}).send();
+	}
 }
 
 void Histories::dialogEntryApplied(not_null<History*> history) {
@@ -661,6 +661,20 @@ bool MessageReactions::change(
 	}
 	if (_recent != parsed) {
 		_recent = std::move(parsed);
+		// Resolve the unknown reactor peers with one batched request
+		// instead of letting each view request them one by one.
+		auto unknown = QList<PeerData*>();
+		for (const auto &[emoji, list] : _recent) {
+			for (const auto &entry : list) {
+				if (!entry.peer->isMinimalLoaded()
+					&& !unknown.contains(entry.peer.get())) {
+					unknown.push_back(entry.peer);
+				}
+			}
+		}
+		if (!unknown.isEmpty()) {
+			owner.session().api().requestPeers(unknown);
+		}
 		changed = true;
 	}
 	return changed;
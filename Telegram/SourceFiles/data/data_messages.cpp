@@ -39,18 +39,38 @@ int MessagesList::uniteAndAdd(
 		MessagesRange noSkipRange) {
 	auto uniteFromIndex = uniteFrom - _slices.begin();
 	auto was = uniteFrom->messages.size();
-	_slices.modify(uniteFrom, [&](Slice &slice) {
-		slice.merge(messages, noSkipRange);
-	});
 	auto firstToErase = uniteFrom + 1;
 	if (firstToErase != uniteTill) {
+		// merge() re-sorts the whole united set, so when the incoming
+		// range bridges several slices, collect everything into one
+		// bulk merge instead of paying a full sort per united slice.
+		auto unitedCount = int(std::end(messages) - std::begin(messages));
 		for (auto it = firstToErase; it != uniteTill; ++it) {
-			_slices.modify(uniteFrom, [&](Slice &slice) {
-				slice.merge(it->messages, it->range);
-			});
+			unitedCount += it->messages.size();
+		}
+		auto united = std::vector<MessagePosition>();
+		united.reserve(unitedCount);
+		united.insert(united.end(), std::begin(messages), std::end(messages));
+		auto unitedRange = noSkipRange;
+		for (auto it = firstToErase; it != uniteTill; ++it) {
+			united.insert(
+				united.end(),
+				it->messages.begin(),
+				it->messages.end());
+			unitedRange = {
+				qMin(unitedRange.from, it->range.from),
+				qMax(unitedRange.till, it->range.till)
+			};
 		}
+		_slices.modify(uniteFrom, [&](Slice &slice) {
+			slice.merge(united, unitedRange);
+		});
 		_slices.erase(firstToErase, uniteTill);
 		uniteFrom = _slices.begin() + uniteFromIndex;
+	} else {
+		_slices.modify(uniteFrom, [&](Slice &slice) {
+			slice.merge(messages, noSkipRange);
+		});
 	}
 	update.messages = &uniteFrom->messages;
 	update.range = uniteFrom->range;
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_chat.h"
 #include "data/data_channel.h"
 #include "data/data_changes.h"
+#include "data/data_peer_values.h"
 #include "data/data_photo.h"
 #include "data/data_folder.h"
 #include "data/data_session.h"
@@ -238,12 +239,14 @@ void PeerData::updateNameDelayed(
 	}
 	if (isUser()) {
 		if (asUser()->username != newUsername) {
+			_owner->usernameChanged(this, asUser()->username, newUsername);
 			asUser()->username = newUsername;
 			flags |= UpdateFlag::Username;
 		}
 		asUser()->setNameOrPhone(newNameOrPhone);
 	} else if (isChannel()) {
 		if (asChannel()->username != newUsername) {
+			_owner->usernameChanged(this, asChannel()->username, newUsername);
 			asChannel()->username = newUsername;
 			if (newUsername.isEmpty()) {
 				asChannel()->removeFlags(ChannelDataFlag::Username);
@@ -271,6 +274,25 @@ not_null<Ui::EmptyUserpic*> PeerData::ensureEmptyUserpic() const {
 	return _userpicEmpty.get();
 }
 
+const QPixmap &PeerData::emptyUserpicFrame(int size) const {
+	// The empty userpic fills a circle and draws antialiased initials
+	// on top on every paint, which adds up in scrolling lists, so the
+	// rendered frames are kept by size and shared by all the views.
+	const auto empty = ensureEmptyUserpic();
+	const auto key = empty->uniqueKey();
+	if (_userpicEmptyFramesKey != key) {
+		_userpicEmptyFramesKey = key;
+		_userpicEmptyFrames.clear();
+	}
+	const auto i = _userpicEmptyFrames.find(size);
+	if (i != end(_userpicEmptyFrames)) {
+		return i->second;
+	}
+	return _userpicEmptyFrames.emplace(
+		size,
+		empty->generate(size)).first->second;
+}
+
 ClickHandlerPtr PeerData::createOpenLink() {
 	return std::make_shared<PeerClickHandler>(this);
 }
@@ -301,8 +323,9 @@ Image *PeerData::currentUserpic(
 		_userpic.load(&session(), userpicOrigin());
 	}
 	const auto image = view ? view->image() : nullptr;
-	if (image) {
+	if (image && _userpicEmpty) {
 		_userpicEmpty = nullptr;
+		_userpicEmptyFrames.clear();
 	} else if (isNotificationsUser()) {
 		static auto result = Image(
 			Window::LogoNoMargin().scaledToWidth(
@@ -326,7 +349,7 @@ void PeerData::paintUserpic(
 			y,
 			userpic->pix(size, size, { .options = circled }));
 	} else {
-		ensureEmptyUserpic()->paint(p, x, y, x + size + x, size);
+		p.drawPixmap(x, y, emptyUserpicFrame(size));
 	}
 }
 
@@ -633,7 +656,7 @@ void PeerData::fillNames() {
 
 	const auto namesList = TextUtilities::PrepareSearchWords(toIndex);
 	for (const auto &name : namesList) {
-		_nameWords.insert(name);
+		_nameWords.insert(owner().internNameWord(name));
 		_nameFirstLetters.insert(name[0]);
 	}
 }
@@ -869,6 +892,27 @@ bool PeerData::canWrite() const {
 	return false;
 }
 
+rpl::producer<bool> PeerData::canWriteValue() {
+	if (!_canWriteValue) {
+		// One combine chain per peer instead of one per subscriber,
+		// the variable recomputes on flag changes and multicasts the
+		// deduplicated result to everyone listening.
+		auto computed = [&]() -> rpl::producer<bool> {
+			if (const auto user = asUser()) {
+				return Data::CanWriteValue(user);
+			} else if (const auto chat = asChat()) {
+				return Data::CanWriteValue(chat);
+			} else if (const auto channel = asChannel()) {
+				return Data::CanWriteValue(channel);
+			}
+			Unexpected("Peer type in PeerData::canWriteValue.");
+		}();
+		_canWriteValue = std::make_unique<rpl::variable<bool>>(
+			std::move(computed));
+	}
+	return _canWriteValue->value();
+}
+
 bool PeerData::allowsForwarding() const {
 	if (const auto user = asUser()) {
 		return true;
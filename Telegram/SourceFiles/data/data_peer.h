@@ -208,6 +208,7 @@ public:
 	}
 
 	[[nodiscard]] bool canWrite() const;
+	[[nodiscard]] rpl::producer<bool> canWriteValue();
 	[[nodiscard]] bool allowsForwarding() const;
 	[[nodiscard]] Data::RestrictionCheckResult amRestricted(
 		ChatRestriction right) const;
@@ -424,6 +425,7 @@ protected:
 private:
 	void fillNames();
 	[[nodiscard]] not_null<Ui::EmptyUserpic*> ensureEmptyUserpic() const;
+	[[nodiscard]] const QPixmap &emptyUserpicFrame(int size) const;
 	[[nodiscard]] virtual auto unavailableReasons() const
 		-> const std::vector<Data::UnavailableReason> &;
 
@@ -434,6 +436,12 @@ private:
 	mutable Data::CloudImage _userpic;
 	PhotoId _userpicPhotoId = kUnknownPhotoId;
 	mutable std::unique_ptr<Ui::EmptyUserpic> _userpicEmpty;
+
+	// Rendered empty userpic frames by size, shared by all the views
+	// painting this peer, invalidated by the empty userpic unique key.
+	mutable base::flat_map<int, QPixmap> _userpicEmptyFrames;
+	mutable InMemoryKey _userpicEmptyFramesKey;
+
 	Ui::Text::String _nameText;
 
 	Data::NotifySettings _notify;
@@ -456,6 +464,10 @@ private:
 	QString _about;
 	QString _themeEmoticon;
 
+	// Memoized Data::CanWriteValue() chain, multicast to all the rows
+	// and panels subscribed to this peer, created on the first request.
+	std::unique_ptr<rpl::variable<bool>> _canWriteValue;
+
 };
 
 namespace Data {
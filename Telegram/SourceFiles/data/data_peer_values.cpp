@@ -239,14 +239,9 @@ rpl::producer<bool> CanWriteValue(ChannelData *channel) {
 }
 
 rpl::producer<bool> CanWriteValue(not_null<PeerData*> peer) {
-	if (auto user = peer->asUser()) {
-		return CanWriteValue(user);
-	} else if (auto chat = peer->asChat()) {
-		return CanWriteValue(chat);
-	} else if (auto channel = peer->asChannel()) {
-		return CanWriteValue(channel);
-	}
-	Unexpected("Bad peer value in CanWriteValue");
+	// The peer memoizes the chain built by the typed overloads above,
+	// so all subscribers share a single recomputation per flag change.
+	return peer->canWriteValue();
 }
 
 // This is duplicated in PeerData::canPinMessages().
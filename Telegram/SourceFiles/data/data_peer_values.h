@@ -103,6 +103,8 @@ inline auto PeerFullFlagValue(
 [[nodiscard]] rpl::producer<bool> CanWriteValue(UserData *user);
 [[nodiscard]] rpl::producer<bool> CanWriteValue(ChatData *chat);
 [[nodiscard]] rpl::producer<bool> CanWriteValue(ChannelData *channel);
+
+// Memoized per peer, prefer this overload when subscribing many rows.
 [[nodiscard]] rpl::producer<bool> CanWriteValue(not_null<PeerData*> peer);
 [[nodiscard]] rpl::producer<bool> CanPinMessagesValue(not_null<PeerData*> peer);
 [[nodiscard]] rpl::producer<bool> CanManageGroupCallValue(not_null<PeerData*> peer);
@@ -22,10 +22,17 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "facades.h"
 
+#include <crl/crl_async.h>
+
 namespace {
 
 constexpr auto kPhotoSideLimit = 1280;
 
+// Images smaller than this decode right in the loader-done callback,
+// a thread hop would only delay them. Everything bigger goes through
+// crl::async so the decode doesn't block the main thread.
+constexpr auto kBackgroundDecodeMinSize = 512 * 1024;
+
 using Data::PhotoMedia;
 using Data::PhotoSize;
 using Data::PhotoSizeIndex;
@@ -78,6 +85,10 @@ void PhotoData::load(
 	load(PhotoSize::Large, origin, fromCloud, autoLoading);
 }
 
+int32 PhotoData::getDC() const {
+	return _dc;
+}
+
 bool PhotoData::loading() const {
 	return loading(PhotoSize::Large);
 }
@@ -214,6 +225,7 @@ Image *PhotoData::getReplyPreview(
 	if (!_replyPreview) {
 		_replyPreview = std::make_unique<Data::ReplyPreview>(this);
 	}
+	owner().registerReplyPreviewUsage(this);
 	return _replyPreview->image(origin, context);
 }
 
@@ -228,6 +240,10 @@ bool PhotoData::replyPreviewLoaded() const {
 	return _replyPreview->loaded();
 }
 
+void PhotoData::clearReplyPreview() {
+	_replyPreview = nullptr;
+}
+
 void PhotoData::setRemoteLocation(
 		int32 dc,
 		uint64 access,
@@ -296,12 +312,14 @@ void PhotoData::load(
 		}
 		return true;
 	};
-	const auto done = [=](QImage result, QByteArray bytes) {
-		Expects(_images[valid].loader != nullptr);
-
+	const auto fail = [=](bool started) {
+		if (validSize == PhotoSize::Large) {
+			_owner->photoLoadFail(this, started);
+		}
+	};
+	const auto apply = [=](QImage result, QByteArray bytes, int loadSize) {
 		// Find out what progressive photo size have we loaded exactly.
 		auto goodFor = validSize;
-		const auto loadSize = _images[valid].loader->loadSize();
 		if (valid > 0 && _images[valid].byteSize > loadSize) {
 			for (auto i = valid; i != 0;) {
 				--i;
@@ -323,10 +341,36 @@ void PhotoData::load(
 			_owner->photoLoadDone(this);
 		}
 	};
-	const auto fail = [=](bool started) {
-		if (validSize == PhotoSize::Large) {
-			_owner->photoLoadFail(this, started);
+	const auto done = [=](QByteArray bytes) {
+		Expects(_images[valid].loader != nullptr);
+
+		const auto loadSize = _images[valid].loader->loadSize();
+		if (bytes.size() <= kBackgroundDecodeMinSize) {
+			auto read = Images::Read({ .content = bytes });
+			if (read.image.isNull()) {
+				_images[valid].flags |= Data::CloudFile::Flag::Failed;
+				fail(true);
+			} else {
+				apply(std::move(read.image), std::move(bytes), loadSize);
+			}
+			return;
 		}
+		// A full resolution photo takes long enough to decode to stall
+		// the media viewer open animation, so big images decode on a
+		// worker while the viewer shows the already available preview
+		// or progressive front part, and the result swaps in place.
+		const auto weak = base::make_weak(&session());
+		crl::async([=] {
+			auto read = Images::Read({ .content = bytes });
+			crl::on_main(weak, [=, image = std::move(read.image)]() mutable {
+				if (image.isNull()) {
+					_images[valid].flags |= Data::CloudFile::Flag::Failed;
+					fail(true);
+				} else {
+					apply(std::move(image), bytes, loadSize);
+				}
+			});
+		});
 	};
 	const auto progress = [=] {
 		if (validSize == PhotoSize::Large) {
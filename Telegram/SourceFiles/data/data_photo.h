@@ -53,6 +53,7 @@ public:
 
 	void automaticLoadSettingsChanged();
 
+	[[nodiscard]] int32 getDC() const;
 	[[nodiscard]] bool loading() const;
 	[[nodiscard]] bool displayLoading() const;
 	void cancel();
@@ -69,6 +70,7 @@ public:
 		not_null<PeerData*> context);
 	[[nodiscard]] Image *getReplyPreview(not_null<HistoryItem*> item);
 	[[nodiscard]] bool replyPreviewLoaded() const;
+	void clearReplyPreview();
 
 	void setRemoteLocation(
 		int32 dc,
@@ -51,6 +51,9 @@ struct PollData {
 	bool applyChanges(const MTPDpoll &poll);
 	bool applyResults(const MTPPollResults &results);
 	[[nodiscard]] bool checkResultsReload(crl::time now);
+	[[nodiscard]] crl::time lastResultsUpdate() const {
+		return _lastResultsUpdate;
+	}
 
 	[[nodiscard]] PollAnswer *answerByOption(const QByteArray &option);
 	[[nodiscard]] const PollAnswer *answerByOption(
@@ -0,0 +1,129 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_search_index.h"
+
+#include "data/data_session.h"
+#include "data/data_peer.h"
+#include "history/history.h"
+#include "history/history_item.h"
+#include "ui/text/text_entity.h"
+
+namespace Data {
+namespace {
+
+// Long texts are indexed only up to this many characters, enough for
+// any realistic query while keeping the posting lists bounded.
+constexpr auto kIndexTextLimit = 4096;
+constexpr auto kTrigramSize = 3;
+
+[[nodiscard]] QString NormalizeText(const QString &text) {
+	return TextUtilities::RemoveAccents(text).toLower();
+}
+
+} // namespace
+
+std::vector<SearchIndex::Trigram> SearchIndex::CollectTrigrams(
+		const QString &text) {
+	const auto size = std::min(int(text.size()), kIndexTextLimit);
+	auto result = std::vector<Trigram>();
+	if (size < kTrigramSize) {
+		return result;
+	}
+	result.reserve(size - kTrigramSize + 1);
+	for (auto i = 0; i != size - kTrigramSize + 1; ++i) {
+		result.push_back((Trigram(text[i].unicode()) << 32)
+			| (Trigram(text[i + 1].unicode()) << 16)
+			| Trigram(text[i + 2].unicode()));
+	}
+	ranges::sort(result);
+	result.erase(ranges::unique(result), end(result));
+	return result;
+}
+
+void SearchIndex::add(not_null<HistoryItem*> item) {
+	if (item->isService()) {
+		return;
+	}
+	const auto trigrams = CollectTrigrams(
+		NormalizeText(item->originalText().text));
+	const auto fullId = item->fullId();
+	for (const auto trigram : trigrams) {
+		_postings[trigram].emplace(fullId);
+	}
+}
+
+void SearchIndex::remove(not_null<HistoryItem*> item) {
+	if (item->isService()) {
+		return;
+	}
+	// If the text was edited after add() some entries are left behind,
+	// search() skips them because the item lookup by id fails.
+	const auto trigrams = CollectTrigrams(
+		NormalizeText(item->originalText().text));
+	const auto fullId = item->fullId();
+	for (const auto trigram : trigrams) {
+		const auto i = _postings.find(trigram);
+		if (i != end(_postings)) {
+			i->second.remove(fullId);
+			if (i->second.empty()) {
+				_postings.erase(i);
+			}
+		}
+	}
+}
+
+std::vector<not_null<HistoryItem*>> SearchIndex::search(
+		not_null<Session*> owner,
+		PeerId peerId,
+		const QString &query,
+		int limit) const {
+	auto result = std::vector<not_null<HistoryItem*>>();
+	const auto normalized = NormalizeText(query.trimmed());
+	const auto trigrams = CollectTrigrams(normalized);
+	if (trigrams.empty()) {
+		return result;
+	}
+	auto lists = std::vector<const base::flat_set<FullMsgId>*>();
+	lists.reserve(trigrams.size());
+	for (const auto trigram : trigrams) {
+		const auto i = _postings.find(trigram);
+		if (i == end(_postings)) {
+			return result;
+		}
+		lists.push_back(&i->second);
+	}
+	ranges::sort(lists, ranges::less(), [](const auto *list) {
+		return list->size();
+	});
+	for (const auto &fullId : *lists.front()) {
+		const auto inAllLists = ranges::all_of(
+			lists | ranges::views::drop(1),
+			[&](const auto *list) { return list->contains(fullId); });
+		if (!inAllLists) {
+			continue;
+		} else if (peerId && fullId.peer != peerId) {
+			continue;
+		}
+		const auto item = owner->message(fullId);
+		if (!item
+			|| !NormalizeText(item->originalText().text).contains(
+				normalized)) {
+			continue;
+		}
+		result.push_back(item);
+		if (int(result.size()) >= limit) {
+			break;
+		}
+	}
+	ranges::sort(result, ranges::greater(), [](not_null<HistoryItem*> item) {
+		return item->fullId().msg;
+	});
+	return result;
+}
+
+} // namespace Data
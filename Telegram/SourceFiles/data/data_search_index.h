@@ -0,0 +1,43 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "data/data_msg_id.h"
+
+class HistoryItem;
+
+namespace Data {
+
+class Session;
+
+// In-memory trigram index over the text of loaded messages, so the
+// dialogs search box can show instant local results before (or without)
+// the server round trip. Entries live exactly as long as the items are
+// registered in Data::Session, no on-disk state.
+class SearchIndex final {
+public:
+	void add(not_null<HistoryItem*> item);
+	void remove(not_null<HistoryItem*> item);
+
+	[[nodiscard]] std::vector<not_null<HistoryItem*>> search(
+		not_null<Session*> owner,
+		PeerId peerId,
+		const QString &query,
+		int limit) const;
+
+private:
+	using Trigram = uint64;
+
+	[[nodiscard]] static std::vector<Trigram> CollectTrigrams(
+		const QString &text);
+
+	base::flat_map<Trigram, base::flat_set<FullMsgId>> _postings;
+
+};
+
+} // namespace Data
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/mime_type.h" // Core::IsMimeSticker
 #include "core/crash_reports.h" // CrashReports::SetAnnotation
+#include "core/perf_trace.h"
 #include "ui/image/image.h"
 #include "ui/image/image_location_factory.h" // Images::FromPhotoSize
 #include "ui/text/format_values.h" // Ui::FormatPhone
@@ -54,6 +55,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_chat_filters.h"
 #include "data/data_scheduled_messages.h"
 #include "data/data_send_action.h"
+#include "data/data_replies_list.h"
 #include "data/data_sponsored_messages.h"
 #include "data/data_message_reactions.h"
 #include "data/data_cloud_themes.h"
@@ -71,6 +73,23 @@ namespace Data {
 namespace {
 
 constexpr auto kMaxNotifyCheckDelay = 24 * 3600 * crl::time(1000);
+constexpr auto kItemsEvictionCheckEach = 60 * crl::time(1000);
+constexpr auto kItemsEvictionIdlePasses = 3;
+
+// All the reply previews are squares of st::msgReplyBarSize.height(),
+// so a fixed entries budget corresponds to a fixed byte budget, about
+// 16 MB at 100% scale for this value.
+constexpr auto kKeepReplyPreviewsCount = 1024;
+constexpr auto kKeptRepliesLists = 8;
+
+// Big channels deliver storms of poll result updates, the latest
+// snapshot per poll is applied once per this interval instead.
+constexpr auto kPollResultsDebounce = crl::time(250);
+
+// Initial bucket reservation for the entity owner maps, so the login
+// ingest burst doesn't rehash the hottest tables a dozen times while
+// they grow from empty to their steady-state sizes.
+constexpr auto kOwnerMapsReserve = 4096;
 
 using ViewElement = HistoryView::Element;
 
@@ -230,23 +249,29 @@ Session::Session(not_null<Main::Session*> session)
 , _contactsList(Dialogs::SortMode::Name)
 , _contactsNoChatsList(Dialogs::SortMode::Name)
 , _ttlCheckTimer([=] { checkTTLs(); })
+, _itemsEvictionTimer([=] { checkItemsEviction(); })
 , _selfDestructTimer([=] { checkSelfDestructItems(); })
 , _pollsClosingTimer([=] { checkPollsClosings(); })
+, _pendingPollResultsTimer([=] { applyPendingPollResults(); })
 , _unmuteByFinishedTimer([=] { unmuteByFinished(); })
 , _groups(this)
 , _chatsFilters(std::make_unique<ChatFilters>(this))
-, _scheduledMessages(std::make_unique<ScheduledMessages>(this))
 , _cloudThemes(std::make_unique<CloudThemes>(session))
 , _sendActionManager(std::make_unique<SendActionManager>())
 , _streaming(std::make_unique<Streaming>(this))
 , _mediaRotation(std::make_unique<MediaRotation>())
 , _histories(std::make_unique<Histories>(this))
 , _stickers(std::make_unique<Stickers>(this))
-, _sponsoredMessages(std::make_unique<SponsoredMessages>(this))
 , _reactions(std::make_unique<Reactions>(this)) {
 	_cache->open(_session->local().cacheKey());
 	_bigFileCache->open(_session->local().cacheBigFileKey());
 
+	_peers.reserve(kOwnerMapsReserve);
+	_messages.reserve(kOwnerMapsReserve);
+	_photos.reserve(kOwnerMapsReserve);
+	_documents.reserve(kOwnerMapsReserve);
+	_webpages.reserve(kOwnerMapsReserve);
+
 	if constexpr (Platform::IsLinux()) {
 		const auto wasVersion = _session->local().oldMapVersion();
 		if (wasVersion >= 1007011 && wasVersion < 1007015) {
@@ -275,12 +300,31 @@ Session::Session(not_null<Main::Session*> session)
 	}, _lifetime);
 }
 
+ScheduledMessages &Session::scheduledMessages() {
+	// Created lazily, most sessions never open the scheduled section
+	// and never receive scheduled message updates.
+	if (!_scheduledMessages) {
+		_scheduledMessages = std::make_unique<ScheduledMessages>(this);
+	}
+	return *_scheduledMessages;
+}
+
+SponsoredMessages &Session::sponsoredMessages() {
+	// Created lazily, only sessions viewing large channels need it.
+	if (!_sponsoredMessages) {
+		_sponsoredMessages = std::make_unique<SponsoredMessages>(this);
+	}
+	return *_sponsoredMessages;
+}
+
 void Session::clear() {
 	// Optimization: clear notifications before destroying items.
 	Core::App().notifications().clearFromSession(_session);
 
 	_sendActionManager->clear();
 
+	_recentRepliesLists.clear();
+	_repliesLists.clear();
 	_histories->unloadAll();
 	_scheduledMessages = nullptr;
 	_sponsoredMessages = nullptr;
@@ -295,6 +339,9 @@ void Session::clear() {
 	_histories->clearAll();
 	_webpages.clear();
 	_locations.clear();
+	_pendingPollResultsTimer.cancel();
+	_pendingPollResults.clear();
+	_pollsRepaintOnly.clear();
 	_polls.clear();
 	_games.clear();
 	_documents.clear();
@@ -928,13 +975,27 @@ UserData *Session::userByPhone(const QString &phone) const {
 }
 
 PeerData *Session::peerByUsername(const QString &username) const {
-	const auto uname = username.trimmed();
-	for (const auto &[peerId, peer] : _peers) {
-		if (!peer->userName().compare(uname, Qt::CaseInsensitive)) {
-			return peer.get();
+	const auto i = _peersByUsername.find(username.trimmed().toLower());
+	return (i != end(_peersByUsername)) ? i->second.get() : nullptr;
+}
+
+void Session::usernameChanged(
+		not_null<PeerData*> peer,
+		const QString &oldUsername,
+		const QString &newUsername) {
+	const auto old = oldUsername.trimmed().toLower();
+	if (!old.isEmpty()) {
+		const auto i = _peersByUsername.find(old);
+		// A username can move between peers before we learn that the
+		// old owner lost it, so unregister only our own stale entry.
+		if (i != end(_peersByUsername) && i->second == peer) {
+			_peersByUsername.erase(i);
 		}
 	}
-	return nullptr;
+	const auto now = newUsername.trimmed().toLower();
+	if (!now.isEmpty()) {
+		_peersByUsername.emplace_or_assign(now, peer);
+	}
 }
 
 void Session::enumerateUsers(Fn<void(not_null<UserData*>)> action) const {
@@ -1025,6 +1086,7 @@ void Session::chatsListDone(Data::Folder *folder) {
 		folder->chatsList()->setLoaded();
 	} else {
 		_chatsList.setLoaded();
+		_session->local().writeDialogsSnapshot();
 	}
 	_chatsListLoadedEvents.fire_copy(folder);
 }
@@ -1117,6 +1179,14 @@ QString Session::nameSortKey(const QString &name) const {
 	return TextUtilities::RemoveAccents(name).toLower();
 }
 
+QString Session::internNameWord(const QString &word) {
+	// Returned copies share the payload of the interned QString, so all
+	// peers index the same allocation for each distinct word. Entries
+	// stay until logout, which is fine - the table is bounded by the
+	// distinct words it deduplicates.
+	return *_internedNameWords.emplace(word).first;
+}
+
 void Session::setupMigrationViewer() {
 	session().changes().peerUpdates(
 		PeerUpdate::Flag::Migration
@@ -1415,6 +1485,7 @@ rpl::producer<Session::IdChange> Session::itemIdChanged() const {
 }
 
 void Session::requestItemRepaint(not_null<const HistoryItem*> item) {
+	Core::Trace::Count("item-repaint-request");
 	_itemRepaintRequest.fire_copy(item);
 	auto repaintGroupLeader = false;
 	auto repaintView = [&](not_null<const ViewElement*> view) {
@@ -1444,6 +1515,7 @@ rpl::producer<not_null<const HistoryItem*>> Session::itemRepaintRequest() const
 }
 
 void Session::requestViewRepaint(not_null<const ViewElement*> view) {
+	Core::Trace::Count("view-repaint-request");
 	_viewRepaintRequest.fire_copy(view);
 }
 
@@ -1452,6 +1524,7 @@ rpl::producer<not_null<const ViewElement*>> Session::viewRepaintRequest() const
 }
 
 void Session::requestItemResize(not_null<const HistoryItem*> item) {
+	Core::Trace::Count("item-resize-request");
 	_itemResizeRequest.fire_copy(item);
 	enumerateItemViews(item, [&](not_null<ViewElement*> view) {
 		requestViewResize(view);
@@ -1463,6 +1536,7 @@ rpl::producer<not_null<const HistoryItem*>> Session::itemResizeRequest() const {
 }
 
 void Session::requestViewResize(not_null<ViewElement*> view) {
+	Core::Trace::Count("view-resize-request");
 	view->setPendingResize();
 	_viewResizeRequest.fire_copy(view);
 	notifyViewLayoutChange(view);
@@ -1637,6 +1711,48 @@ void Session::unloadHeavyViewParts(
 	}
 }
 
+void Session::registerReplyPreviewUsage(not_null<PhotoData*> photo) {
+	_photoReplyPreviews[photo] = ++_replyPreviewsUsageIndex;
+	checkReplyPreviewsCapacity();
+}
+
+void Session::registerReplyPreviewUsage(not_null<DocumentData*> document) {
+	_documentReplyPreviews[document] = ++_replyPreviewsUsageIndex;
+	checkReplyPreviewsCapacity();
+}
+
+void Session::checkReplyPreviewsCapacity() {
+	const auto total = _photoReplyPreviews.size()
+		+ _documentReplyPreviews.size();
+	if (total <= kKeepReplyPreviewsCount) {
+		return;
+	}
+	const auto lastUsage = [](const auto &pair) {
+		return pair.second;
+	};
+	const auto photo = ranges::min_element(
+		_photoReplyPreviews,
+		ranges::less(),
+		lastUsage);
+	const auto document = ranges::min_element(
+		_documentReplyPreviews,
+		ranges::less(),
+		lastUsage);
+	const auto photoUsage = (photo != end(_photoReplyPreviews))
+		? photo->second
+		: std::numeric_limits<uint64>::max();
+	const auto documentUsage = (document != end(_documentReplyPreviews))
+		? document->second
+		: std::numeric_limits<uint64>::max();
+	if (photoUsage < documentUsage) {
+		photo->first->clearReplyPreview();
+		_photoReplyPreviews.erase(photo);
+	} else {
+		document->first->clearReplyPreview();
+		_documentReplyPreviews.erase(document);
+	}
+}
+
 void Session::registerShownSpoiler(FullMsgId id) {
 	if (const auto item = message(id)) {
 		_shownSpoilers.emplace(item);
@@ -1985,6 +2101,7 @@ void Session::registerMessage(not_null<HistoryItem*> item) {
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.emplace(itemId, item);
 	}
+	_searchIndex.add(item);
 }
 
 void Session::registerMessageTTL(TimeId when, not_null<HistoryItem*> item) {
@@ -2038,6 +2155,94 @@ void Session::checkTTLs() {
 	scheduleNextTTLs();
 }
 
+void Session::setItemsEvictionBudget(int itemsCount) {
+	_itemsEvictionBudget = itemsCount;
+	if (_itemsEvictionBudget > 0) {
+		if (!_itemsEvictionTimer.isActive()) {
+			_itemsEvictionTimer.callEach(kItemsEvictionCheckEach);
+		}
+	} else {
+		_itemsEvictionTimer.cancel();
+		_itemsEvictionIdle.clear();
+	}
+}
+
+int Session::materializedItemsCount() const {
+	auto result = 0;
+	for (const auto &[peerId, list] : _messages) {
+		result += int(list.size());
+	}
+	return result;
+}
+
+void Session::checkItemsEviction() {
+	Expects(_itemsEvictionBudget > 0);
+
+	const auto total = materializedItemsCount();
+	if (total <= _itemsEvictionBudget) {
+		_itemsEvictionIdle.clear();
+		return;
+	}
+
+	// A history with built blocks is (or just was) on screen, its items
+	// must not be touched. The others have to stay unshown for several
+	// passes in a row before their parsed items are dropped.
+	auto evictable = std::vector<std::pair<int, not_null<History*>>>();
+	for (const auto &[peerId, list] : _messages) {
+		const auto history = historyLoaded(peerId);
+		if (!history) {
+			continue;
+		} else if (!history->isEmpty()) {
+			_itemsEvictionIdle.remove(history);
+			continue;
+		}
+		const auto idle = ++_itemsEvictionIdle[history];
+		if (idle >= kItemsEvictionIdlePasses) {
+			evictable.emplace_back(idle, history);
+		}
+	}
+	ranges::sort(evictable, std::greater<>());
+	auto left = total - _itemsEvictionBudget;
+	for (const auto &[idle, history] : evictable) {
+		if (left <= 0) {
+			break;
+		}
+		left -= evictHistoryItems(history);
+	}
+}
+
+int Session::evictHistoryItems(not_null<History*> history) {
+	const auto list = messagesList(history->peer->id);
+	if (!list) {
+		return 0;
+	}
+
+	// Keep anchors that can't be re-materialized cheaply or that other
+	// parts of the app point to: unread and pinned items, the last and
+	// the chats list messages, local (non-regular) entries. Everything
+	// else is reloaded from Storage::Facade / the server on demand.
+	const auto last = history->lastMessage();
+	const auto shown = history->chatListMessage();
+	auto evicting = std::vector<not_null<HistoryItem*>>();
+	evicting.reserve(list->size());
+	for (const auto &[itemId, item] : *list) {
+		if (!item->isRegular()
+			|| item->isPinned()
+			|| item->mainView()
+			|| item->unread()
+			|| item == last
+			|| item == shown) {
+			continue;
+		}
+		evicting.push_back(item);
+	}
+	for (const auto &item : evicting) {
+		item->destroy();
+	}
+	_itemsEvictionIdle.remove(history);
+	return int(evicting.size());
+}
+
 void Session::processMessagesDeleted(
 		PeerId peerId,
 		const QVector<MTPint> &data) {
@@ -2104,6 +2309,7 @@ void Session::unregisterMessage(not_null<HistoryItem*> item) {
 		Data::MessageUpdate::Flag::Destroyed);
 	groups().unregisterMessage(item);
 	removeDependencyMessage(item);
+	_searchIndex.remove(item);
 	messagesListForInsert(peerId)->erase(itemId);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
@@ -2117,6 +2323,37 @@ MsgId Session::nextLocalMessageId() {
 	return _localMessageIdCounter++;
 }
 
+std::shared_ptr<RepliesList> Session::repliesList(
+		not_null<History*> history,
+		MsgId rootId) {
+	const auto key = std::pair(history, rootId);
+	auto &weak = _repliesLists[key];
+	auto result = weak.lock();
+	if (!result) {
+		result = std::make_shared<RepliesList>(history, rootId);
+		weak = result;
+		for (auto i = begin(_repliesLists); i != end(_repliesLists);) {
+			if (i->second.lock()) {
+				++i;
+			} else {
+				i = _repliesLists.erase(i);
+			}
+		}
+	}
+
+	// Keep the few most recently opened threads alive, so reopening
+	// them shows the already loaded slice and only fetches the delta.
+	const auto i = ranges::find(_recentRepliesLists, result);
+	if (i != end(_recentRepliesLists)) {
+		_recentRepliesLists.erase(i);
+	}
+	_recentRepliesLists.push_back(result);
+	if (_recentRepliesLists.size() > kKeptRepliesLists) {
+		_recentRepliesLists.erase(begin(_recentRepliesLists));
+	}
+	return result;
+}
+
 void Session::setSuggestToGigagroup(
 		not_null<ChannelData*> group,
 		bool suggest) {
@@ -3303,8 +3540,28 @@ void Session::applyUpdate(const MTPDupdateMessagePoll &update) {
 			? processPoll(*poll).get()
 			: i->second.get();
 	}();
-	if (updated && updated->applyResults(update.vresults())) {
-		notifyPollUpdateDelayed(updated);
+	if (!updated) {
+		return;
+	} else if (crl::now() - updated->lastResultsUpdate()
+		>= kPollResultsDebounce) {
+		_pendingPollResults.remove(updated);
+		if (updated->applyResults(update.vresults())) {
+			notifyPollRepaintDelayed(updated);
+		}
+	} else {
+		// Results are full snapshots, so only the latest one matters.
+		_pendingPollResults[updated] = update.vresults();
+		if (!_pendingPollResultsTimer.isActive()) {
+			_pendingPollResultsTimer.callOnce(kPollResultsDebounce);
+		}
+	}
+}
+
+void Session::applyPendingPollResults() {
+	for (const auto &[poll, results] : base::take(_pendingPollResults)) {
+		if (poll->applyResults(results)) {
+			notifyPollRepaintDelayed(poll);
+		}
 	}
 }
 
@@ -3631,7 +3888,8 @@ QString Session::findContactPhone(UserId contactId) const {
 bool Session::hasPendingWebPageGamePollNotification() const {
 	return !_webpagesUpdated.empty()
 		|| !_gamesUpdated.empty()
-		|| !_pollsUpdated.empty();
+		|| !_pollsUpdated.empty()
+		|| !_pollsRepaintOnly.empty();
 }
 
 void Session::notifyWebPageUpdateDelayed(not_null<WebPageData*> page) {
@@ -3658,6 +3916,14 @@ void Session::notifyPollUpdateDelayed(not_null<PollData*> poll) {
 	}
 }
 
+void Session::notifyPollRepaintDelayed(not_null<PollData*> poll) {
+	const auto invoke = !hasPendingWebPageGamePollNotification();
+	_pollsRepaintOnly.insert(poll);
+	if (invoke) {
+		crl::on_main(_session, [=] { sendWebPageGamePollNotifications(); });
+	}
+}
+
 void Session::sendWebPageGamePollNotifications() {
 	for (const auto &page : base::take(_webpagesUpdated)) {
 		_webpageUpdates.fire_copy(page);
@@ -3676,12 +3942,23 @@ void Session::sendWebPageGamePollNotifications() {
 		}
 	}
 	for (const auto &poll : base::take(_pollsUpdated)) {
+		_pollsRepaintOnly.remove(poll);
 		if (const auto i = _pollViews.find(poll); i != _pollViews.end()) {
 			for (const auto &view : i->second) {
 				requestViewResize(view);
 			}
 		}
 	}
+	// Results-only changes touch the vote counters and percentages,
+	// the block geometry stays, so a repaint is enough for them.
+	for (const auto &poll : base::take(_pollsRepaintOnly)) {
+		if (const auto i = _pollViews.find(poll); i != _pollViews.end()) {
+			for (const auto &view : i->second) {
+				view->itemDataChanged();
+				requestViewRepaint(view);
+			}
+		}
+	}
 }
 
 rpl::producer<not_null<WebPageData*>> Session::webPageUpdates() const {
@@ -3794,11 +4071,13 @@ void Session::refreshChatListEntry(Dialogs::Key key) {
 	if (!history) {
 		return;
 	}
+	const auto mask = _chatsFilters->membershipMask(history);
+	auto index = 0;
 	for (const auto &filter : _chatsFilters->list()) {
 		const auto id = filter.id();
 		const auto filterList = chatsFilters().chatsList(id);
 		auto event = ChatListEntryRefresh{ .key = key, .filterId = id };
-		if (filter.contains(history)) {
+		if (mask & (uint64(1) << index++)) {
 			event.existenceChanged = !entry->inChatList(id);
 			if (event.existenceChanged) {
 				entry->addToChatList(id, filterList);
@@ -14,6 +14,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_groups.h"
 #include "data/data_cloud_file.h"
 #include "data/data_notify_settings.h"
+#include "data/data_search_index.h"
 #include "history/history_location_manager.h"
 #include "base/timer.h"
 #include "base/flags.h"
@@ -62,6 +63,7 @@ class DocumentMedia;
 class PhotoMedia;
 class Stickers;
 class GroupCall;
+class RepliesList;
 
 class Session final {
 public:
@@ -80,6 +82,11 @@ public:
 	}
 
 	[[nodiscard]] QString nameSortKey(const QString &name) const;
+	[[nodiscard]] QString internNameWord(const QString &word);
+
+	[[nodiscard]] SearchIndex &searchIndex() {
+		return _searchIndex;
+	}
 
 	[[nodiscard]] Groups &groups() {
 		return _groups;
@@ -90,9 +97,7 @@ public:
 	[[nodiscard]] ChatFilters &chatsFilters() const {
 		return *_chatsFilters;
 	}
-	[[nodiscard]] ScheduledMessages &scheduledMessages() const {
-		return *_scheduledMessages;
-	}
+	[[nodiscard]] ScheduledMessages &scheduledMessages();
 	[[nodiscard]] SendActionManager &sendActionManager() const {
 		return *_sendActionManager;
 	}
@@ -111,13 +116,15 @@ public:
 	[[nodiscard]] Stickers &stickers() const {
 		return *_stickers;
 	}
-	[[nodiscard]] SponsoredMessages &sponsoredMessages() const {
-		return *_sponsoredMessages;
-	}
+	[[nodiscard]] SponsoredMessages &sponsoredMessages();
 	[[nodiscard]] Reactions &reactions() const {
 		return *_reactions;
 	}
 
+	[[nodiscard]] std::shared_ptr<RepliesList> repliesList(
+		not_null<History*> history,
+		MsgId rootId);
+
 	[[nodiscard]] MsgId nextNonHistoryEntryId() {
 		return ++_nonHistoryEntryId;
 	}
@@ -192,6 +199,10 @@ public:
 	void enumerateChannels(Fn<void(not_null<ChannelData*>)> action) const;
 	[[nodiscard]] UserData *userByPhone(const QString &phone) const;
 	[[nodiscard]] PeerData *peerByUsername(const QString &username) const;
+	void usernameChanged(
+		not_null<PeerData*> peer,
+		const QString &oldUsername,
+		const QString &newUsername);
 
 	[[nodiscard]] not_null<History*> history(PeerId peerId);
 	[[nodiscard]] History *historyLoaded(PeerId peerId) const;
@@ -285,6 +296,9 @@ public:
 		int from,
 		int till);
 
+	void registerReplyPreviewUsage(not_null<PhotoData*> photo);
+	void registerReplyPreviewUsage(not_null<DocumentData*> document);
+
 	void registerShownSpoiler(FullMsgId id);
 	void unregisterShownSpoiler(FullMsgId id);
 	void hideShownSpoilers();
@@ -353,6 +367,10 @@ public:
 	void registerMessageTTL(TimeId when, not_null<HistoryItem*> item);
 	void unregisterMessageTTL(TimeId when, not_null<HistoryItem*> item);
 
+	// Memory-budgeted eviction of parsed items for histories that were
+	// not shown recently, see checkItemsEviction(). Zero disables it.
+	void setItemsEvictionBudget(int itemsCount);
+
 	// Returns true if item found and it is not detached.
 	bool updateExistingMessage(const MTPDmessage &data);
 	void updateEditedMessage(const MTPMessage &data);
@@ -615,6 +633,7 @@ public:
 	void notifyWebPageUpdateDelayed(not_null<WebPageData*> page);
 	void notifyGameUpdateDelayed(not_null<GameData*> game);
 	void notifyPollUpdateDelayed(not_null<PollData*> poll);
+	void notifyPollRepaintDelayed(not_null<PollData*> poll);
 	[[nodiscard]] bool hasPendingWebPageGamePollNotification() const;
 	void sendWebPageGamePollNotifications();
 	[[nodiscard]] rpl::producer<not_null<WebPageData*>> webPageUpdates() const;
@@ -715,6 +734,11 @@ private:
 	void scheduleNextTTLs();
 	void checkTTLs();
 
+	void checkItemsEviction();
+	void checkReplyPreviewsCapacity();
+	int evictHistoryItems(not_null<History*> history);
+	[[nodiscard]] int materializedItemsCount() const;
+
 	int computeUnreadBadge(const Dialogs::UnreadState &state) const;
 	bool computeUnreadBadgeMuted(const Dialogs::UnreadState &state) const;
 
@@ -829,6 +853,7 @@ private:
 	void setWallpapers(const QVector<MTPWallPaper> &data, uint64 hash);
 
 	void checkPollsClosings();
+	void applyPendingPollResults();
 
 	const not_null<Main::Session*> _session;
 
@@ -881,6 +906,10 @@ private:
 	std::map<TimeId, base::flat_set<not_null<HistoryItem*>>> _ttlMessages;
 	base::Timer _ttlCheckTimer;
 
+	base::Timer _itemsEvictionTimer;
+	base::flat_map<not_null<History*>, int> _itemsEvictionIdle;
+	int _itemsEvictionBudget = 0;
+
 	std::unordered_map<MsgId, not_null<HistoryItem*>> _nonChannelMessages;
 
 	base::flat_map<uint64, FullMsgId> _messageByRandomId;
@@ -936,6 +965,7 @@ private:
 	base::flat_set<not_null<WebPageData*>> _webpagesUpdated;
 	base::flat_set<not_null<GameData*>> _gamesUpdated;
 	base::flat_set<not_null<PollData*>> _pollsUpdated;
+	base::flat_set<not_null<PollData*>> _pollsRepaintOnly;
 
 	rpl::event_stream<not_null<WebPageData*>> _webpageUpdates;
 	rpl::event_stream<not_null<ChannelData*>> _channelDifferenceTooLong;
@@ -944,6 +974,8 @@ private:
 
 	base::flat_multi_map<TimeId, not_null<PollData*>> _pollsClosings;
 	base::Timer _pollsClosingTimer;
+	base::flat_map<not_null<PollData*>, MTPPollResults> _pendingPollResults;
+	base::Timer _pendingPollResultsTimer;
 
 	base::flat_map<FolderId, std::unique_ptr<Folder>> _folders;
 
@@ -955,6 +987,12 @@ private:
 
 	base::flat_set<not_null<ViewElement*>> _heavyViewParts;
 
+	// Decoded reply previews, least recently used one is dropped
+	// through its owner when the total count exceeds the budget.
+	base::flat_map<not_null<PhotoData*>, uint64> _photoReplyPreviews;
+	base::flat_map<not_null<DocumentData*>, uint64> _documentReplyPreviews;
+	uint64 _replyPreviewsUsageIndex = 0;
+
 	base::flat_map<uint64, not_null<GroupCall*>> _groupCalls;
 	rpl::event_stream<InviteToCall> _invitesToCalls;
 	base::flat_map<uint64, base::flat_set<not_null<UserData*>>> _invitedToCallUsers;
@@ -974,6 +1012,14 @@ private:
 
 	std::unordered_map<PeerId, std::unique_ptr<PeerData>> _peers;
 
+	// Lowercase username -> peer, maintained from updateNameDelayed(),
+	// so that link resolution doesn't scan all the loaded peers.
+	base::flat_map<QString, not_null<PeerData*>> _peersByUsername;
+
+	// Shared storage for peer name index words, so thousands of peers
+	// with overlapping names / usernames don't each keep its own copy.
+	base::flat_set<QString> _internedNameWords;
+
 	MessageIdsList _mimeForwardIds;
 
 	using CredentialsWithGeneration = std::pair<
@@ -985,6 +1031,7 @@ private:
 	uint64 _wallpapersHash = 0;
 
 	Groups _groups;
+	SearchIndex _searchIndex;
 	const std::unique_ptr<ChatFilters> _chatsFilters;
 	std::unique_ptr<ScheduledMessages> _scheduledMessages;
 	const std::unique_ptr<CloudThemes> _cloudThemes;
@@ -996,6 +1043,11 @@ private:
 	std::unique_ptr<SponsoredMessages> _sponsoredMessages;
 	const std::unique_ptr<Reactions> _reactions;
 
+	base::flat_map<
+		std::pair<not_null<History*>, MsgId>,
+		std::weak_ptr<RepliesList>> _repliesLists;
+	std::vector<std::shared_ptr<RepliesList>> _recentRepliesLists;
+
 	MsgId _nonHistoryEntryId = ServerMaxMsgId.bare + ScheduledMsgIdsRange;
 
 	rpl::lifetime _lifetime;
@@ -238,6 +238,11 @@ void SponsoredMessages::clearItems(not_null<History*> history) {
 		entry.item.reset();
 	}
 	list.showedAll = false;
+	if (!TooEarlyForRequest(list.received)) {
+		// The cached entries can't be shown again without a re-request,
+		// so don't keep the texts of a closed chat in memory.
+		_data.erase(it);
+	}
 }
 
 const SponsoredMessages::Entry *SponsoredMessages::find(
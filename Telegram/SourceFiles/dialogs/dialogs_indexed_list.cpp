@@ -36,6 +36,29 @@ RowsByLetter IndexedList::addToEnd(Key key) {
 	return result;
 }
 
+void IndexedList::addToEndBulk(const std::vector<Key> &keys) {
+	auto main = std::vector<Key>();
+	auto byLetter = base::flat_map<QChar, std::vector<Key>>();
+	main.reserve(keys.size());
+	for (const auto &key : keys) {
+		if (_list.getRow(key)) {
+			continue;
+		}
+		main.push_back(key);
+		for (const auto &ch : key.entry()->chatListFirstLetters()) {
+			byLetter[ch].push_back(key);
+		}
+	}
+	_list.addToEndBulk(main);
+	for (const auto &[ch, letterKeys] : byLetter) {
+		auto j = _index.find(ch);
+		if (j == _index.cend()) {
+			j = _index.emplace(ch, _sortMode, _filterId).first;
+		}
+		j->second.addToEndBulk(letterKeys);
+	}
+}
+
 Row *IndexedList::addByName(Key key) {
 	if (const auto row = _list.getRow(key)) {
 		return row;
@@ -19,6 +19,7 @@ public:
 	IndexedList(SortMode sortMode, FilterId filterId = 0);
 
 	RowsByLetter addToEnd(Key key);
+	void addToEndBulk(const std::vector<Key> &keys);
 	Row *addByName(Key key);
 	void adjustByDate(const RowsByLetter &links);
 	void moveToTop(Key key);
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_search_from_controllers.h"
 #include "history/history.h"
 #include "history/history_item.h"
+#include "core/perf_trace.h"
 #include "core/shortcuts.h"
 #include "core/application.h"
 #include "ui/widgets/buttons.h"
@@ -129,13 +130,21 @@ InnerWidget::InnerWidget(
 
 	session().downloaderTaskFinished(
 	) | rpl::start_with_next([=] {
+		// A just loaded userpic may show up in any row.
+		++_rowPaintCacheEpoch;
 		update();
 	}, lifetime());
 
+	style::PaletteChanged(
+	) | rpl::start_with_next([=] {
+		++_rowPaintCacheEpoch;
+	}, lifetime());
+
 	Core::App().notifications().settingsChanged(
 	) | rpl::start_with_next([=](Window::Notifications::ChangeType change) {
 		if (change == Window::Notifications::ChangeType::CountMessages) {
 			// Folder rows change their unread badge with this setting.
+			++_rowPaintCacheEpoch;
 			update();
 		}
 	}, lifetime());
@@ -159,6 +168,20 @@ InnerWidget::InnerWidget(
 	session().data().sendActionManager().animationUpdated(
 	) | rpl::start_with_next([=](
 			const Data::SendActionManager::AnimationUpdate &update) {
+		// Every chat with actively typing users fires one of these per
+		// frame, so skip the rows scrolled out of the visible area.
+		if (_state == WidgetState::Default) {
+			const auto row = shownDialogs()->getRow(Key(update.history));
+			if (!row) {
+				return;
+			}
+			const auto top = dialogsOffset()
+				+ row->pos() * st::dialogsRowHeight;
+			if ((top + 2 * st::dialogsRowHeight <= _visibleTop)
+				|| (top - st::dialogsRowHeight >= _visibleBottom)) {
+				return;
+			}
+		}
 		const auto updateRect = Ui::RowPainter::sendActionAnimationRect(
 			update.left,
 			update.width,
@@ -207,6 +230,7 @@ InnerWidget::InnerWidget(
 			stopReorderPinned();
 		}
 		if (update.flags & Data::HistoryUpdate::Flag::ChatOccupied) {
+			++_rowPaintCacheEpoch;
 			this->update();
 			_updated.fire({});
 		}
@@ -219,6 +243,7 @@ InnerWidget::InnerWidget(
 		| UpdateFlag::IsContact
 	) | rpl::start_with_next([=](const Data::PeerUpdate &update) {
 		if (update.flags & (UpdateFlag::Name | UpdateFlag::Photo)) {
+			++_rowPaintCacheEpoch;
 			this->update();
 			_updated.fire({});
 		}
@@ -380,6 +405,7 @@ void InnerWidget::changeOpenedFolder(Data::Folder *folder) {
 }
 
 void InnerWidget::paintEvent(QPaintEvent *e) {
+	TRACE_SCOPE("Dialogs::InnerWidget::paintEvent");
 	Painter p(this);
 
 	const auto r = e->rect();
@@ -426,10 +452,9 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 				}
 				const auto isActive = (row->key() == active);
 				const auto isSelected = (row->key() == selected);
-				Ui::RowPainter::paint(
+				paintDialogRowCached(
 					p,
 					row,
-					_filterId,
 					fullWidth,
 					isActive,
 					isSelected,
@@ -651,6 +676,52 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 	}
 }
 
+void InnerWidget::paintDialogRowCached(
+		Painter &p,
+		not_null<Row*> row,
+		int fullWidth,
+		bool active,
+		bool selected,
+		crl::time ms) {
+	const auto history = row->history();
+	if (active || selected || !row->paintCacheable(history)) {
+		// Highlighted and animating rows change every frame,
+		// caching them would only waste the raster roundtrip.
+		Ui::RowPainter::paint(
+			p,
+			row,
+			_filterId,
+			fullWidth,
+			active,
+			selected,
+			ms);
+		return;
+	}
+	const auto ratio = cIntRetinaFactor();
+	auto &cache = row->paintCache();
+	if (cache.width != fullWidth
+		|| cache.ratio != ratio
+		|| cache.epoch != _rowPaintCacheEpoch) {
+		const auto size = QSize(fullWidth, st::dialogsRowHeight) * ratio;
+		if (cache.frame.size() != size) {
+			cache.frame = QImage(size, QImage::Format_ARGB32_Premultiplied);
+			cache.frame.setDevicePixelRatio(cRetinaFactor());
+		}
+		auto q = Painter(&cache.frame);
+		Ui::RowPainter::paint(q, row, _filterId, fullWidth, false, false, ms);
+		if (row->paintCacheable(history)) {
+			cache.width = fullWidth;
+			cache.ratio = ratio;
+			cache.epoch = _rowPaintCacheEpoch;
+		} else {
+			// Painting refreshed the corner badge state and could have
+			// started its animation, don't reuse the frame in that case.
+			cache.width = 0;
+		}
+	}
+	p.drawImage(0, 0, cache.frame);
+}
+
 void InnerWidget::paintCollapsedRows(Painter &p, QRect clip) const {
 	auto index = 0;
 	const auto rowHeight = st::dialogsImportantBarHeight;
@@ -939,6 +1010,7 @@ void InnerWidget::selectByMouse(QPoint globalPosition) {
 			setCursor((_selected || _collapsedSelected)
 				? style::cur_pointer
 				: style::cur_default);
+			preloadSelectedHistory();
 		}
 	} else if (_state == WidgetState::Filtered) {
 		auto wasSelected = isSelected();
@@ -968,6 +1040,7 @@ void InnerWidget::selectByMouse(QPoint globalPosition) {
 				updateSelectedRow();
 				_filteredSelected = filteredSelected;
 				updateSelectedRow();
+				preloadSelectedHistory();
 			}
 		}
 		if (!_peerSearchResults.empty()) {
@@ -1000,6 +1073,17 @@ void InnerWidget::selectByMouse(QPoint globalPosition) {
 	}
 }
 
+void InnerWidget::preloadSelectedHistory() {
+	const auto history = _selected
+		? _selected->history()
+		: base::in_range(_filteredSelected, 0, int(_filterResults.size()))
+		? _filterResults[_filteredSelected]->history()
+		: nullptr;
+	if (history) {
+		_controller->preloadHistory(history);
+	}
+}
+
 void InnerWidget::mousePressEvent(QMouseEvent *e) {
 	selectByMouse(e->globalPos());
 
@@ -1487,6 +1571,7 @@ int InnerWidget::defaultRowTop(not_null<Row*> row) const {
 void InnerWidget::repaintDialogRow(
 		FilterId filterId,
 		not_null<Row*> row) {
+	row->invalidatePaintCache();
 	if (_state == WidgetState::Default) {
 		if (_filterId == filterId) {
 			if (const auto folder = row->folder()) {
@@ -1572,6 +1657,7 @@ void InnerWidget::updateDialogRow(
 				repaintCollapsedFolderRow(folder);
 			}
 			if (const auto dialog = shownDialogs()->getRow(row.key)) {
+				dialog->invalidatePaintCache();
 				const auto position = dialog->pos();
 				auto top = dialogsOffset();
 				if (base::in_range(position, 0, _pinnedRows.size())) {
@@ -2109,6 +2195,31 @@ bool InnerWidget::searchReceived(
 	return lastDateFound != 0;
 }
 
+void InnerWidget::appendLocalSearchResults(
+		const std::vector<not_null<HistoryItem*>> &items) {
+	// Instant results from Data::SearchIndex, shown while the server
+	// search is in flight. The first server response clears and refills
+	// _searchResults, so nothing here needs to be deduplicated later.
+	auto appended = false;
+	for (const auto &item : items) {
+		const auto alreadyShown = ranges::any_of(
+			_searchResults,
+			[&](const std::unique_ptr<FakeRow> &row) {
+				return row->item() == item;
+			});
+		if (alreadyShown) {
+			continue;
+		}
+		_searchResults.push_back(
+			std::make_unique<FakeRow>(_searchInChat, item));
+		appended = true;
+	}
+	if (appended) {
+		accumulate_max(_searchedCount, int(_searchResults.size()));
+		refresh();
+	}
+}
+
 void InnerWidget::peerSearchReceived(
 		const QString &query,
 		const QVector<MTPPeer> &my,
@@ -2519,6 +2630,7 @@ void InnerWidget::selectSkip(int32 direction) {
 			});
 		}
 	}
+	preloadSelectedHistory();
 	update();
 }
 
@@ -2584,6 +2696,7 @@ void InnerWidget::selectSkipPage(int32 pixels, int32 direction) {
 	} else {
 		return selectSkip(direction * toSkip);
 	}
+	preloadSelectedHistory();
 	update();
 }
 
@@ -3065,6 +3178,7 @@ void InnerWidget::updateRowCornerStatusShown(
 	if (const auto &[row, top] = findRow(history); row != nullptr) {
 		const auto visible = (top < _visibleBottom)
 			&& (top + st::dialogsRowHeight > _visibleTop);
+		row->invalidatePaintCache();
 		row->updateCornerBadgeShown(
 			history->peer,
 			visible ? Fn<void()>(crl::guard(this, repaint)) : nullptr);
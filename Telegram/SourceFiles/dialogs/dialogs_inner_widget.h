@@ -77,6 +77,8 @@ public:
 		HistoryItem *inject,
 		SearchRequestType type,
 		int fullCount);
+	void appendLocalSearchResults(
+		const std::vector<not_null<HistoryItem*>> &items);
 	void peerSearchReceived(
 		const QString &query,
 		const QVector<MTPPeer> &my,
@@ -201,6 +203,7 @@ private:
 		Qt::KeyboardModifiers modifiers);
 	void clearIrrelevantState();
 	void selectByMouse(QPoint globalPosition);
+	void preloadSelectedHistory();
 	void loadPeerPhotos();
 	void setCollapsedPressed(int pressed);
 	void setPressed(Row *pressed);
@@ -275,6 +278,13 @@ private:
 	int searchedOffset() const;
 	int searchInChatSkip() const;
 
+	void paintDialogRowCached(
+		Painter &p,
+		not_null<Row*> row,
+		int fullWidth,
+		bool active,
+		bool selected,
+		crl::time ms);
 	void paintCollapsedRows(
 		Painter &p,
 		QRect clip) const;
@@ -336,6 +346,10 @@ private:
 
 	Data::Folder *_openedFolder = nullptr;
 
+	// Bumped by events that may change the look of many rows at once,
+	// so that every cached row raster re-renders on the next paint.
+	uint32 _rowPaintCacheEpoch = 1;
+
 	std::vector<std::unique_ptr<CollapsedRow>> _collapsedRows;
 	int _collapsedSelected = -1;
 	int _collapsedPressed = -1;
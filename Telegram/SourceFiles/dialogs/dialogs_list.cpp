@@ -40,6 +40,35 @@ not_null<Row*> List::addToEnd(Key key) {
 	return result;
 }
 
+void List::addToEndBulk(const std::vector<Key> &keys) {
+	// Bulk-build path: append everything once and sort once, instead of
+	// adjusting positions row by row N times.
+	_rows.reserve(_rows.size() + keys.size());
+	_rowByKey.reserve(_rowByKey.size() + keys.size());
+	for (const auto &key : keys) {
+		if (getRow(key)) {
+			continue;
+		}
+		const auto result = _rowByKey.emplace(
+			key,
+			std::make_unique<Row>(key, _rows.size())
+		).first->second.get();
+		_rows.emplace_back(result);
+	}
+	if (_sortMode == SortMode::Date) {
+		ranges::stable_sort(_rows, ranges::greater(), [&](Row *row) {
+			return row->sortKey(_filterId);
+		});
+	} else if (_sortMode == SortMode::Name) {
+		ranges::stable_sort(_rows, ranges::less(), [](Row *row) {
+			return row->entry()->chatListNameSortKey();
+		});
+	}
+	for (auto i = 0, count = int(_rows.size()); i != count; ++i) {
+		_rows[i]->_pos = i;
+	}
+}
+
 Row *List::adjustByName(Key key) {
 	Expects(_sortMode == SortMode::Name);
 
@@ -45,6 +45,7 @@ public:
 	}
 
 	not_null<Row*> addToEnd(Key key);
+	void addToEndBulk(const std::vector<Key> &keys);
 	Row *adjustByName(Key key);
 	not_null<Row*> addByName(Key key);
 	bool moveToTop(Key key);
@@ -80,7 +81,7 @@ private:
 	SortMode _sortMode = SortMode();
 	FilterId _filterId = 0;
 	std::vector<not_null<Row*>> _rows;
-	std::map<Key, std::unique_ptr<Row>> _rowByKey;
+	base::flat_map<Key, std::unique_ptr<Row>> _rowByKey;
 
 };
 
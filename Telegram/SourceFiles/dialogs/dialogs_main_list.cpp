@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_changes.h"
 #include "main/main_session.h"
 #include "history/history.h"
+#include "ui/ui_utility.h"
 
 namespace Dialogs {
 
@@ -193,6 +194,19 @@ rpl::producer<UnreadState> MainList::unreadStateChanges() const {
 	return _unreadStateChanges.events();
 }
 
+void MainList::notifyUnreadStateChangePostponed(
+		const UnreadState &wasState) {
+	if (_unreadStateChangePostponed) {
+		return;
+	}
+	_unreadStateChangePostponed = true;
+	_unreadStateChangeWas = wasState;
+	Ui::PostponeCall(this, [=] {
+		_unreadStateChangePostponed = false;
+		_unreadStateChanges.fire_copy(_unreadStateChangeWas);
+	});
+}
+
 not_null<IndexedList*> MainList::indexed() {
 	return &_all;
 }
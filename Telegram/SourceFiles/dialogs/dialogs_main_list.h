@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/weak_ptr.h"
 #include "dialogs/dialogs_indexed_list.h"
 #include "dialogs/dialogs_pinned_list.h"
 
@@ -16,7 +17,7 @@ class Session;
 
 namespace Dialogs {
 
-class MainList final {
+class MainList final : public base::has_weak_ptr {
 public:
 	MainList(
 		not_null<Main::Session*> session,
@@ -54,12 +55,17 @@ public:
 private:
 	void finalizeCloudUnread();
 	void recomputeFullListSize();
+	void notifyUnreadStateChangePostponed(const UnreadState &wasState);
 
+	// The state itself is updated right away, only the change
+	// notifications are merged within one event loop iteration, so
+	// that catching up a lot of unread changes at once recomputes
+	// the badges once and not per-message per-filter.
 	auto unreadStateChangeNotifier(bool notify) {
 		const auto wasState = notify ? unreadState() : UnreadState();
 		return gsl::finally([=] {
 			if (notify) {
-				_unreadStateChanges.fire_copy(wasState);
+				notifyUnreadStateChangePostponed(wasState);
 			}
 		});
 	}
@@ -69,12 +75,14 @@ private:
 	PinnedList _pinned;
 	UnreadState _unreadState;
 	UnreadState _cloudUnreadState;
+	UnreadState _unreadStateChangeWas;
 	rpl::event_stream<UnreadState> _unreadStateChanges;
 	rpl::variable<int> _fullListSize = 0;
 	int _cloudListSize = 0;
 
 	bool _loaded = false;
 	bool _allAreMuted = false;
+	bool _unreadStateChangePostponed = false;
 
 	rpl::lifetime _lifetime;
 
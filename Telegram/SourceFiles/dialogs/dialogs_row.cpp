@@ -144,6 +144,26 @@ void BasicRow::paintRipple(
 	}
 }
 
+bool BasicRow::paintCacheable(const History *history) const {
+	if (_ripple
+		|| (_cornerBadgeUserpic
+			&& _cornerBadgeUserpic->animation.animating())) {
+		return false;
+	} else if (history) {
+		if (_cornerBadgeShown && !history->peer->isUser()) {
+			// The speaking indicator on the call badge always animates.
+			return false;
+		} else if (history->sendActionPainter()->animating()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void BasicRow::invalidatePaintCache() const {
+	_paintCache.width = 0;
+}
+
 void BasicRow::updateCornerBadgeShown(
 		not_null<PeerData*> peer,
 		Fn<void()> updateCallback) const {
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "ui/text/text.h"
+#include "ui/text/cached_paint.h"
 #include "ui/effects/animations.h"
 #include "dialogs/dialogs_key.h"
 #include "dialogs/ui/dialogs_message_view.h"
@@ -62,6 +63,25 @@ public:
 		return _userpic;
 	}
 
+	[[nodiscard]] Ui::Text::CachedPaint &nameCache() const {
+		return _nameCache;
+	}
+
+	// Raster of the whole painted row, blitted on repeated repaints
+	// (scrolling) instead of re-running the full paint code. Valid only
+	// while the row shows no live animation and nothing invalidated it.
+	struct PaintCacheState {
+		QImage frame;
+		int width = 0;
+		int ratio = 0;
+		uint32 epoch = 0;
+	};
+	[[nodiscard]] PaintCacheState &paintCache() const {
+		return _paintCache;
+	}
+	[[nodiscard]] bool paintCacheable(const History *history) const;
+	void invalidatePaintCache() const;
+
 private:
 	struct CornerBadgeUserpic {
 		InMemoryKey key;
@@ -81,6 +101,8 @@ private:
 		std::shared_ptr<Data::CloudImageView> &view);
 
 	mutable std::shared_ptr<Data::CloudImageView> _userpic;
+	mutable Ui::Text::CachedPaint _nameCache;
+	mutable PaintCacheState _paintCache;
 	mutable std::unique_ptr<Ui::RippleAnimation> _ripple;
 	mutable std::unique_ptr<CornerBadgeUserpic> _cornerBadgeUserpic;
 	mutable bool _cornerBadgeShown = false;
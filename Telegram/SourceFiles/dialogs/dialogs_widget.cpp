@@ -925,6 +925,16 @@ bool Widget::searchMessages(bool searchCache) {
 		_searchNextRate = 0;
 		_searchFull = _searchFullMigrated = false;
 		cancelSearchRequest();
+		if (!_searchQueryFrom) { // The local index can't filter by author.
+			const auto localResults = session().data().searchIndex().search(
+				&session().data(),
+				_searchInChat.peer() ? _searchInChat.peer()->id : PeerId(),
+				_searchQuery,
+				SearchPerPage);
+			if (!localResults.empty()) {
+				_inner->appendLocalSearchResults(localResults);
+			}
+		}
 		if (const auto peer = _searchInChat.peer()) {
 			auto &histories = session().data().histories();
 			const auto type = Data::Histories::RequestType::History;
@@ -577,19 +577,31 @@ void paintRow(
 				badgeStyle);
 			rectForName.setWidth(rectForName.width() - badgeWidth);
 		}
-		p.setPen(active
+		const auto &color = active
 			? st::dialogsNameFgActive
 			: selected
 			? st::dialogsNameFgOver
-			: st::dialogsNameFg);
-		from->nameText().drawElided(p, rectForName.left(), rectForName.top(), rectForName.width());
+			: st::dialogsNameFg;
+		row->nameCache().drawElided(
+			p,
+			from->nameText(),
+			rectForName.left(),
+			rectForName.top(),
+			rectForName.width(),
+			color->c);
 	} else if (hiddenSenderInfo) {
-		p.setPen(active
+		const auto &color = active
 			? st::dialogsNameFgActive
 			: selected
 			? st::dialogsNameFgOver
-			: st::dialogsNameFg);
-		hiddenSenderInfo->nameText.drawElided(p, rectForName.left(), rectForName.top(), rectForName.width());
+			: st::dialogsNameFg;
+		row->nameCache().drawElided(
+			p,
+			hiddenSenderInfo->nameText,
+			rectForName.left(),
+			rectForName.top(),
+			rectForName.width(),
+			color->c);
 	} else {
 		p.setPen(active
 			? st::dialogsNameFgActive
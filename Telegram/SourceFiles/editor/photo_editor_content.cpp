@@ -12,12 +12,20 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_drag_area.h"
 #include "media/view/media_view_pip.h"
 #include "storage/storage_media_prepare.h"
+#include "ui/image/image_downscale.h"
+#include "ui/ui_utility.h"
 
 namespace Editor {
 
 using Media::View::FlipSizeByRotation;
 using Media::View::RotatedRect;
 
+namespace {
+
+constexpr auto kMaxPreviewSize = 2048;
+
+} // namespace
+
 PhotoEditorContent::PhotoEditorContent(
 	not_null<Ui::RpWidget*> parent,
 	std::shared_ptr<Image> photo,
@@ -90,10 +98,36 @@ PhotoEditorContent::PhotoEditorContent(
 
 		p.setTransform(_imageMatrix);
 
-		p.drawPixmap(_imageRect, _photo->pix(_imageRect.size()));
+		const auto &image = _preview ? _preview : _photo;
+		p.drawPixmap(_imageRect, image->pix(_imageRect.size()));
 	}, lifetime());
 
 	setupDragArea();
+	createPreviewProxy();
+}
+
+void PhotoEditorContent::createPreviewProxy() {
+	if ((_photoSize.width() <= kMaxPreviewSize)
+		&& (_photoSize.height() <= kMaxPreviewSize)) {
+		return;
+	}
+	// Rescaling a huge photo on the main thread for every rotation or
+	// flip makes the editor a slideshow, so the preview switches to a
+	// downscaled proxy and the full resolution is touched again only
+	// when the modifications are applied to the result.
+	const auto weak = Ui::MakeWeak(this);
+	crl::async([weak, photo = _photo] {
+		auto preview = std::make_shared<Image>(Images::SmoothDownscale(
+			photo->original(),
+			kMaxPreviewSize,
+			kMaxPreviewSize));
+		crl::on_main([weak, preview = std::move(preview)] {
+			if (weak) {
+				weak->_preview = preview;
+				weak->update();
+			}
+		});
+	});
 }
 
 void PhotoEditorContent::applyModifications(
@@ -38,11 +38,13 @@ public:
 	void setupDragArea();
 
 private:
+	void createPreviewProxy();
 
 	const QSize _photoSize;
 	const base::unique_qptr<Paint> _paint;
 	const base::unique_qptr<Crop> _crop;
 	const std::shared_ptr<Image> _photo;
+	std::shared_ptr<Image> _preview;
 
 	rpl::variable<PhotoModifications> _modifications;
 	rpl::event_stream<int> _keyPresses;
@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/value_ordering.h"
 #include "base/bytes.h"
 #include "base/random.h"
+#include <QtCore/QCryptographicHash>
 #include <set>
 #include <deque>
 
@@ -23,8 +24,7 @@ namespace {
 
 constexpr auto kUserpicsSliceLimit = 100;
 constexpr auto kFileChunkSize = 128 * 1024;
-constexpr auto kFileRequestsCount = 2;
-//constexpr auto kFileNextRequestDelay = crl::time(20);
+constexpr auto kFileRequestsCount = 4;
 constexpr auto kChatsSliceLimit = 100;
 constexpr auto kMessagesSliceLimit = 100;
 constexpr auto kTopPeerSliceLimit = 100;
@@ -97,10 +97,15 @@ public:
 	void save(const Location &location, const QString &relativePath);
 	std::optional<QString> find(const Location &location) const;
 
+	void saveContent(const QByteArray &digest, const QString &relativePath);
+	std::optional<QString> findContent(const QByteArray &digest) const;
+
 private:
 	int _limit = 0;
 	std::map<LocationKey, QString> _map;
 	std::deque<LocationKey> _list;
+	std::map<QByteArray, QString> _contentMap;
+	std::deque<QByteArray> _contentList;
 
 };
 
@@ -162,8 +167,16 @@ struct ApiWrap::FileProcess {
 	struct Request {
 		int offset = 0;
 		QByteArray bytes;
+		mtpRequestId requestId = 0;
 	};
 	std::deque<Request> requests;
+
+	// Content hash of all the written blocks, files with equal bytes
+	// are stored only once and share a single relative path.
+	QCryptographicHash digest{ QCryptographicHash::Sha256 };
+
+	// Used for the file reference refresh request only,
+	// chunk requests track their ids in the deque above.
 	mtpRequestId requestId = 0;
 };
 
@@ -322,6 +335,26 @@ std::optional<QString> ApiWrap::LoadedFileCache::find(
 	return std::nullopt;
 }
 
+void ApiWrap::LoadedFileCache::saveContent(
+		const QByteArray &digest,
+		const QString &relativePath) {
+	_contentMap[digest] = relativePath;
+	_contentList.push_back(digest);
+	if (_contentList.size() > _limit) {
+		const auto digest = _contentList.front();
+		_contentList.pop_front();
+		_contentMap.erase(digest);
+	}
+}
+
+std::optional<QString> ApiWrap::LoadedFileCache::findContent(
+		const QByteArray &digest) const {
+	if (const auto i = _contentMap.find(digest); i != end(_contentMap)) {
+		return i->second;
+	}
+	return std::nullopt;
+}
+
 ApiWrap::FileProcess::FileProcess(const QString &path, Output::Stats *stats)
 : file(path, stats) {
 }
@@ -366,7 +399,7 @@ auto ApiWrap::fileRequest(const Data::FileLocation &location, int offset) {
 			MTP_int(offset),
 			MTP_int(kFileChunkSize))
 	)).fail([=](const MTP::Error &result) {
-		_fileProcess->requestId = 0;
+		clearFilePartRequestId(offset);
 		if (result.type() == qstr("TAKEOUT_FILE_EMPTY")
 			&& _otherDataProcess != nullptr) {
 			filePartDone(
@@ -381,7 +414,7 @@ auto ApiWrap::fileRequest(const Data::FileLocation &location, int offset) {
 			filePartUnavailable();
 		} else if (result.code() == 400
 			&& result.type().startsWith(qstr("FILE_REFERENCE_"))) {
-			filePartRefreshReference(offset);
+			filePartRefreshReference();
 		} else {
 			error(std::move(result));
 		}
@@ -1042,8 +1075,14 @@ void ApiWrap::skipFile(uint64 randomId) {
 	}
 	LOG(("Export Info: File skipped."));
 	Assert(!_fileProcess->requests.empty());
-	Assert(_fileProcess->requestId != 0);
-	_mtp.request(base::take(_fileProcess->requestId)).cancel();
+	if (const auto requestId = base::take(_fileProcess->requestId)) {
+		_mtp.request(requestId).cancel();
+	}
+	for (auto &request : _fileProcess->requests) {
+		if (const auto requestId = base::take(request.requestId)) {
+			_mtp.request(requestId).cancel();
+		}
+	}
 	base::take(_fileProcess)->done(QString());
 }
 
@@ -1691,10 +1730,19 @@ bool ApiWrap::writePreloadedFile(
 		file.relativePath = *path;
 		return true;
 	} else if (!file.content.isEmpty()) {
+		const auto digest = QCryptographicHash::hash(
+			file.content,
+			QCryptographicHash::Sha256);
+		if (const auto path = _fileCache->findContent(digest)) {
+			file.relativePath = *path;
+			_fileCache->save(file.location, file.relativePath);
+			return true;
+		}
 		const auto process = prepareFileProcess(file, origin);
 		if (const auto result = process->file.writeBlock(file.content)) {
 			file.relativePath = process->relativePath;
 			_fileCache->save(file.location, file.relativePath);
+			_fileCache->saveContent(digest, file.relativePath);
 		} else {
 			ioError(result);
 		}
@@ -1728,7 +1776,7 @@ void ApiWrap::loadFile(
 
 	loadFilePart();
 
-	Ensures(_fileProcess->requestId != 0);
+	Ensures(!_fileProcess->requests.empty());
 }
 
 auto ApiWrap::prepareFileProcess(
@@ -1752,36 +1800,51 @@ auto ApiWrap::prepareFileProcess(
 }
 
 void ApiWrap::loadFilePart() {
-	if (!_fileProcess
-		|| _fileProcess->requestId
-		|| _fileProcess->requests.size() >= kFileRequestsCount
-		|| (_fileProcess->size > 0
-			&& _fileProcess->offset >= _fileProcess->size)) {
+	if (!_fileProcess || _fileProcess->requestId) {
+		// A file reference refresh is in progress, wait for it.
 		return;
 	}
 
-	const auto offset = _fileProcess->offset;
-	_fileProcess->requests.push_back({ offset });
-	_fileProcess->requestId = fileRequest(
-		_fileProcess->location,
-		_fileProcess->offset
-	).done([=](const MTPupload_File &result) {
-		_fileProcess->requestId = 0;
-		filePartDone(offset, result);
-	}).send();
-	_fileProcess->offset += kFileChunkSize;
-
-	if (_fileProcess->size > 0
-		&& _fileProcess->requests.size() < kFileRequestsCount) {
-		// Only one request at a time supported right now.
-		//const auto runner = _runner;
-		//crl::on_main([=] {
-		//	QTimer::singleShot(kFileNextRequestDelay, [=] {
-		//		runner([=] {
-		//			loadFilePart();
-		//		});
-		//	});
-		//});
+	const auto send = [&](FileProcess::Request &request) {
+		const auto offset = request.offset;
+		request.requestId = fileRequest(
+			_fileProcess->location,
+			offset
+		).done([=](const MTPupload_File &result) {
+			clearFilePartRequestId(offset);
+			filePartDone(offset, result);
+		}).send();
+	};
+
+	// First re-send the requests cancelled by a reference refresh.
+	for (auto &request : _fileProcess->requests) {
+		if (!request.requestId && request.bytes.isEmpty()) {
+			send(request);
+		}
+	}
+
+	// With unknown size we don't know where the file ends,
+	// so there the chunks are requested strictly one by one.
+	const auto limit = (_fileProcess->size > 0) ? kFileRequestsCount : 1;
+	while (int(_fileProcess->requests.size()) < limit
+		&& (!_fileProcess->size
+			|| _fileProcess->offset < _fileProcess->size)) {
+		_fileProcess->requests.push_back({ _fileProcess->offset });
+		send(_fileProcess->requests.back());
+		_fileProcess->offset += kFileChunkSize;
+	}
+}
+
+void ApiWrap::clearFilePartRequestId(int offset) {
+	Expects(_fileProcess != nullptr);
+
+	using Request = FileProcess::Request;
+	const auto i = ranges::find(
+		_fileProcess->requests,
+		offset,
+		&Request::offset);
+	if (i != end(_fileProcess->requests)) {
+		i->requestId = 0;
 	}
 }
 
@@ -1822,6 +1885,7 @@ void ApiWrap::filePartDone(int offset, const MTPupload_File &result) {
 				ioError(result);
 				return;
 			}
+			_fileProcess->digest.addData(bytes);
 			requests.pop_front();
 		}
 
@@ -1840,14 +1904,36 @@ void ApiWrap::filePartDone(int offset, const MTPupload_File &result) {
 	}
 
 	auto process = base::take(_fileProcess);
+	const auto digest = process->digest.result();
+	if (const auto path = _fileCache->findContent(digest)) {
+		// The very same bytes were already written for another file,
+		// point to the existing copy instead of keeping this one.
+		process->file.close();
+		QFile::remove(_settings->path + process->relativePath);
+		_fileCache->save(process->location, *path);
+		process->done(*path);
+		return;
+	}
 	const auto relativePath = process->relativePath;
 	_fileCache->save(process->location, relativePath);
+	_fileCache->saveContent(digest, relativePath);
 	process->done(process->relativePath);
 }
 
-void ApiWrap::filePartRefreshReference(int offset) {
+void ApiWrap::filePartRefreshReference() {
 	Expects(_fileProcess != nullptr);
-	Expects(_fileProcess->requestId == 0);
+
+	if (_fileProcess->requestId) {
+		// All the chunk requests in flight fail with the same expired
+		// reference, refresh it once and re-send them all afterwards.
+		return;
+	}
+	for (auto &request : _fileProcess->requests) {
+		if (request.requestId) {
+			_mtp.request(request.requestId).cancel();
+			request.requestId = 0;
+		}
+	}
 
 	const auto &origin = _fileProcess->origin;
 	if (!origin.messageId) {
@@ -1875,7 +1961,7 @@ void ApiWrap::filePartRefreshReference(int offset) {
 			return true;
 		}).done([=](const MTPmessages_Messages &result) {
 			_fileProcess->requestId = 0;
-			filePartExtractReference(offset, result);
+			filePartExtractReference(result);
 		}).send();
 	} else {
 		_fileProcess->requestId = splitRequest(
@@ -1891,14 +1977,12 @@ void ApiWrap::filePartRefreshReference(int offset) {
 			return true;
 		}).done([=](const MTPmessages_Messages &result) {
 			_fileProcess->requestId = 0;
-			filePartExtractReference(offset, result);
+			filePartExtractReference(result);
 		}).send();
 	}
 }
 
-void ApiWrap::filePartExtractReference(
-		int offset,
-		const MTPmessages_Messages &result) {
+void ApiWrap::filePartExtractReference(const MTPmessages_Messages &result) {
 	Expects(_fileProcess != nullptr);
 	Expects(_fileProcess->requestId == 0);
 
@@ -1924,13 +2008,9 @@ void ApiWrap::filePartExtractReference(
 					_fileProcess->location,
 					message.thumb().file.location);
 				if (refresh1 || refresh2) {
-					_fileProcess->requestId = fileRequest(
-						_fileProcess->location,
-						offset
-					).done([=](const MTPupload_File &result) {
-						_fileProcess->requestId = 0;
-						filePartDone(offset, result);
-					}).send();
+					// Re-sends all the chunk requests cancelled
+					// when the reference refresh started.
+					loadFilePart();
 					return;
 				}
 			}
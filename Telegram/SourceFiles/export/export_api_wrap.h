@@ -186,12 +186,11 @@ private:
 		Fn<bool(FileProgress)> progress,
 		FnMut<void(QString)> done);
 	void loadFilePart();
+	void clearFilePartRequestId(int offset);
 	void filePartDone(int offset, const MTPupload_File &result);
 	void filePartUnavailable();
-	void filePartRefreshReference(int offset);
-	void filePartExtractReference(
-		int offset,
-		const MTPmessages_Messages &result);
+	void filePartRefreshReference();
+	void filePartExtractReference(const MTPmessages_Messages &result);
 
 	template <typename Request>
 	class RequestBuilder;
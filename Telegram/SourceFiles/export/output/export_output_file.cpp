@@ -38,6 +38,10 @@ Result File::writeBlock(const QByteArray &block) {
 	return result;
 }
 
+void File::close() {
+	_file.reset();
+}
+
 Result File::writeBlockAttempt(const QByteArray &block) {
 	if (_stats && !_inStats) {
 		_inStats = true;
@@ -28,6 +28,10 @@ public:
 
 	[[nodiscard]] Result writeBlock(const QByteArray &block);
 
+	// Closes the underlying file handle, so that the written
+	// file can be removed or replaced right away on any platform.
+	void close();
+
 	[[nodiscard]] static QString PrepareRelativePath(
 		const QString &folder,
 		const QString &suggested);
@@ -40,9 +40,46 @@ struct HwAccelDescriptor {
 	AVPixelFormat format = AV_PIX_FMT_NONE;
 };
 
+// Aligned frame buffers are recycled between the decoder thread and the
+// presenter: when the last QImage wrapping a buffer is destroyed, the
+// memory goes back to the pool instead of the heap, so steady-state
+// playback does no per-frame allocations. Each buffer stores its full
+// allocation size in the first bytes, before the aligned image data.
+constexpr auto kMaxPooledFrameBuffers = 8;
+
+QMutex FrameBuffersMutex;
+std::vector<std::pair<int32, uchar*>> FrameBuffers;
+
+[[nodiscard]] uchar *TakeFrameBuffer(int32 totalSize) {
+	{
+		QMutexLocker lock(&FrameBuffersMutex);
+		for (auto i = begin(FrameBuffers); i != end(FrameBuffers); ++i) {
+			if (i->first == totalSize) {
+				const auto result = i->second;
+				FrameBuffers.erase(i);
+				return result;
+			}
+		}
+	}
+	return new uchar[totalSize];
+}
+
 void AlignedImageBufferCleanupHandler(void* data) {
 	const auto buffer = static_cast<uchar*>(data);
-	delete[] buffer;
+	auto totalSize = int32();
+	memcpy(&totalSize, buffer, sizeof(totalSize));
+
+	auto evicted = (uchar*)nullptr;
+	{
+		QMutexLocker lock(&FrameBuffersMutex);
+		if (FrameBuffers.size() >= kMaxPooledFrameBuffers) {
+			// Drop the oldest buffer so the pool adapts to size changes.
+			evicted = FrameBuffers.front().second;
+			FrameBuffers.erase(FrameBuffers.begin());
+		}
+		FrameBuffers.emplace_back(totalSize, buffer);
+	}
+	delete[] evicted;
 }
 
 [[nodiscard]] bool IsValidAspectRatio(AVRational aspect) {
@@ -481,10 +518,13 @@ QImage CreateFrameStorage(QSize size) {
 		? (widthAlign - (width % widthAlign))
 		: 0);
 	const auto perLine = neededWidth * kPixelBytesSize;
-	const auto buffer = new uchar[perLine * height + kAlignImageBy];
+	const auto totalSize = int32(perLine * height + 2 * kAlignImageBy);
+	const auto buffer = TakeFrameBuffer(totalSize);
+	memcpy(buffer, &totalSize, sizeof(totalSize));
 	const auto cleanupData = static_cast<void *>(buffer);
-	const auto address = reinterpret_cast<uintptr_t>(buffer);
-	const auto alignedBuffer = buffer + ((address % kAlignImageBy)
+	const auto withHeader = buffer + sizeof(totalSize);
+	const auto address = reinterpret_cast<uintptr_t>(withHeader);
+	const auto alignedBuffer = withHeader + ((address % kAlignImageBy)
 		? (kAlignImageBy - (address % kAlignImageBy))
 		: 0);
 	return QImage(
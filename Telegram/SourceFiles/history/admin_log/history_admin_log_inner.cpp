@@ -72,6 +72,11 @@ constexpr auto kEventsFirstPage = 20;
 constexpr auto kEventsPerPage = 50;
 constexpr auto kClearUserpicsAfter = 50;
 
+// Events kept in memory while paging through the log. The far side is
+// pruned and refetched through the usual paging on the way back, so a
+// long audit session stays flat in memory instead of growing unbounded.
+constexpr auto kMaxLoadedEvents = 600;
+
 } // namespace
 
 template <InnerWidget::EnumItemsDirection direction, typename Method>
@@ -789,6 +794,40 @@ void InnerWidget::preloadMore(Direction direction) {
 	}).send();
 }
 
+void InnerWidget::pruneOffscreenItems(Direction direction) {
+	// While paging in one direction drop the events on the far side of
+	// the viewport, they are refetched by the usual paging if the user
+	// scrolls back - the loaded flag of that side is reset below.
+	const auto up = (direction == Direction::Up);
+	const auto &requestId = up ? _preloadDownRequestId : _preloadUpRequestId;
+	if (_items.size() <= kMaxLoadedEvents || requestId != 0) {
+		return;
+	}
+	const auto count = int(_items.size()) - kMaxLoadedEvents;
+	const auto from = up ? begin(_items) : (end(_items) - count);
+	const auto till = up ? (begin(_items) + count) : end(_items);
+	for (auto i = from; i != till; ++i) {
+		const auto view = i->get();
+		if (view == _visibleTopItem
+			|| view == _scrollDateLastItem
+			|| view == _mouseActionItem
+			|| view == _selectedItem) {
+			return;
+		}
+	}
+	for (auto i = from; i != till; ++i) {
+		const auto data = i->get()->data();
+		_itemsByData.erase(data);
+		_itemDates.remove(data);
+		_eventIds.erase(i->eventId());
+	}
+	_items.erase(from, till);
+	(up ? _downLoaded : _upLoaded) = false;
+	if (!up && !_items.empty()) {
+		_items.back()->setDisplayDate(true);
+	}
+}
+
 void InnerWidget::addEvents(Direction direction, const QVector<MTPChannelAdminLogEvent> &events) {
 	if (_filterChanged) {
 		clearAfterFilterChange();
@@ -826,6 +865,7 @@ void InnerWidget::addEvents(Direction direction, const QVector<MTPChannelAdminLo
 			}
 			_eventIds.emplace(id);
 			_itemsByData.emplace(item->data(), item.get());
+			item.setEventId(id);
 			addToItems.push_back(std::move(item));
 			++count;
 		};
@@ -852,6 +892,7 @@ void InnerWidget::addEvents(Direction direction, const QVector<MTPChannelAdminLo
 			}
 			_items = std::move(newItemsForDownDirection);
 		}
+		pruneOffscreenItems(direction);
 		updateMinMaxIds();
 		itemsAdded(direction, newItemsCount - oldItemsCount);
 	}
@@ -217,6 +217,7 @@ private:
 	void checkPreloadMore();
 	void updateVisibleTopItem();
 	void preloadMore(Direction direction);
+	void pruneOffscreenItems(Direction direction);
 	void itemsAdded(Direction direction, int addedCount);
 	void updateSize();
 	void updateMinMaxIds();
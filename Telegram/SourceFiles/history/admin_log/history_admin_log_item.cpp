@@ -588,12 +588,14 @@ OwnedItem::OwnedItem(
 
 OwnedItem::OwnedItem(OwnedItem &&other)
 : _data(base::take(other._data))
-, _view(base::take(other._view)) {
+, _view(base::take(other._view))
+, _eventId(base::take(other._eventId)) {
 }
 
 OwnedItem &OwnedItem::operator=(OwnedItem &&other) {
 	_data = base::take(other._data);
 	_view = base::take(other._view);
+	_eventId = base::take(other._eventId);
 	return *this;
 }
 
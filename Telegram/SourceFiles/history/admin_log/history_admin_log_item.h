@@ -50,9 +50,17 @@ public:
 	void refreshView(not_null<HistoryView::ElementDelegate*> delegate);
 	void clearView();
 
+	void setEventId(uint64 eventId) {
+		_eventId = eventId;
+	}
+	[[nodiscard]] uint64 eventId() const {
+		return _eventId;
+	}
+
 private:
 	HistoryItem *_data = nullptr;
 	std::unique_ptr<HistoryView::Element> _view;
+	uint64 _eventId = 0;
 
 };
 
@@ -1853,50 +1853,19 @@ auto History::findScrollTopItem(int top) const -> Element* {
 		return nullptr;
 	}
 
-	auto itemIndex = 0;
-	auto blockIndex = 0;
-	auto itemTop = 0;
-	if (scrollTopItem) {
-		itemIndex = scrollTopItem->indexInBlock();
-		blockIndex = scrollTopItem->block()->indexInHistory();
-		itemTop = blocks[blockIndex]->y() + scrollTopItem->y();
-	}
-	if (itemTop > top) {
-		// go backward through history while we don't find an item that starts above
-		do {
-			const auto &block = blocks[blockIndex];
-			for (--itemIndex; itemIndex >= 0; --itemIndex) {
-				const auto view = block->messages[itemIndex].get();
-				itemTop = block->y() + view->y();
-				if (itemTop <= top) {
-					return view;
-				}
-			}
-			if (--blockIndex >= 0) {
-				itemIndex = blocks[blockIndex]->messages.size();
-			} else {
-				break;
-			}
-		} while (true);
-
-		return blocks.front()->messages.front().get();
-	}
-	// go forward through history while we don't find the last item that starts above
-	for (auto blocksCount = int(blocks.size()); blockIndex < blocksCount; ++blockIndex) {
-		const auto &block = blocks[blockIndex];
-		for (auto itemsCount = int(block->messages.size()); itemIndex < itemsCount; ++itemIndex) {
-			itemTop = block->y() + block->messages[itemIndex]->y();
-			if (itemTop > top) {
-				Assert(itemIndex > 0 || blockIndex > 0);
-				if (itemIndex > 0) {
-					return block->messages[itemIndex - 1].get();
-				}
-				return blocks[blockIndex - 1]->messages.back().get();
-			}
-		}
-		itemIndex = 0;
-	}
-	return blocks.back()->messages.back().get();
+	// Block and item y()-s are prefix sums of the heights above them,
+	// so the item containing the offset is a pair of binary searches,
+	// the old walk from the last position crawled on scrollbar jumps.
+	const auto lastStartingAbove = [](const auto &list, int y) {
+		const auto after = ranges::upper_bound(
+			list,
+			y,
+			ranges::less(),
+			[](const auto &entry) { return entry->y(); });
+		return ((after == begin(list)) ? after : (after - 1))->get();
+	};
+	const auto block = lastStartingAbove(blocks, top);
+	return lastStartingAbove(block->messages, top - block->y());
 }
 
 void History::getNextScrollTopItem(HistoryBlock *block, int32 i) {
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "core/file_utilities.h"
 #include "core/crash_reports.h"
+#include "core/perf_trace.h"
 #include "core/click_handler_types.h"
 #include "history/history.h"
 #include "history/history_message.h"
@@ -59,6 +60,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 #include "main/main_session_settings.h"
 #include "core/application.h"
+#include "core/animation_budget.h"
+#include "core/idle_tasks.h"
 #include "apiwrap.h"
 #include "api/api_attached_stickers.h"
 #include "api/api_toggling_media.h"
@@ -852,6 +855,7 @@ Ui::ChatPaintContext HistoryInner::preparePaintContext(
 }
 
 void HistoryInner::paintEvent(QPaintEvent *e) {
+	TRACE_SCOPE("HistoryInner::paintEvent");
 	if (Ui::skipPaintEvent(this, e)) {
 		return;
 	}
@@ -862,6 +866,12 @@ void HistoryInner::paintEvent(QPaintEvent *e) {
 		mouseActionUpdate();
 	}
 
+	const auto paintStarted = crl::now();
+	const auto budgetGuard = gsl::finally([&] {
+		Core::App().animationBudget().reportFrameTime(
+			crl::now() - paintStarted);
+	});
+
 	Painter p(this);
 	auto clip = e->rect();
 
@@ -1770,8 +1780,10 @@ void HistoryInner::mouseActionFinish(
 				repaintItem(_mouseActionItem);
 			}
 		} else {
+			for (const auto &[item, selection] : _selected) {
+				repaintItem(item);
+			}
 			_selected.clear();
-			update();
 		}
 	} else if (_mouseAction == MouseAction::Selecting) {
 		if (_dragSelFrom && _dragSelTo) {
@@ -2775,7 +2787,24 @@ void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 		_userpicsCache = std::move(_userpics);
 	}
 
-	// Unload lottie animations.
+	// Unload lottie animations once the scrolling settles down, the
+	// sweep walks all the views and should not compete with the frames.
+	if (!_heavyUnloadScheduled) {
+		_heavyUnloadScheduled = true;
+		Core::App().idleTasks().add(crl::guard(this, [=] {
+			_heavyUnloadScheduled = false;
+			unloadHeavyPartsOutsideVisibleArea();
+		}));
+	}
+	checkHistoryActivation();
+
+	_emojiInteractions->visibleAreaUpdated(
+		_visibleAreaTop - _historyPaddingTop,
+		_visibleAreaBottom - _historyPaddingTop);
+}
+
+void HistoryInner::unloadHeavyPartsOutsideVisibleArea() {
+	const auto visibleAreaHeight = _visibleAreaBottom - _visibleAreaTop;
 	const auto pages = kUnloadHeavyPartsPages;
 	const auto from = _visibleAreaTop - pages * visibleAreaHeight;
 	const auto till = _visibleAreaBottom + pages * visibleAreaHeight;
@@ -2786,11 +2815,6 @@ void HistoryInner::visibleAreaUpdated(int top, int bottom) {
 			from,
 			till);
 	}
-	checkHistoryActivation();
-
-	_emojiInteractions->visibleAreaUpdated(
-		_visibleAreaTop - _historyPaddingTop,
-		_visibleAreaBottom - _historyPaddingTop);
 }
 
 bool HistoryInner::displayScrollDate() const {
@@ -2966,30 +2990,15 @@ void HistoryInner::adjustCurrent(int32 y) const {
 void HistoryInner::adjustCurrent(int32 y, History *history) const {
 	Expects(!history->isEmpty());
 
+	// Block and item y()-s are prefix sums of the heights above them,
+	// so the binary search helper finds the containing pair directly,
+	// the old walk from the last position crawled on scrollbar jumps.
 	_curHistory = history;
-	if (_curBlock >= history->blocks.size()) {
-		_curBlock = history->blocks.size() - 1;
-		_curItem = 0;
-	}
-	while (history->blocks[_curBlock]->y() > y && _curBlock > 0) {
-		--_curBlock;
-		_curItem = 0;
-	}
-	while (history->blocks[_curBlock]->y() + history->blocks[_curBlock]->height() <= y && _curBlock + 1 < history->blocks.size()) {
-		++_curBlock;
-		_curItem = 0;
-	}
-	auto block = history->blocks[_curBlock].get();
-	if (_curItem >= block->messages.size()) {
-		_curItem = block->messages.size() - 1;
-	}
-	auto by = block->y();
-	while (block->messages[_curItem]->y() + by > y && _curItem > 0) {
-		--_curItem;
-	}
-	while (block->messages[_curItem]->y() + block->messages[_curItem]->height() + by <= y && _curItem + 1 < block->messages.size()) {
-		++_curItem;
-	}
+	_curBlock = BinarySearchBlocksOrItems<true>(history->blocks, y);
+	const auto block = history->blocks[_curBlock].get();
+	_curItem = BinarySearchBlocksOrItems<true>(
+		block->messages,
+		y - block->y());
 }
 
 auto HistoryInner::prevItem(Element *view) -> Element* {
@@ -3537,6 +3546,24 @@ void HistoryInner::updateDragSelection(Element *dragSelFrom, Element *dragSelTo,
 		updateDragSelection(nullptr, nullptr, false);
 		return;
 	}
+	// Repaint only the rows whose selection state may have changed,
+	// a plain update() here invalidated the whole viewport on every
+	// mouse move while drag-selecting.
+	const auto rangeOf = [&](Element *from, Element *to) {
+		if (!from || !to) {
+			return std::pair(-1, -1);
+		}
+		const auto fromy = itemTop(from);
+		const auto toy = itemTop(to);
+		if (fromy < 0 || toy < 0) {
+			return std::pair(0, height()); // Not visible, repaint all.
+		} else if (fromy > toy) {
+			return std::pair(toy, fromy + from->height());
+		}
+		return std::pair(fromy, toy + to->height());
+	};
+	const auto was = rangeOf(_dragSelFrom, _dragSelTo);
+
 	_dragSelFrom = dragSelFrom;
 	_dragSelTo = dragSelTo;
 	int32 fromy = itemTop(_dragSelFrom), toy = itemTop(_dragSelTo);
@@ -3548,7 +3575,17 @@ void HistoryInner::updateDragSelection(Element *dragSelFrom, Element *dragSelTo,
 		_wasSelectedText = true;
 		setFocus();
 	}
-	update();
+
+	const auto now = rangeOf(_dragSelFrom, _dragSelTo);
+	const auto repaintRange = [&](std::pair<int, int> range) {
+		if (range.first >= 0) {
+			update(0, range.first, width(), range.second - range.first);
+		}
+	};
+	repaintRange(was);
+	if (now != was) {
+		repaintRange(now);
+	}
 }
 
 int HistoryInner::historyHeight() const {
@@ -316,6 +316,8 @@ private:
 		not_null<const SelectedItems*> selected,
 		not_null<Element*> view) const;
 
+	void unloadHeavyPartsOutsideVisibleArea();
+
 	void toggleScrollDateShown();
 	void repaintScrollDateCallback();
 	bool displayScrollDate() const;
@@ -421,6 +423,7 @@ private:
 
 	const std::unique_ptr<Ui::PathShiftGradient> _pathGradient;
 	bool _isChatWide = false;
+	bool _heavyUnloadScheduled = false;
 
 	base::flat_set<not_null<const HistoryItem*>> _animatedStickersPlayed;
 	base::flat_map<
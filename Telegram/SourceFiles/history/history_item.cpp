@@ -14,6 +14,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/history_view_service_message.h"
 #include "history/view/media/history_view_media_grouped.h"
 #include "history/history_item_components.h"
+#include "history/history_item_pool.h"
 #include "history/history_service.h"
 #include "history/history_message.h"
 #include "history/history_unread_things.h"
@@ -245,6 +246,14 @@ void HistoryItem::HistoryItem::Destroyer::operator()(HistoryItem *value) {
 	}
 }
 
+void *HistoryItem::operator new(std::size_t size) {
+	return HistoryItemsPool::Allocate(size);
+}
+
+void HistoryItem::operator delete(void *pointer, std::size_t size) {
+	HistoryItemsPool::Free(pointer, size);
+}
+
 HistoryItem::HistoryItem(
 	not_null<History*> history,
 	MsgId id,
@@ -1225,15 +1234,26 @@ MessageGroupId HistoryItem::groupId() const {
 }
 
 bool HistoryItem::isEmpty() const {
-	return _text.isEmpty()
+	return emptyText()
 		&& !_media
 		&& !Has<HistoryMessageLogEntryOriginal>();
 }
 
+void HistoryItem::materializeText() const {
+	if (!_pendingText) {
+		return;
+	}
+	const auto that = const_cast<HistoryItem*>(this);
+	const auto pending = base::take(that->_pendingText);
+	that->applyMaterializedText(std::move(*pending));
+}
+
 TextWithEntities HistoryItem::notificationText() const {
 	const auto result = [&] {
 		if (_media && !isService()) {
 			return _media->notificationText();
+		} else if (_pendingText) {
+			return *_pendingText;
 		} else if (!emptyText()) {
 			return _text.toTextWithEntities();
 		}
@@ -1250,6 +1270,8 @@ ItemPreview HistoryItem::toPreview(ToPreviewOptions options) const {
 	auto result = [&]() -> ItemPreview {
 		if (_media) {
 			return _media->toPreview(options);
+		} else if (_pendingText) {
+			return { .text = *_pendingText };
 		} else if (!emptyText()) {
 			return {
 				.text = _text.toTextWithEntities()
@@ -87,6 +87,10 @@ public:
 		void operator()(HistoryItem *value);
 	};
 
+	// Items come out of contiguous slabs, see history_item_pool.h.
+	void *operator new(std::size_t size);
+	void operator delete(void *pointer, std::size_t size);
+
 	virtual void dependencyItemRemoved(HistoryItem *dependency) {
 	}
 	virtual bool updateDependencyItem() {
@@ -345,7 +349,9 @@ public:
 	}
 
 	[[nodiscard]] bool emptyText() const {
-		return _text.isEmpty();
+		return _pendingText
+			? _pendingText->text.isEmpty()
+			: _text.isEmpty();
 	}
 
 	[[nodiscard]] bool canPin() const;
@@ -455,6 +461,11 @@ protected:
 	void finishEdition(int oldKeyboardTop);
 	void finishEditionToEmpty();
 
+	// Lays out the text that was left raw at construction time.
+	void materializeText() const;
+	virtual void applyMaterializedText(TextWithEntities &&text) {
+	}
+
 	void setReactions(const MTPMessageReactions *reactions);
 	[[nodiscard]] bool changeReactions(const MTPMessageReactions *reactions);
 
@@ -470,9 +481,44 @@ protected:
 	void applyTTL(const MTPDmessageService &data);
 	void applyTTL(TimeId destroyAt);
 
+	// Memo of recent _text.countHeight() results. Two entries cover
+	// toggling between two widths (like showing / hiding the third
+	// column) without recounting layout for the whole history.
+	class TextHeightMemo {
+	public:
+		[[nodiscard]] int countFor(
+				const Ui::Text::String &text,
+				int width) {
+			if (_entries[0].width != width) {
+				if (_entries[1].width == width) {
+					std::swap(_entries[0], _entries[1]);
+				} else {
+					_entries[1] = _entries[0];
+					_entries[0] = { width, text.countHeight(width) };
+				}
+			}
+			return _entries[0].height;
+		}
+		void clear() {
+			_entries = {};
+		}
+
+	private:
+		struct Entry {
+			int width = -1;
+			int height = 0;
+		};
+		std::array<Entry, 2> _entries;
+
+	};
+
 	Ui::Text::String _text = { st::msgMinWidth };
-	int _textWidth = -1;
-	int _textHeight = 0;
+	TextHeightMemo _textHeights;
+
+	// Raw text of an item that was not displayed yet - the full layout
+	// waits for the first view or copy request, because most items from
+	// the server history slices are never shown at all.
+	std::unique_ptr<TextWithEntities> _pendingText;
 
 	struct SavedMediaData {
 		TextWithEntities text;
@@ -0,0 +1,90 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/history_item_pool.h"
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace HistoryItemsPool {
+namespace {
+
+constexpr auto kGranularity = std::size_t(16);
+constexpr auto kMaxPooledSize = std::size_t(1024);
+constexpr auto kSlabSize = std::size_t(64 * 1024);
+constexpr auto kBucketsCount = kMaxPooledSize / kGranularity;
+
+struct FreeNode {
+	FreeNode *next = nullptr;
+};
+
+struct Bucket {
+	FreeNode *free = nullptr;
+	char *slabPosition = nullptr;
+	char *slabEnd = nullptr;
+};
+
+std::vector<std::unique_ptr<char[]>> Slabs;
+Bucket Buckets[kBucketsCount];
+std::size_t Allocated = 0;
+std::size_t Reserved = 0;
+
+[[nodiscard]] std::size_t BucketIndex(std::size_t size) {
+	return (size + kGranularity - 1) / kGranularity - 1;
+}
+
+[[nodiscard]] void *AllocateFromBucket(Bucket &bucket, std::size_t chunk) {
+	if (const auto node = bucket.free) {
+		bucket.free = node->next;
+		return node;
+	}
+	if (std::size_t(bucket.slabEnd - bucket.slabPosition) < chunk) {
+		Slabs.push_back(std::make_unique<char[]>(kSlabSize));
+		bucket.slabPosition = Slabs.back().get();
+		bucket.slabEnd = bucket.slabPosition + kSlabSize;
+		Reserved += kSlabSize;
+	}
+	const auto result = bucket.slabPosition;
+	bucket.slabPosition += chunk;
+	return result;
+}
+
+} // namespace
+
+void *Allocate(std::size_t size) {
+	if (size > kMaxPooledSize) {
+		return ::operator new(size);
+	}
+	const auto index = BucketIndex(size);
+	const auto chunk = (index + 1) * kGranularity;
+	Allocated += chunk;
+	return AllocateFromBucket(Buckets[index], chunk);
+}
+
+void Free(void *pointer, std::size_t size) {
+	if (size > kMaxPooledSize) {
+		::operator delete(pointer);
+		return;
+	}
+	const auto index = BucketIndex(size);
+	Allocated -= (index + 1) * kGranularity;
+	const auto node = static_cast<FreeNode*>(pointer);
+	node->next = Buckets[index].free;
+	Buckets[index].free = node;
+}
+
+std::size_t AllocatedSize() {
+	return Allocated;
+}
+
+std::size_t ReservedSize() {
+	return Reserved;
+}
+
+} // namespace HistoryItemsPool
@@ -0,0 +1,28 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <cstddef>
+
+namespace HistoryItemsPool {
+
+// Slab allocator for HistoryItem-derived objects. Items are created and
+// destroyed in large bursts (history imports, clearing chats), so carving
+// them out of contiguous slabs instead of individual malloc calls avoids
+// heap fragmentation and keeps items that are scanned together close in
+// memory. Main thread only, like the items themselves.
+
+[[nodiscard]] void *Allocate(std::size_t size);
+void Free(void *pointer, std::size_t size);
+
+// Diagnostics for the debug log: bytes currently handed out and bytes
+// reserved in slabs.
+[[nodiscard]] std::size_t AllocatedSize();
+[[nodiscard]] std::size_t ReservedSize();
+
+} // namespace HistoryItemsPool
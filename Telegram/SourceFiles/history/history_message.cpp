@@ -323,13 +323,15 @@ HistoryMessage::HistoryMessage(
 	if (const auto media = data.vmedia()) {
 		setMedia(*media);
 	}
-	const auto textWithEntities = TextWithEntities{
+	auto textWithEntities = TextWithEntities{
 		qs(data.vmessage()),
 		Api::EntitiesFromMTP(
 			&history->session(),
 			data.ventities().value_or_empty())
 	};
-	setText(_media ? textWithEntities : EnsureNonEmpty(textWithEntities));
+	setDeferredText(_media
+		? std::move(textWithEntities)
+		: EnsureNonEmpty(textWithEntities));
 	if (const auto groupedId = data.vgrouped_id()) {
 		setGroupId(
 			MessageGroupId::FromRaw(history->peer->id, groupedId->v));
@@ -843,6 +845,9 @@ void HistoryMessage::setCommentsItemId(FullMsgId id) {
 }
 
 void HistoryMessage::hideSpoilers() {
+	if (_pendingText) {
+		return;
+	}
 	HistoryView::HideSpoilers(_text);
 }
 
@@ -1465,7 +1470,30 @@ TextWithEntities HistoryMessage::withLocalEntities(
 	return textWithEntities;
 }
 
+void HistoryMessage::setDeferredText(TextWithEntities &&textWithEntities) {
+	for (const auto &entity : textWithEntities.entities) {
+		auto type = entity.type();
+		if (type == EntityType::Url
+			|| type == EntityType::CustomUrl
+			|| type == EntityType::Email) {
+			_flags |= MessageFlag::HasTextLinks;
+			break;
+		}
+	}
+	if (_media && _media->consumeMessageText(textWithEntities)) {
+		setEmptyText();
+		return;
+	}
+	_pendingText = std::make_unique<TextWithEntities>(
+		std::move(textWithEntities));
+}
+
+void HistoryMessage::applyMaterializedText(TextWithEntities &&text) {
+	setText(text);
+}
+
 void HistoryMessage::setText(const TextWithEntities &textWithEntities) {
+	_pendingText = nullptr;
 	for (const auto &entity : textWithEntities.entities) {
 		auto type = entity.type();
 		if (type == EntityType::Url
@@ -1502,8 +1530,7 @@ void HistoryMessage::setText(const TextWithEntities &textWithEntities) {
 		checkIsolatedEmoji();
 	}
 
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights.clear();
 }
 
 void HistoryMessage::reapplyText() {
@@ -1512,14 +1539,14 @@ void HistoryMessage::reapplyText() {
 }
 
 void HistoryMessage::setEmptyText() {
+	_pendingText = nullptr;
 	clearIsolatedEmoji();
 	_text.setMarkedText(
 		st::messageTextStyle,
 		{ QString(), EntitiesInText() },
 		Ui::ItemTextOptions(this));
 
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights.clear();
 }
 
 void HistoryMessage::clearIsolatedEmoji() {
@@ -1582,12 +1609,15 @@ void HistoryMessage::setReplyMarkup(HistoryMessageMarkupData &&markup) {
 }
 
 Ui::Text::IsolatedEmoji HistoryMessage::isolatedEmoji() const {
+	materializeText();
 	return _text.toIsolatedEmoji();
 }
 
 TextWithEntities HistoryMessage::originalText() const {
 	if (emptyText()) {
 		return { QString(), EntitiesInText() };
+	} else if (_pendingText) {
+		return *_pendingText;
 	}
 	return _text.toTextWithEntities();
 }
@@ -1600,11 +1630,16 @@ TextForMimeData HistoryMessage::clipboardText() const {
 	if (emptyText()) {
 		return TextForMimeData();
 	}
+	materializeText();
 	return _text.toTextForMimeData();
 }
 
 bool HistoryMessage::textHasLinks() const {
-	return emptyText() ? false : _text.hasLinks();
+	if (emptyText()) {
+		return false;
+	}
+	materializeText();
+	return _text.hasLinks();
 }
 
 bool HistoryMessage::changeViewsCount(int count) {
@@ -1894,6 +1929,7 @@ QString HistoryMessage::notificationHeader() const {
 std::unique_ptr<HistoryView::Element> HistoryMessage::createView(
 		not_null<HistoryView::ElementDelegate*> delegate,
 		HistoryView::Element *replacing) {
+	materializeText();
 	return delegate->elementCreate(this, replacing);
 }
 
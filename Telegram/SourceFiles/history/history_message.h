@@ -224,6 +224,8 @@ public:
 	~HistoryMessage();
 
 private:
+	void setDeferredText(TextWithEntities &&textWithEntities);
+	void applyMaterializedText(TextWithEntities &&text) override;
 	void setEmptyText();
 	[[nodiscard]] bool isTooOldForEdit(TimeId now) const;
 	[[nodiscard]] bool isLegacyMessage() const {
@@ -1207,6 +1207,7 @@ TextWithEntities HistoryService::inReplyText() const {
 std::unique_ptr<HistoryView::Element> HistoryService::createView(
 		not_null<HistoryView::ElementDelegate*> delegate,
 		HistoryView::Element *replacing) {
+	materializeText();
 	return delegate->elementCreate(this, replacing);
 }
 
@@ -1219,18 +1220,37 @@ ClickHandlerPtr HistoryService::fromLink() const {
 }
 
 void HistoryService::setServiceText(const PreparedText &prepared) {
+	// Most service items from the server history slices are never
+	// shown, so until the first view the raw text waits in the pending
+	// buffer, like the regular message text. Once laid out the views
+	// read _text directly, so further updates apply eagerly.
+	if (_textMaterialized) {
+		layoutServiceText(prepared.text, prepared.links);
+	} else {
+		_pendingText = std::make_unique<TextWithEntities>(prepared.text);
+		_pendingTextLinks = prepared.links;
+	}
+	_textHeights.clear();
+}
+
+void HistoryService::applyMaterializedText(TextWithEntities &&text) {
+	_textMaterialized = true;
+	layoutServiceText(text, base::take(_pendingTextLinks));
+}
+
+void HistoryService::layoutServiceText(
+		const TextWithEntities &text,
+		const QList<ClickHandlerPtr> &links) {
 	_text.setMarkedText(
 		st::serviceTextStyle,
-		prepared.text,
+		text,
 		Ui::ItemTextServiceOptions());
 	HistoryView::FillTextWithAnimatedSpoilers(_text);
 	auto linkIndex = 0;
-	for (const auto &link : prepared.links) {
+	for (const auto &link : links) {
 		// Link indices start with 1.
 		_text.setLink(++linkIndex, link);
 	}
-	_textWidth = -1;
-	_textHeight = 0;
 }
 
 void HistoryService::hideSpoilers() {
@@ -1452,8 +1472,7 @@ void HistoryService::removeMedia() {
 	if (!_media) return;
 
 	_media.reset();
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights.clear();
 	history()->owner().requestItemResize(this);
 }
 
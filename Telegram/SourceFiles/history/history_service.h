@@ -153,6 +153,11 @@ private:
 	void updateText(PreparedText &&text);
 	void clearDependency();
 
+	void applyMaterializedText(TextWithEntities &&text) override;
+	void layoutServiceText(
+		const TextWithEntities &text,
+		const QList<ClickHandlerPtr> &links);
+
 	void createFromMtp(const MTPDmessage &message);
 	void createFromMtp(const MTPDmessageService &message);
 	void setMessageByAction(const MTPmessageAction &action);
@@ -170,6 +175,11 @@ private:
 	PreparedText prepareCallScheduledText(
 		TimeId scheduleDate);
 
+	// Links of the not yet laid out service text, attached to the text
+	// at materialization, see HistoryItem::_pendingText.
+	QList<ClickHandlerPtr> _pendingTextLinks;
+	bool _textMaterialized = false;
+
 	friend class HistoryView::Service;
 
 };
@@ -109,6 +109,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "lang/lang_keys.h"
 #include "mainwidget.h"
 #include "mainwindow.h"
+#include "storage/download_manager_mtproto.h"
 #include "storage/localimageloader.h"
 #include "storage/storage_account.h"
 #include "storage/file_upload.h"
@@ -142,6 +143,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "info/profile/info_profile_values.h" // SharedMediaCountValue.
 #include "chat_helpers/emoji_suggestions_widget.h"
 #include "core/crash_reports.h"
+#include "core/idle_tasks.h"
 #include "core/shortcuts.h"
 #include "support/support_common.h"
 #include "support/support_autocomplete.h"
@@ -164,6 +166,12 @@ namespace {
 
 constexpr auto kMessagesPerPageFirst = 30;
 constexpr auto kMessagesPerPage = 50;
+
+// When history preloads chain up faster than this the user is paging
+// through old history, so slices grow to the API maximum to cut round
+// trips, while a chat sitting at the bottom keeps the small slices.
+constexpr auto kMessagesPerPageFast = 100;
+constexpr auto kFastHistoryPreloadPeriod = 3 * crl::time(1000);
 constexpr auto kPreloadHeightsCount = 3; // when 3 screens to scroll left make a preload request
 constexpr auto kScrollToVoiceAfterScrolledMs = 1000;
 constexpr auto kSkipRepaintWhileScrollMs = 100;
@@ -2101,6 +2109,7 @@ void HistoryWidget::showHistory(
 		}
 
 		_history->showAtMsgId = _showAtMsgId;
+		saveScrollAnchor();
 
 		destroyUnreadBarOnClose();
 		_pinnedBar = nullptr;
@@ -2127,7 +2136,6 @@ void HistoryWidget::showHistory(
 	_replyEditMsg = nullptr;
 	_editMsgId = _replyToId = 0;
 	_previewData = nullptr;
-	_previewCache.clear();
 	_fieldBarCancel->hide();
 
 	_membersDropdownShowTimer.cancel();
@@ -2136,6 +2144,8 @@ void HistoryWidget::showHistory(
 	clearInlineBot();
 
 	_showAtMsgId = showAtMsgId;
+	_restoredScrollAnchorId = 0;
+	_restoredScrollAnchorOffset = 0;
 	_historyInited = false;
 	_contactStatus = nullptr;
 
@@ -2206,6 +2216,14 @@ void HistoryWidget::showHistory(
 		if (_showAtMsgId == ShowAtUnreadMsgId) {
 			if (_history->scrollTopItem) {
 				_showAtMsgId = _history->showAtMsgId;
+			} else if (!_history->unreadCount()) {
+				// Reopening a fully read chat - restore the viewport
+				// from the persisted anchor instead of scrolling to
+				// the end, it survives chat unloads and app restarts.
+				const auto anchor = session().settings().chatScrollAnchor(
+					_peer->id);
+				_restoredScrollAnchorId = anchor.msgId;
+				_restoredScrollAnchorOffset = anchor.offset;
 			}
 		} else {
 			_history->forgetScrollState();
@@ -2294,6 +2312,8 @@ void HistoryWidget::showHistory(
 			sponsored.request(_history);
 			_scroll->setTrackingContent(sponsored.canHaveFor(_history));
 		}
+
+		warmUpMediaDc();
 	} else {
 		_chooseForReport = nullptr;
 		refreshTopBarActiveChat();
@@ -2323,11 +2343,17 @@ void HistoryWidget::setHistory(History *history) {
 	}
 
 	const auto unloadHeavyViewParts = [](History *history) {
-		if (history) {
+		if (!history) {
+			return;
+		}
+		// The sweep walks all the views, let the section switch paint
+		// first and unload when the user goes idle.
+		const auto session = &history->session();
+		Core::App().idleTasks().add(crl::guard(session, [=] {
 			history->owner().unloadHeavyViewParts(
 				history->delegateMixin()->delegate());
 			history->forceFullResize();
-		}
+		}));
 	};
 
 	if (_history) {
@@ -3165,9 +3191,14 @@ void HistoryWidget::loadMessages() {
 
 	const auto offsetId = from->minMsgId();
 	const auto addOffset = 0;
-	const auto loadCount = offsetId
-		? kMessagesPerPage
-		: kMessagesPerPageFirst;
+	const auto now = crl::now();
+	const auto fast = (now - _lastHistoryPreload < kFastHistoryPreloadPeriod);
+	_lastHistoryPreload = now;
+	const auto loadCount = !offsetId
+		? kMessagesPerPageFirst
+		: fast
+		? kMessagesPerPageFast
+		: kMessagesPerPage;
 	const auto offsetDate = 0;
 	const auto maxId = 0;
 	const auto minId = 0;
@@ -3212,7 +3243,10 @@ void HistoryWidget::loadMessagesDown() {
 		return;
 	}
 
-	const auto loadCount = kMessagesPerPage;
+	const auto now = crl::now();
+	const auto fast = (now - _lastHistoryPreload < kFastHistoryPreloadPeriod);
+	_lastHistoryPreload = now;
+	const auto loadCount = fast ? kMessagesPerPageFast : kMessagesPerPage;
 	auto addOffset = -loadCount;
 	auto offsetId = from->maxMsgId();
 	if (!offsetId) {
@@ -4951,12 +4985,15 @@ bool HistoryWidget::confirmSendingFiles(
 		return false;
 	}
 
-	auto list = Storage::PrepareMediaFromImage(
+	Storage::PrepareMediaFromImageAsync(
 		std::move(image),
 		std::move(content),
-		st::sendMediaPreviewSize);
-	list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
-	return confirmSendingFiles(std::move(list), insertTextOnCancel);
+		st::sendMediaPreviewSize,
+		crl::guard(this, [=](Ui::PreparedList &&list) {
+			list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
+			confirmSendingFiles(std::move(list), insertTextOnCancel);
+		}));
+	return true;
 }
 
 bool HistoryWidget::canSendFiles(not_null<const QMimeData*> data) const {
@@ -4983,15 +5020,22 @@ bool HistoryWidget::confirmSendingFiles(
 	const auto hasImage = data->hasImage();
 
 	if (const auto urls = data->urls(); !urls.empty()) {
-		auto list = Storage::PrepareMediaList(
-			urls,
-			st::sendMediaPreviewSize);
+		auto list = Storage::ListMediaFiles(urls);
 		if (list.error != Ui::PreparedList::Error::NonLocalUrl) {
 			if (list.error == Ui::PreparedList::Error::None
 				|| !hasImage) {
 				const auto emptyTextOnCancel = QString();
 				list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
-				confirmSendingFiles(std::move(list), emptyTextOnCancel);
+				// Don't block the paste / drop on preview generation,
+				// reading and scaling the images may take a while.
+				Storage::PrepareDetailsAsync(
+					std::move(list),
+					st::sendMediaPreviewSize,
+					crl::guard(this, [=](Ui::PreparedList &&list) {
+						confirmSendingFiles(
+							std::move(list),
+							emptyTextOnCancel);
+					}));
 				return true;
 			}
 		}
@@ -5236,12 +5280,80 @@ int HistoryWidget::countInitialScrollTop() {
 		return ScrollMax;
 	} else if (const auto top = unreadBarTop()) {
 		return *top;
+	} else if (const auto top = restoredScrollAnchorTop()) {
+		return *top;
 	} else {
 		_history->calculateFirstUnreadMessage();
 		return countAutomaticScrollTop();
 	}
 }
 
+void HistoryWidget::saveScrollAnchor() {
+	if (!_peer) {
+		return;
+	}
+	const auto item = _history->scrollTopItem;
+	const auto id = (item && IsServerMsgId(item->data()->id))
+		? item->data()->id
+		: MsgId();
+	session().settings().setChatScrollAnchor(
+		_peer->id,
+		id,
+		id ? _history->scrollTopOffset : 0);
+	session().saveSettingsDelayed();
+}
+
+std::optional<int> HistoryWidget::restoredScrollAnchorTop() {
+	const auto msgId = base::take(_restoredScrollAnchorId);
+	const auto offset = base::take(_restoredScrollAnchorOffset);
+	if (!msgId) {
+		return std::nullopt;
+	}
+	// The anchored slice may have been unloaded since - in that case
+	// fall through to the automatic scroll position silently.
+	const auto item = getItemFromHistoryOrMigrated(msgId);
+	const auto top = _list->itemTop(item);
+	if (top < 0) {
+		return std::nullopt;
+	}
+	return std::max(top + offset, 0);
+}
+
+void HistoryWidget::warmUpMediaDc() {
+	Expects(_history != nullptr);
+
+	// Look through the most recent loaded messages - the ones shown
+	// first - and warm up the DC of the first undownloaded media found,
+	// so the transport is ready by the time the user taps it.
+	const auto limit = 30;
+	auto checked = 0;
+	for (const auto &block : ranges::views::reverse(_history->blocks)) {
+		for (const auto &view : ranges::views::reverse(block->messages)) {
+			const auto media = view->data()->media();
+			const auto dcId = [&]() -> int32 {
+				if (!media) {
+					return 0;
+				} else if (const auto document = media->document()) {
+					return (!document->loading()
+						&& !document->loadedInMediaCache()
+						&& document->filepath().isEmpty())
+						? document->getDC()
+						: 0;
+				} else if (const auto photo = media->photo()) {
+					return photo->loading() ? 0 : photo->getDC();
+				}
+				return 0;
+			}();
+			if (dcId) {
+				session().downloader().warmUpDc(dcId);
+				return;
+			} else if (++checked == limit) {
+				return;
+			}
+		}
+	}
+}
+
 void HistoryWidget::createUnreadBarIfBelowVisibleArea(int withScrollTop) {
 	Expects(_history != nullptr);
 
@@ -6921,8 +7033,8 @@ void HistoryWidget::checkPreview() {
 				previewCancel();
 			}
 		} else {
-			const auto i = _previewCache.constFind(links);
-			if (i == _previewCache.cend()) {
+			const auto cached = session().api().webPagePreviewCached(links);
+			if (!cached) {
 				_previewRequest = _api.request(MTPmessages_GetWebPagePreview(
 					MTP_flags(0),
 					MTP_string(links),
@@ -6930,8 +7042,8 @@ void HistoryWidget::checkPreview() {
 				)).done([=](const MTPMessageMedia &result, mtpRequestId requestId) {
 					gotPreview(links, result, requestId);
 				}).send();
-			} else if (i.value()) {
-				_previewData = session().data().webpage(i.value());
+			} else if (*cached) {
+				_previewData = session().data().webpage(*cached);
 				updatePreview();
 			} else if (_previewData && _previewData->pendingTill >= 0) {
 				previewCancel();
@@ -6966,7 +7078,7 @@ void HistoryWidget::gotPreview(
 	if (result.type() == mtpc_messageMediaWebPage) {
 		const auto &data = result.c_messageMediaWebPage().vwebpage();
 		const auto page = session().data().processWebpage(data);
-		_previewCache.insert(links, page->id);
+		session().api().cacheWebPagePreview(links, page->id);
 		if (page->pendingTill > 0
 			&& page->pendingTill <= base::unixtime::now()) {
 			page->pendingTill = -1;
@@ -6980,7 +7092,7 @@ void HistoryWidget::gotPreview(
 		}
 		session().data().sendWebPageGamePollNotifications();
 	} else if (result.type() == mtpc_messageMediaEmpty) {
-		_previewCache.insert(links, 0);
+		session().api().cacheWebPagePreview(links, 0);
 		if (links == _previewLinks
 			&& _previewState == Data::PreviewState::Allowed) {
 			_previewData = nullptr;
@@ -7718,6 +7830,7 @@ HistoryWidget::~HistoryWidget() {
 		// Saving a draft on account switching.
 		saveFieldToHistoryLocalDraft();
 		session().api().saveDraftToCloudDelayed(_history);
+		saveScrollAnchor();
 		setHistory(nullptr);
 
 		session().data().itemVisibilitiesUpdated();
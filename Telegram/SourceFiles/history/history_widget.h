@@ -563,6 +563,16 @@ private:
 	// Counts scrollTop for placing the scroll right at the unread
 	// messages bar, choosing from _history and _migrated unreadBar.
 	std::optional<int> unreadBarTop() const;
+
+	// Persisted per-chat viewport anchors, so that reopening a fully
+	// read chat restores the exact scroll position across restarts.
+	void saveScrollAnchor();
+	std::optional<int> restoredScrollAnchorTop();
+
+	// Predictively attach the DC of the nearest undownloaded media,
+	// so the first media tap doesn't pay transport setup latency.
+	void warmUpMediaDc();
+
 	int itemTopForHighlight(not_null<HistoryView::Element*> view) const;
 	void scrollToCurrentVoiceMessage(FullMsgId fromId, FullMsgId toId);
 
@@ -669,8 +679,6 @@ private:
 	QStringList _parsedLinks;
 	QString _previewLinks;
 	WebPageData *_previewData = nullptr;
-	typedef QMap<QString, WebPageId> PreviewCache;
-	PreviewCache _previewCache;
 	mtpRequestId _previewRequest = 0;
 	Ui::Text::String _previewTitle;
 	Ui::Text::String _previewDescription;
@@ -686,10 +694,13 @@ private:
 
 	bool _canSendMessages = false;
 	MsgId _showAtMsgId = ShowAtUnreadMsgId;
+	MsgId _restoredScrollAnchorId = 0;
+	int _restoredScrollAnchorOffset = 0;
 
 	int _firstLoadRequest = 0; // Not real mtpRequestId.
 	int _preloadRequest = 0; // Not real mtpRequestId.
 	int _preloadDownRequest = 0; // Not real mtpRequestId.
+	crl::time _lastHistoryPreload = 0;
 
 	MsgId _delayedShowAtMsgId = -1;
 	int _delayedShowAtRequest = 0; // Not real mtpRequestId.
@@ -2212,8 +2212,6 @@ void ComposeControls::initWebpageProcess() {
 	const auto parsedLinks = lifetime.make_state<QStringList>();
 	const auto previewLinks = lifetime.make_state<QString>();
 	const auto previewData = lifetime.make_state<WebPageData*>(nullptr);
-	using PreviewCache = std::map<QString, WebPageId>;
-	const auto previewCache = lifetime.make_state<PreviewCache>();
 	const auto previewRequest = lifetime.make_state<mtpRequestId>(0);
 	const auto mtpSender =
 		lifetime.make_state<MTP::Sender>(&_window->session().mtp());
@@ -2256,7 +2254,7 @@ void ComposeControls::initWebpageProcess() {
 		}
 		result.match([=](const MTPDmessageMediaWebPage &d) {
 			const auto page = _history->owner().processWebpage(d.vwebpage());
-			previewCache->insert({ links, page->id });
+			session().api().cacheWebPagePreview(links, page->id);
 			auto &till = page->pendingTill;
 			if (till > 0 && till <= base::unixtime::now()) {
 				till = -1;
@@ -2269,7 +2267,7 @@ void ComposeControls::initWebpageProcess() {
 				updatePreview();
 			}
 		}, [=](const MTPDmessageMediaEmpty &d) {
-			previewCache->insert({ links, 0 });
+			session().api().cacheWebPagePreview(links, 0);
 			if (links == *previewLinks
 				&& _previewState == Data::PreviewState::Allowed) {
 				*previewData = nullptr;
@@ -2316,11 +2314,12 @@ void ComposeControls::initWebpageProcess() {
 				_previewCancel();
 			}
 		} else {
-			const auto i = previewCache->find(*previewLinks);
-			if (i == previewCache->end()) {
+			const auto cached = session().api().webPagePreviewCached(
+				*previewLinks);
+			if (!cached) {
 				getWebPagePreview();
-			} else if (i->second) {
-				*previewData = _history->owner().webpage(i->second);
+			} else if (*cached) {
+				*previewData = _history->owner().webpage(*cached);
 				updatePreview();
 			} else if (ShowWebPagePreview(*previewData)) {
 				_previewCancel();
@@ -40,8 +40,39 @@ BottomInfo::BottomInfo(
 BottomInfo::~BottomInfo() = default;
 
 void BottomInfo::update(Data &&data, int availableWidth) {
+	// Most data change notifications touch only a part of the info,
+	// so only the layouts whose inputs differ are redone. Notably the
+	// reaction strip is kept unless the set or the counts changed -
+	// reaction-heavy channels update several times a second.
+	const auto flagsChanged = (_data.flags != data.flags);
+	const auto dateChanged = flagsChanged
+		|| (_data.date != data.date)
+		|| (_data.author != data.author);
+	const auto viewsChanged = flagsChanged || (_data.views != data.views);
+	const auto repliesChanged = flagsChanged
+		|| (_data.replies != data.replies);
+	const auto reactionsChanged = (_data.reactions != data.reactions)
+		|| (_data.chosenReaction != data.chosenReaction);
+	if (!dateChanged
+		&& !viewsChanged
+		&& !repliesChanged
+		&& !reactionsChanged) {
+		return;
+	}
 	_data = std::move(data);
-	layout();
+	if (dateChanged) {
+		layoutDateText();
+	}
+	if (viewsChanged) {
+		layoutViewsText();
+	}
+	if (repliesChanged) {
+		layoutRepliesText();
+	}
+	if (reactionsChanged) {
+		layoutReactionsText();
+	}
+	initDimensions();
 	if (width() > 0) {
 		resizeGetHeight(std::min(maxWidth(), availableWidth));
 	}
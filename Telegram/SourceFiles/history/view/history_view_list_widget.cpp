@@ -23,6 +23,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "chat_helpers/message_field.h"
 #include "mainwindow.h"
 #include "mainwidget.h"
+#include "core/application.h"
+#include "core/animation_budget.h"
 #include "core/click_handler_types.h"
 #include "apiwrap.h"
 #include "api/api_who_reacted.h"
@@ -1752,8 +1754,11 @@ void ListWidget::paintEvent(QPaintEvent *e) {
 		return;
 	}
 
+	const auto paintStarted = crl::now();
 	const auto guard = gsl::finally([&] {
 		_userpicsCache.clear();
+		Core::App().animationBudget().reportFrameTime(
+			crl::now() - paintStarted);
 	});
 
 	Painter p(this);
@@ -1158,8 +1158,9 @@ void Message::paintForwardedInfo(
 		const auto fits = (forwarded->text.maxWidth() + skip1 <= trect.width());
 		const auto skip = fits ? skip1 : skip2;
 		const auto useWidth = trect.width() - skip;
-		const auto countedHeight = forwarded->text.countHeight(useWidth);
-		const auto breakEverywhere = (countedHeight > 2 * serviceFont->height);
+		const auto breakEverywhere = forwardedBreakEverywhere(
+			forwarded,
+			useWidth);
 		p.setPen(!forwarded->psaType.isEmpty()
 			? st->boxTextFgGood()
 			: stm->msgServiceFg);
@@ -1380,6 +1381,17 @@ bool Message::showForwardsFromSender(
 		|| forwarded->imported;
 }
 
+bool Message::forwardedBreakEverywhere(
+		not_null<HistoryMessageForwarded*> forwarded,
+		int useWidth) const {
+	if (_forwardedBreakWidth != useWidth) {
+		_forwardedBreakWidth = useWidth;
+		_forwardedBreakEverywhere = (forwarded->text.countHeight(useWidth)
+			> 2 * st::msgServiceFont->height);
+	}
+	return _forwardedBreakEverywhere;
+}
+
 bool Message::hasFromPhoto() const {
 	if (isHidden()) {
 		return false;
@@ -1748,7 +1760,9 @@ bool Message::getStateForwardedInfo(
 				}
 			}
 			const auto useWidth = trect.width() - (fits ? skip1 : skip2);
-			const auto breakEverywhere = (forwarded->text.countHeight(useWidth) > 2 * st::semiboldFont->height);
+			const auto breakEverywhere = forwardedBreakEverywhere(
+				forwarded,
+				useWidth);
 			auto textRequest = request.forText();
 			if (breakEverywhere) {
 				textRequest.flags |= Ui::Text::StateRequest::Flag::BreakEverywhere;
@@ -2191,6 +2205,9 @@ void Message::refreshReactions() {
 }
 
 void Message::itemDataChanged() {
+	if (const auto media = this->media()) {
+		media->itemDataChanged();
+	}
 	const auto wasInfo = _bottomInfo.currentSize();
 	const auto wasReactions = _reactions
 		? _reactions->currentSize()
@@ -2916,11 +2933,7 @@ int Message::resizeContentGetHeight(int newWidth) {
 			}
 		} else {
 			if (hasVisibleText()) {
-				if (textWidth != item->_textWidth) {
-					item->_textWidth = textWidth;
-					item->_textHeight = item->_text.countHeight(textWidth);
-				}
-				newHeight = item->_textHeight;
+				newHeight = item->_textHeights.countFor(item->_text, textWidth);
 			} else {
 				newHeight = 0;
 			}
@@ -3060,12 +3073,10 @@ void Message::refreshInfoSkipBlock() {
 	}
 	if (!hasTextSkipBlock) {
 		if (item->_text.removeSkipBlock()) {
-			item->_textWidth = -1;
-			item->_textHeight = 0;
+			item->_textHeights.clear();
 		}
 	} else if (item->_text.updateSkipBlock(skipWidth, skipHeight)) {
-		item->_textWidth = -1;
-		item->_textHeight = 0;
+		item->_textHeights.clear();
 	}
 }
 
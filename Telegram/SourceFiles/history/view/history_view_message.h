@@ -153,6 +153,9 @@ private:
 
 	[[nodiscard]] bool showForwardsFromSender(
 		not_null<HistoryMessageForwarded*> forwarded) const;
+	[[nodiscard]] bool forwardedBreakEverywhere(
+		not_null<HistoryMessageForwarded*> forwarded,
+		int useWidth) const;
 	[[nodiscard]] TextSelection skipTextSelection(
 		TextSelection selection) const;
 	[[nodiscard]] TextSelection unskipTextSelection(
@@ -254,6 +257,11 @@ private:
 	Ui::Text::String _rightBadge;
 	int _bubbleWidthLimit = 0;
 
+	// Counting the height of the forwarded info is a full layout pass,
+	// so the two-lines-elided check is cached here by the used width.
+	mutable int _forwardedBreakWidth = 0;
+	mutable bool _forwardedBreakEverywhere = false;
+
 	BottomInfo _bottomInfo;
 
 };
@@ -22,8 +22,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace HistoryView {
 namespace{
 
-constexpr auto kLoadedLimit = 5;
-constexpr auto kChangeViewerLimit = 2;
+// A wide window of ids is kept materialized around the tracked message,
+// ids are cheap and clicking through a long list of pinned messages can
+// then navigate the already loaded index instead of refetching a tiny
+// slice every couple of steps, with the refetch starting a few steps
+// before the loaded edge so the next click doesn't wait for it.
+constexpr auto kLoadedLimit = 50;
+constexpr auto kChangeViewerLimit = 4;
 
 } // namespace
 
@@ -664,15 +664,22 @@ bool RepliesWidget::confirmSendingFiles(
 	const auto hasImage = data->hasImage();
 
 	if (const auto urls = data->urls(); !urls.empty()) {
-		auto list = Storage::PrepareMediaList(
-			urls,
-			st::sendMediaPreviewSize);
+		auto list = Storage::ListMediaFiles(urls);
 		if (list.error != Ui::PreparedList::Error::NonLocalUrl) {
 			if (list.error == Ui::PreparedList::Error::None
 				|| !hasImage) {
 				const auto emptyTextOnCancel = QString();
 				list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
-				confirmSendingFiles(std::move(list), emptyTextOnCancel);
+				// Don't block the paste / drop on preview generation,
+				// reading and scaling the images may take a while.
+				Storage::PrepareDetailsAsync(
+					std::move(list),
+					st::sendMediaPreviewSize,
+					crl::guard(this, [=](Ui::PreparedList &&list) {
+						confirmSendingFiles(
+							std::move(list),
+							emptyTextOnCancel);
+					}));
 				return true;
 			}
 		}
@@ -783,12 +790,15 @@ bool RepliesWidget::confirmSendingFiles(
 		return false;
 	}
 
-	auto list = Storage::PrepareMediaFromImage(
+	Storage::PrepareMediaFromImageAsync(
 		std::move(image),
 		std::move(content),
-		st::sendMediaPreviewSize);
-	list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
-	return confirmSendingFiles(std::move(list), insertTextOnCancel);
+		st::sendMediaPreviewSize,
+		crl::guard(this, [=](Ui::PreparedList &&list) {
+			list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
+			confirmSendingFiles(std::move(list), insertTextOnCancel);
+		}));
+	return true;
 }
 
 bool RepliesWidget::showSlowmodeError() {
@@ -1558,7 +1568,7 @@ void RepliesWidget::restoreState(not_null<RepliesMemento*> memento) {
 	if (auto replies = memento->getReplies()) {
 		setReplies(std::move(replies));
 	} else if (!_replies) {
-		setReplies(std::make_shared<Data::RepliesList>(_history, _rootId));
+		setReplies(_history->owner().repliesList(_history, _rootId));
 	}
 	restoreReplyReturns(memento->replyReturns());
 	_inner->restoreState(memento->list());
@@ -347,15 +347,22 @@ bool ScheduledWidget::confirmSendingFiles(
 	const auto hasImage = data->hasImage();
 
 	if (const auto urls = data->urls(); !urls.empty()) {
-		auto list = Storage::PrepareMediaList(
-			urls,
-			st::sendMediaPreviewSize);
+		auto list = Storage::ListMediaFiles(urls);
 		if (list.error != Ui::PreparedList::Error::NonLocalUrl) {
 			if (list.error == Ui::PreparedList::Error::None
 				|| !hasImage) {
 				const auto emptyTextOnCancel = QString();
 				list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
-				confirmSendingFiles(std::move(list), emptyTextOnCancel);
+				// Don't block the paste / drop on preview generation,
+				// reading and scaling the images may take a while.
+				Storage::PrepareDetailsAsync(
+					std::move(list),
+					st::sendMediaPreviewSize,
+					crl::guard(this, [=](Ui::PreparedList &&list) {
+						confirmSendingFiles(
+							std::move(list),
+							emptyTextOnCancel);
+					}));
 				return true;
 			}
 		}
@@ -461,12 +468,15 @@ bool ScheduledWidget::confirmSendingFiles(
 		return false;
 	}
 
-	auto list = Storage::PrepareMediaFromImage(
+	Storage::PrepareMediaFromImageAsync(
 		std::move(image),
 		std::move(content),
-		st::sendMediaPreviewSize);
-	list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
-	return confirmSendingFiles(std::move(list), insertTextOnCancel);
+		st::sendMediaPreviewSize,
+		crl::guard(this, [=](Ui::PreparedList &&list) {
+			list.overrideSendImagesAsPhotos = overrideSendImagesAsPhotos;
+			confirmSendingFiles(std::move(list), insertTextOnCancel);
+		}));
+	return true;
 }
 
 void ScheduledWidget::uploadFile(
@@ -42,6 +42,9 @@ public:
 		int outerWidth,
 		style::color color,
 		crl::time now);
+	[[nodiscard]] bool animating() const {
+		return bool(_sendActionAnimation) || bool(_speakingAnimation);
+	}
 
 	bool updateNeedsAnimating(
 		crl::time now,
@@ -419,7 +419,7 @@ QSize Service::performCountCurrentSize(int newWidth) {
 	const auto media = this->media();
 
 	if (item->_text.isEmpty()) {
-		item->_textHeight = 0;
+		item->_textHeights.clear();
 	} else {
 		auto contentWidth = newWidth;
 		if (delegate()->elementIsChatWide()) {
@@ -431,14 +431,13 @@ QSize Service::performCountCurrentSize(int newWidth) {
 		}
 
 		auto nwidth = qMax(contentWidth - st::msgServicePadding.left() - st::msgServicePadding.right(), 0);
-		if (nwidth != item->_textWidth) {
-			item->_textWidth = nwidth;
-			item->_textHeight = item->_text.countHeight(nwidth);
-		}
+		const auto textHeight = item->_textHeights.countFor(
+			item->_text,
+			nwidth);
 		if (contentWidth >= maxWidth()) {
 			newHeight += minHeight();
 		} else {
-			newHeight += item->_textHeight;
+			newHeight += textHeight;
 		}
 		newHeight += st::msgServicePadding.top() + st::msgServicePadding.bottom() + st::msgServiceMargin.top() + st::msgServiceMargin.bottom();
 		if (media) {
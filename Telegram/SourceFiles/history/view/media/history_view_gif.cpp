@@ -27,6 +27,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/media/history_view_sticker.h"
 #include "window/window_session_controller.h"
 #include "core/application.h" // Application::showDocument.
+#include "core/animation_budget.h"
 #include "ui/chat/chat_style.h"
 #include "ui/image/image.h"
 #include "ui/text/format_values.h"
@@ -263,10 +264,17 @@ bool Gif::downloadInCorner() const {
 }
 
 bool Gif::autoplayEnabled() const {
-	return Data::AutoDownload::ShouldAutoPlay(
-		_data->session().settings().autoDownload(),
-		_realParent->history()->peer,
-		_data);
+	// Asked several times per paint, so the decision is memoized
+	// against the auto-download settings version.
+	const auto &settings = _data->session().settings().autoDownload();
+	if (_autoplayVersion != settings.version()) {
+		_autoplayVersion = settings.version();
+		_autoplayEnabled = Data::AutoDownload::ShouldAutoPlay(
+			settings,
+			_realParent->history()->peer,
+			_data);
+	}
+	return _autoplayEnabled;
 }
 
 void Gif::draw(Painter &p, const PaintContext &context) const {
@@ -281,7 +289,10 @@ void Gif::draw(Painter &p, const PaintContext &context) const {
 	const auto st = context.st;
 	const auto sti = context.imageStyle();
 	const auto stm = context.messageStyle();
-	const auto autoPaused = _parent->delegate()->elementIsGifPaused();
+	const auto autoPaused = _parent->delegate()->elementIsGifPaused()
+		|| Core::App().animationBudget().demoted(
+			QRect(0, 0, width(), height()),
+			context.viewport);
 	const auto cornerDownload = downloadInCorner();
 	const auto canBePlayed = _dataMedia->canBePlayed(_realParent);
 	const auto autoplay = autoplayEnabled()
@@ -1009,7 +1020,8 @@ void Gif::drawGrouped(
 		|| _data->displayLoading();
 	const auto st = context.st;
 	const auto sti = context.imageStyle();
-	const auto autoPaused = _parent->delegate()->elementIsGifPaused();
+	const auto autoPaused = _parent->delegate()->elementIsGifPaused()
+		|| Core::App().animationBudget().demoted(geometry, context.viewport);
 	const auto fullFeatured = fullFeaturedGrouped(sides);
 	const auto cornerDownload = fullFeatured && downloadInCorner();
 	const auto canBePlayed = _dataMedia->canBePlayed(_realParent);
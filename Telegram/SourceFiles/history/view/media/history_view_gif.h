@@ -197,6 +197,8 @@ private:
 
 	QString _downloadSize;
 	mutable bool _stickerOncePlayed = false;
+	mutable int _autoplayVersion = -1;
+	mutable bool _autoplayEnabled = false;
 
 };
 
@@ -84,6 +84,10 @@ public:
 	[[nodiscard]] virtual bool isDisplayed() const;
 	virtual void updateNeedBubbleState() {
 	}
+	// Lightweight refresh of the displayed values for data changes
+	// that keep the geometry, invoked instead of a full resize.
+	virtual void itemDataChanged() {
+	}
 	[[nodiscard]] virtual bool hasTextForCopy() const {
 		return false;
 	}
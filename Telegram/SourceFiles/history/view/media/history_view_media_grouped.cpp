@@ -125,7 +125,8 @@ QSize GroupedMedia::countOptimalSize() {
 	}
 
 	const auto layout = (_mode == Mode::Grid)
-		? Ui::LayoutMediaGroup(
+		? history()->owner().groups().mosaicLayout(
+			_parent->data(),
 			sizes,
 			st::historyGroupWidthMax,
 			st::historyGroupWidthMin,
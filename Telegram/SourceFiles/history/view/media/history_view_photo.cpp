@@ -30,6 +30,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_file_origin.h"
 #include "data/data_auto_download.h"
 #include "core/application.h"
+#include "core/animation_budget.h"
 #include "styles/style_chat.h"
 
 namespace HistoryView {
@@ -376,7 +377,10 @@ void Photo::paintUserpicFrame(
 	if (_streamed
 		&& _streamed->instance.player().ready()
 		&& !_streamed->instance.player().videoSize().isEmpty()) {
-		const auto paused = _parent->delegate()->elementIsGifPaused();
+		const auto paused = _parent->delegate()->elementIsGifPaused()
+			|| Core::App().animationBudget().demoted(
+				rect,
+				context.viewport);
 		auto request = ::Media::Streaming::FrameRequest();
 		request.outer = size * cIntRetinaFactor();
 		request.resize = size * cIntRetinaFactor();
@@ -821,10 +825,17 @@ void Photo::checkStreamedIsStarted() const {
 }
 
 bool Photo::videoAutoplayEnabled() const {
-	return Data::AutoDownload::ShouldAutoPlay(
-		_data->session().settings().autoDownload(),
-		_realParent->history()->peer,
-		_data);
+	// Asked several times per paint, so the decision is memoized
+	// against the auto-download settings version.
+	const auto &settings = _data->session().settings().autoDownload();
+	if (_autoplayVersion != settings.version()) {
+		_autoplayVersion = settings.version();
+		_autoplayEnabled = Data::AutoDownload::ShouldAutoPlay(
+			settings,
+			_realParent->history()->peer,
+			_data);
+	}
+	return _autoplayEnabled;
 }
 
 TextForMimeData Photo::selectedText(TextSelection selection) const {
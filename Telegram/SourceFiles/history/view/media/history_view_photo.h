@@ -142,6 +142,8 @@ private:
 	Ui::Text::String _caption;
 	mutable std::shared_ptr<Data::PhotoMedia> _dataMedia;
 	mutable std::unique_ptr<Streamed> _streamed;
+	mutable int _autoplayVersion = -1;
+	mutable bool _autoplayEnabled = false;
 
 };
 
@@ -1502,6 +1502,12 @@ void Poll::unloadHeavyPart() {
 	}
 }
 
+void Poll::itemDataChanged() {
+	// Results-only updates keep the question and the answer texts, so
+	// the geometry holds and refreshing the displayed values is enough.
+	updateTexts();
+}
+
 bool Poll::hasHeavyPart() const {
 	for (auto &recent : _recentVoters) {
 		if (recent.userpic) {
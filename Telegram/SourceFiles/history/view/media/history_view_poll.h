@@ -67,6 +67,8 @@ public:
 	void unloadHeavyPart() override;
 	bool hasHeavyPart() const override;
 
+	void itemDataChanged() override;
+
 private:
 	struct AnswerAnimation;
 	struct AnswersAnimation;
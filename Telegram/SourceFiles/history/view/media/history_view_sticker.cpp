@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/effects/path_shift_gradient.h"
 #include "ui/emoji_config.h"
 #include "core/application.h"
+#include "core/animation_budget.h"
 #include "core/core_settings.h"
 #include "core/click_handler_types.h"
 #include "main/main_session.h"
@@ -189,7 +190,8 @@ void Sticker::paintLottie(
 		return;
 	}
 
-	const auto paused = _parent->delegate()->elementIsGifPaused();
+	const auto paused = _parent->delegate()->elementIsGifPaused()
+		|| Core::App().animationBudget().demoted(r, context.viewport);
 	const auto playOnce = (_diceIndex > 0)
 		? true
 		: (_diceIndex == 0)
@@ -320,14 +320,22 @@ void ListSection::resizeToWidth(int newWidth) {
 		return;
 	}
 
+	// The layouts are cached in the provider and survive the section
+	// rebuilds on each new slice, so the ones already laid out for
+	// this exact width are skipped and only the new items pay.
+	auto resizeItems = [&] {
+		for (auto &item : _items) {
+			if (item->width() != _itemWidth) {
+				item->resizeGetHeight(_itemWidth);
+			}
+		}
+	};
 	auto resizeOneColumn = [&](int itemsLeft, int itemWidth) {
 		_itemsLeft = itemsLeft;
 		_itemsTop = 0;
 		_itemsInRow = 1;
 		_itemWidth = itemWidth;
-		for (auto &item : _items) {
-			item->resizeGetHeight(_itemWidth);
-		}
+		resizeItems();
 	};
 	switch (_type) {
 	case Type::Photo:
@@ -339,9 +347,7 @@ void ListSection::resizeToWidth(int newWidth) {
 			/ (st::infoMediaMinGridSize + st::infoMediaSkip);
 		_itemWidth = ((newWidth - _itemsLeft) / _itemsInRow)
 			- st::infoMediaSkip;
-		for (auto &item : _items) {
-			item->resizeGetHeight(_itemWidth);
-		}
+		resizeItems();
 	} break;
 
 	case Type::GIF: {
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/click_handler_types.h"
 #include "main/main_session.h"
+#include "main/main_session_settings.h"
 #include "ui/wrap/slide_wrap.h"
 #include "ui/text/format_values.h" // Ui::FormatPhone
 #include "ui/text/text_utilities.h"
@@ -359,11 +360,13 @@ rpl::producer<int> SharedMediaCountValue(
 		Storage::SharedMediaType type) {
 	auto aroundId = 0;
 	auto limit = 0;
+	const auto session = &peer->session();
+	const auto peerId = peer->id;
 	auto updated = SharedMediaMergedViewer(
-		&peer->session(),
+		session,
 		SharedMediaMergedKey(
 			SparseIdsMergedSlice::Key(
-				peer->id,
+				peerId,
 				migrated ? migrated->id : 0,
 				aroundId),
 			type),
@@ -371,8 +374,21 @@ rpl::producer<int> SharedMediaCountValue(
 		limit
 	) | rpl::map([](const SparseIdsMergedSlice &slice) {
 		return slice.fullCount();
-	}) | rpl::filter_optional();
-	return rpl::single(0) | rpl::then(std::move(updated));
+	}) | rpl::filter_optional(
+	) | rpl::map([=](int count) {
+		// Remember the count so the next profile open, even in the next
+		// session, renders it instantly while the fresh one is fetched.
+		session->settings().setSharedMediaCount(
+			peerId,
+			static_cast<int>(type),
+			count);
+		session->saveSettingsDelayed();
+		return count;
+	});
+	const auto cached = session->settings().sharedMediaCount(
+		peerId,
+		static_cast<int>(type));
+	return rpl::single(cached.value_or(0)) | rpl::then(std::move(updated));
 }
 
 rpl::producer<int> CommonGroupsCountValue(not_null<UserData*> user) {
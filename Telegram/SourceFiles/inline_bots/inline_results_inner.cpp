@@ -41,6 +41,7 @@ namespace {
 
 constexpr auto kMinRepaintDelay = crl::time(33);
 constexpr auto kMinAfterScrollDelay = crl::time(33);
+constexpr auto kPreloadPages = 2;
 
 } // namespace
 
@@ -101,6 +102,7 @@ void Inner::visibleTopBottomUpdated(
 	if (_visibleTop != visibleTop) {
 		_visibleTop = visibleTop;
 		_lastScrolledAt = crl::now();
+		preloadImages();
 		update();
 	}
 }
@@ -426,9 +428,35 @@ void Inner::deleteUnusedInlineLayouts() {
 }
 
 void Inner::preloadImages() {
-	_mosaic.forEach([](not_null<const ItemBase*> item) {
-		item->preload();
-	});
+	// Start only the thumbnails around the viewport, the rest of them
+	// are requested as the user scrolls closer, otherwise a GIF bot
+	// answer floods the connection with dozens of downloads at once.
+	const auto visibleHeight = (_visibleBottom > _visibleTop)
+		? (_visibleBottom - _visibleTop)
+		: st::emojiPanMaxHeight;
+	const auto preloadFrom = _visibleTop - kPreloadPages * visibleHeight;
+	const auto preloadTill = _visibleTop
+		+ (kPreloadPages + 1) * visibleHeight;
+	auto top = st::stickerPanPadding;
+	if (_switchPmButton) {
+		top += _switchPmButton->height() + st::inlineResultsSkip;
+	}
+	for (auto row = 0, count = _mosaic.rowsCount(); row != count; ++row) {
+		if (top >= preloadTill) {
+			break;
+		}
+		const auto height = _mosaic.rowHeightAt(row);
+		if (top + height > preloadFrom) {
+			for (auto column = 0;; ++column) {
+				const auto item = _mosaic.maybeItemAt(row, column);
+				if (!item) {
+					break;
+				}
+				item->preload();
+			}
+		}
+		top += height;
+	}
 }
 
 void Inner::hideInlineRowsPanel() {
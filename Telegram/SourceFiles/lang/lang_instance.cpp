@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/boxes/confirm_box.h"
 #include "lang/lang_file_parser.h"
 #include "lang/lang_tag.h" // kTextCommandLangTag.
+#include "core/version.h"
 #include "base/platform/base_platform_info.h"
 #include "base/qthelp_regex.h"
 
@@ -20,7 +21,8 @@ namespace Lang {
 namespace {
 
 const auto kSerializeVersionTag = qsl("#new");
-constexpr auto kSerializeVersion = 1;
+constexpr auto kSerializeVersion = 2;
+constexpr auto kParsedCacheVersion = 2;
 constexpr auto kDefaultLanguage = "en"_cs;
 constexpr auto kCloudLangPackName = "tdesktop"_cs;
 constexpr auto kCustomLanguage = "#custom"_cs;
@@ -382,6 +384,23 @@ QString Instance::langPackName() const {
 }
 
 QByteArray Instance::serialize() const {
+	// The keys are matched and the values are parsed here once, so that
+	// the next cold start can fill the flat values table directly from
+	// the cache without going through GetKeyIndex / ValueParser again.
+	auto parsedKeys = std::vector<ushort>();
+	auto parsedValues = std::vector<QString>();
+	parsedKeys.reserve(_nonDefaultValues.size());
+	parsedValues.reserve(_nonDefaultValues.size());
+	for (const auto &nonDefault : _nonDefaultValues) {
+		ParseKeyValue(
+			nonDefault.first,
+			nonDefault.second,
+			[&](ushort key, QString &&value) {
+				parsedKeys.push_back(key);
+				parsedValues.push_back(std::move(value));
+			});
+	}
+
 	auto size = Serialize::stringSize(kSerializeVersionTag)
 		+ sizeof(qint32) // serializeVersion
 		+ Serialize::stringSize(_id)
@@ -397,6 +416,10 @@ QByteArray Instance::serialize() const {
 		size += Serialize::bytearraySize(nonDefault.first)
 			+ Serialize::bytearraySize(nonDefault.second);
 	}
+	size += sizeof(qint32); // parsedKeys.size()
+	for (auto i = 0, count = int(parsedKeys.size()); i != count; ++i) {
+		size += sizeof(quint16) + Serialize::stringSize(parsedValues[i]);
+	}
 	const auto base = _base ? _base->serialize() : QByteArray();
 	size += Serialize::bytearraySize(base);
 
@@ -420,6 +443,10 @@ QByteArray Instance::serialize() const {
 		for (const auto &nonDefault : _nonDefaultValues) {
 			stream << nonDefault.first << nonDefault.second;
 		}
+		stream << qint32(parsedKeys.size());
+		for (auto i = 0, count = int(parsedKeys.size()); i != count; ++i) {
+			stream << quint16(parsedKeys[i]) << parsedValues[i];
+		}
 		stream << base;
 	}
 	return result;
@@ -449,7 +476,7 @@ void Instance::fillFromSerialized(
 			>> nonDefaultValuesCount;
 	} else {
 		stream >> serializeVersion;
-		if (serializeVersion == kSerializeVersion) {
+		if (serializeVersion >= 1 && serializeVersion <= kSerializeVersion) {
 			stream
 				>> id
 				>> pluralId
@@ -506,6 +533,31 @@ void Instance::fillFromSerialized(
 		nonDefaultStrings.push_back(value);
 	}
 
+	auto parsedStrings = std::vector<std::pair<ushort, QString>>();
+	if (!legacyFormat && serializeVersion >= kParsedCacheVersion) {
+		qint32 parsedCount = 0;
+		stream >> parsedCount;
+		if (stream.status() != QDataStream::Ok
+			|| parsedCount > kLangValuesLimit) {
+			LOG(("Lang Error: "
+				"Could not read data from serialized langpack."));
+			return;
+		}
+		parsedStrings.reserve(parsedCount);
+		for (auto i = 0; i != parsedCount; ++i) {
+			quint16 key = 0;
+			QString value;
+			stream >> key >> value;
+			if (stream.status() != QDataStream::Ok
+				|| key >= kKeysCount) {
+				LOG(("Lang Error: "
+					"Could not read data from serialized langpack."));
+				return;
+			}
+			parsedStrings.emplace_back(key, std::move(value));
+		}
+	}
+
 	_base = nullptr;
 	QByteArray base;
 	if (legacyFormat) {
@@ -546,8 +598,27 @@ void Instance::fillFromSerialized(
 	_customFilePathRelative = customFilePathRelative;
 	_customFileContent = customFileContent;
 	LOG(("Lang Info: Loaded cached, keys: %1").arg(nonDefaultValuesCount));
-	for (auto i = 0, count = nonDefaultValuesCount * 2; i != count; i += 2) {
-		applyValue(nonDefaultStrings[i], nonDefaultStrings[i + 1]);
+	if (!parsedStrings.empty() && dataAppVersion == AppVersion) {
+		// The key indices are assigned by codegen and may change between
+		// app versions, so the parsed cache is used only when it was
+		// written by this very version, otherwise the raw strings are
+		// reparsed below and the cache is refreshed on the next write.
+		for (auto i = 0, count = nonDefaultValuesCount * 2; i != count; i += 2) {
+			_nonDefaultValues[nonDefaultStrings[i]]
+				= nonDefaultStrings[i + 1];
+		}
+		for (auto &[key, value] : parsedStrings) {
+			_nonDefaultSet[key] = 1;
+			if (!_derived) {
+				_values[key] = std::move(value);
+			} else if (!_derived->_nonDefaultSet[key]) {
+				_derived->_values[key] = std::move(value);
+			}
+		}
+	} else {
+		for (auto i = 0, count = nonDefaultValuesCount * 2; i != count; i += 2) {
+			applyValue(nonDefaultStrings[i], nonDefaultStrings[i + 1]);
+		}
 	}
 	updatePluralRules();
 	updateChoosingStickerReplacement();
@@ -12,8 +12,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/launcher.h"
 #include "mtproto/facade.h"
 
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+
 namespace {
 
+constexpr auto kAsyncQueueLimit = 16384;
+
 std::atomic<int> ThreadCounter/* = 0*/;
 thread_local bool WritingEntryFlag/* = false*/;
 
@@ -110,7 +115,7 @@ public:
 		return QString();
 	}
 
-	void write(LogDataType type, const QString &msg) {
+	void write(LogDataType type, const QString &msg, bool flush = true) {
 		QMutexLocker lock(_logsMutex(type));
 		WritingEntryScope scope;
 
@@ -122,7 +127,19 @@ public:
 			return;
 		}
 		file->write(msg.toUtf8());
-		file->flush();
+		if (flush) {
+			file->flush();
+		}
+	}
+
+	void flush(LogDataType type) {
+		QMutexLocker lock(_logsMutex(type));
+		WritingEntryScope scope;
+
+		const auto file = files[type].get();
+		if (file && file->isOpen()) {
+			file->flush();
+		}
 	}
 
 private:
@@ -253,6 +270,90 @@ NEW LOGGING INSTANCE STARTED!!!\n\
 
 LogsDataFields *LogsData = 0;
 
+// Debug logging from MTProto and media threads must not stall on the
+// per-entry disk flushes, so debug, tcp and mtp entries go through a
+// bounded queue to a single writer thread that writes them in batches
+// and flushes each touched file once per batch. The main log is still
+// written synchronously - it is rare and wanted intact in crash dumps.
+class LogsAsyncWriter final : public QThread {
+public:
+	void push(LogDataType type, const QString &msg) {
+		QMutexLocker lock(&_mutex);
+		if (_queue.size() >= kAsyncQueueLimit) {
+			++_dropped;
+			return;
+		}
+		_queue.emplace_back(type, msg);
+		_wake.wakeOne();
+	}
+
+	void finish() {
+		{
+			QMutexLocker lock(&_mutex);
+			_finished = true;
+			_wake.wakeOne();
+		}
+		wait();
+	}
+
+protected:
+	void run() override {
+		while (true) {
+			auto entries = std::vector<std::pair<LogDataType, QString>>();
+			auto dropped = 0;
+			auto finished = false;
+			{
+				QMutexLocker lock(&_mutex);
+				while (_queue.empty() && !_finished) {
+					_wake.wait(&_mutex);
+				}
+				entries = base::take(_queue);
+				dropped = base::take(_dropped);
+				finished = _finished;
+			}
+			auto touched = std::array<bool, LogDataCount>{};
+			for (const auto &[type, msg] : entries) {
+				LogsData->write(type, msg, false);
+				touched[type] = true;
+			}
+			if (dropped) {
+				LogsData->write(
+					LogDataDebug,
+					QString("NOTICE: Dropped %1 debug log entries "
+						"under overload.\n").arg(dropped),
+					false);
+				touched[LogDataDebug] = true;
+			}
+			for (auto type = 0; type != LogDataCount; ++type) {
+				if (touched[type]) {
+					LogsData->flush(LogDataType(type));
+				}
+			}
+			if (finished) {
+				return;
+			}
+		}
+	}
+
+private:
+	QMutex _mutex;
+	QWaitCondition _wake;
+	std::vector<std::pair<LogDataType, QString>> _queue; // Guarded.
+	int _dropped = 0; // Guarded by _mutex.
+	bool _finished = false; // Guarded by _mutex.
+
+};
+
+LogsAsyncWriter *LogsAsync = nullptr;
+
+void _logsStopAsync() {
+	if (const auto writer = LogsAsync) {
+		LogsAsync = nullptr;
+		writer->finish();
+		delete writer;
+	}
+}
+
 using LogsInMemoryList = QList<QPair<LogDataType, QString>>;
 LogsInMemoryList *LogsInMemory = 0;
 LogsInMemoryList *DeletedLogsInMemory = SharedMemoryLocation<LogsInMemoryList, 0>();
@@ -261,8 +362,14 @@ QString LogsBeforeSingleInstanceChecked; // LogsInMemory already dumped in LogsD
 
 void _logsWrite(LogDataType type, const QString &msg) {
 	if (LogsData && (type == LogDataMain || LogsStartIndexChosen < 0)) {
-		if (type == LogDataMain || Logs::DebugEnabled()) {
+		if (type == LogDataMain) {
 			LogsData->write(type, msg);
+		} else if (Logs::DebugEnabled()) {
+			if (LogsAsync) {
+				LogsAsync->push(type, msg);
+			} else {
+				LogsData->write(type, msg);
+			}
 		}
 	} else if (LogsInMemory != DeletedLogsInMemory) {
 		if (!LogsInMemory) {
@@ -461,9 +568,14 @@ void start(not_null<Core::Launcher*> launcher) {
 	}
 
 	LOG(("Logs started"));
+
+	LogsAsync = new LogsAsyncWriter();
+	LogsAsync->start();
 }
 
 void finish() {
+	_logsStopAsync();
+
 	delete LogsData;
 	LogsData = 0;
 
@@ -487,6 +599,7 @@ bool instanceChecked() {
 	if (!LogsData->instanceChecked()) {
 		LogsBeforeSingleInstanceChecked = Logs::full();
 
+		_logsStopAsync();
 		delete LogsData;
 		LogsData = 0;
 		LOG(("FATAL: Could not move logging to '%1'!").arg(_logsFilePath(LogDataMain)));
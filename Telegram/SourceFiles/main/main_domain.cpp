@@ -209,6 +209,8 @@ void Domain::notifyUnreadBadgeChanged() {
 }
 
 void Domain::updateUnreadBadge() {
+	const auto wasBadge = _unreadBadge;
+	const auto wasMuted = _unreadBadgeMuted;
 	_unreadBadge = 0;
 	_unreadBadgeMuted = true;
 	for (const auto &[index, account] : _accounts) {
@@ -220,7 +222,11 @@ void Domain::updateUnreadBadge() {
 			}
 		}
 	}
-	_unreadBadgeChanges.fire({});
+	// Subscribers render the badge from these two values, so recounts
+	// that land on the same state shouldn't trigger native icon updates.
+	if (_unreadBadge != wasBadge || _unreadBadgeMuted != wasMuted) {
+		_unreadBadgeChanges.fire({});
+	}
 }
 
 void Domain::scheduleUpdateUnreadBadge() {
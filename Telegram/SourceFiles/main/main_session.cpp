@@ -35,6 +35,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/unixtime.h"
 #include "calls/calls_instance.h"
 #include "support/support_helper.h"
+#include "support/support_preload.h"
+#include "history/history.h"
 #include "lang/lang_keys.h"
 #include "core/application.h"
 #include "ui/text/text_utilities.h"
@@ -50,6 +52,11 @@ namespace {
 
 constexpr auto kTmpPasswordReserveTime = TimeId(10);
 
+// Delay before the startup idle is used to prewarm the most opened
+// chats, their first open is the latency the users notice the most.
+constexpr auto kPrefetchFrequentChatsDelay = 10 * crl::time(1000);
+constexpr auto kPrefetchFrequentChatsCount = 5;
+
 [[nodiscard]] QString ValidatedInternalLinksDomain(
 		not_null<const Session*> session) {
 	// This domain should start with 'http[s]://' and end with '/'.
@@ -91,7 +98,8 @@ Session::Session(
 , _diceStickersPacks(std::make_unique<Stickers::DicePacks>(this))
 , _sendAsPeers(std::make_unique<SendAsPeers>(this))
 , _supportHelper(Support::Helper::Create(this))
-, _saveSettingsTimer([=] { saveSettings(); }) {
+, _saveSettingsTimer([=] { saveSettings(); })
+, _prefetchFrequentChatsTimer([=] { prefetchFrequentChats(); }) {
 	Expects(_settings != nullptr);
 
 	_api->requestTermsUpdate();
@@ -148,8 +156,12 @@ Session::Session(
 		local().readRecentMasks();
 		local().readFavedStickers();
 		local().readSavedGifs();
+		local().readDialogsSnapshot();
+		local().readContactsSnapshot();
 		data().stickers().notifyUpdated();
 		data().stickers().notifySavedGifsUpdated();
+
+		_prefetchFrequentChatsTimer.callOnce(kPrefetchFrequentChatsDelay);
 	});
 
 #ifndef TDESKTOP_DISABLE_SPELLCHECK
@@ -239,6 +251,27 @@ bool Session::validateSelf(UserId id) {
 	return true;
 }
 
+void Session::prefetchFrequentChats() {
+	// Prewarm the chats the user opens most often while the startup
+	// rush is over: load the userpic and request the first history
+	// slice, so the first open renders at once instead of waiting.
+	for (const auto &peerId : settings().mostOpenedChats(
+			kPrefetchFrequentChatsCount)) {
+		const auto peer = data().peerLoaded(peerId);
+		if (!peer) {
+			continue;
+		}
+		peer->loadUserpic();
+		const auto history = data().history(peer);
+		if (!history->isEmpty()) {
+			continue;
+		}
+		[[maybe_unused]] const auto requestId = Support::SendPreloadRequest(
+			history,
+			[] {});
+	}
+}
+
 void Session::saveSettings() {
 	local().writeSessionSettings();
 }
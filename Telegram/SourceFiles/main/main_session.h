@@ -174,6 +174,8 @@ public:
 private:
 	static constexpr auto kDefaultSaveDelay = crl::time(1000);
 
+	void prefetchFrequentChats();
+
 	const not_null<Account*> _account;
 
 	const std::unique_ptr<SessionSettings> _settings;
@@ -204,6 +206,7 @@ private:
 
 	base::flat_set<not_null<Window::SessionController*>> _windows;
 	base::Timer _saveSettingsTimer;
+	base::Timer _prefetchFrequentChatsTimer;
 
 	QByteArray _tmpPassword;
 	TimeId _tmpPasswordValidUntil = 0;
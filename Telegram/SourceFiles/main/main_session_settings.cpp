@@ -24,6 +24,9 @@ constexpr auto kLegacyCallsPeerToPeerNobody = 4;
 constexpr auto kVersionTag = -1;
 constexpr auto kVersion = 2;
 constexpr auto kMaxSavedPlaybackPositions = 16;
+constexpr auto kMaxSavedChatOpenCounts = 32;
+constexpr auto kMaxSavedSharedMediaCounts = 512;
+constexpr auto kMaxSavedScrollAnchors = 64;
 
 } // namespace
 
@@ -39,6 +42,9 @@ QByteArray SessionSettings::serialize() const {
 	size += _mediaLastPlaybackPosition.size() * 2 * sizeof(quint64);
 	size += Serialize::bytearraySize(autoDownload);
 	size += sizeof(qint32) + _hiddenPinnedMessages.size() * (sizeof(quint64) + sizeof(qint32));
+	size += sizeof(qint32) + _chatOpenCounts.size() * (sizeof(quint64) + sizeof(qint32));
+	size += sizeof(qint32) + _sharedMediaCounts.size() * (sizeof(quint64) + 2 * sizeof(qint32));
+	size += sizeof(qint32) + _chatScrollAnchors.size() * (sizeof(quint64) + sizeof(qint64) + sizeof(qint32));
 
 	auto result = QByteArray();
 	result.reserve(size);
@@ -72,6 +78,22 @@ QByteArray SessionSettings::serialize() const {
 		for (const auto &[key, value] : _hiddenPinnedMessages) {
 			stream << SerializePeerId(key) << qint64(value.bare);
 		}
+		stream << qint32(_chatOpenCounts.size());
+		for (const auto &[peerId, count] : _chatOpenCounts) {
+			stream << SerializePeerId(peerId) << qint32(count);
+		}
+		stream << qint32(_sharedMediaCounts.size());
+		for (const auto &[key, count] : _sharedMediaCounts) {
+			stream << SerializePeerId(key.first)
+				<< qint32(key.second)
+				<< qint32(count);
+		}
+		stream << qint32(_chatScrollAnchors.size());
+		for (const auto &[peerId, anchor] : _chatScrollAnchors) {
+			stream << SerializePeerId(peerId)
+				<< qint64(anchor.first.bare)
+				<< qint32(anchor.second);
+		}
 	}
 	return result;
 }
@@ -132,6 +154,9 @@ void SessionSettings::addFromSerialized(const QByteArray &serialized) {
 	qint32 dialogsFiltersEnabled = _dialogsFiltersEnabled ? 1 : 0;
 	qint32 supportAllSilent = _supportAllSilent ? 1 : 0;
 	qint32 photoEditorHintShowsCount = _photoEditorHintShowsCount;
+	std::vector<std::pair<PeerId, qint32>> chatOpenCounts;
+	base::flat_map<std::pair<PeerId, qint32>, qint32> sharedMediaCounts;
+	base::flat_map<PeerId, std::pair<MsgId, qint32>> chatScrollAnchors;
 
 	stream >> versionTag;
 	if (versionTag == kVersionTag) {
@@ -351,6 +376,63 @@ void SessionSettings::addFromSerialized(const QByteArray &serialized) {
 			}
 		}
 	}
+	if (!stream.atEnd()) {
+		auto count = qint32(0);
+		stream >> count;
+		if (stream.status() == QDataStream::Ok) {
+			for (auto i = 0; i != count; ++i) {
+				auto key = quint64();
+				auto value = qint32();
+				stream >> key >> value;
+				if (stream.status() != QDataStream::Ok) {
+					LOG(("App Error: "
+						"Bad data for SessionSettings::addFromSerialized()"));
+					return;
+				}
+				chatOpenCounts.emplace_back(DeserializePeerId(key), value);
+			}
+		}
+	}
+	if (!stream.atEnd()) {
+		auto count = qint32(0);
+		stream >> count;
+		if (stream.status() == QDataStream::Ok) {
+			for (auto i = 0; i != count; ++i) {
+				auto key = quint64();
+				auto type = qint32();
+				auto value = qint32();
+				stream >> key >> type >> value;
+				if (stream.status() != QDataStream::Ok) {
+					LOG(("App Error: "
+						"Bad data for SessionSettings::addFromSerialized()"));
+					return;
+				}
+				sharedMediaCounts.emplace(
+					std::make_pair(DeserializePeerId(key), type),
+					value);
+			}
+		}
+	}
+	if (!stream.atEnd()) {
+		auto count = qint32(0);
+		stream >> count;
+		if (stream.status() == QDataStream::Ok) {
+			for (auto i = 0; i != count; ++i) {
+				auto key = quint64();
+				auto msgId = qint64();
+				auto offset = qint32();
+				stream >> key >> msgId >> offset;
+				if (stream.status() != QDataStream::Ok) {
+					LOG(("App Error: "
+						"Bad data for SessionSettings::addFromSerialized()"));
+					return;
+				}
+				chatScrollAnchors.emplace(
+					DeserializePeerId(key),
+					std::make_pair(MsgId(msgId), offset));
+			}
+		}
+	}
 	if (stream.status() != QDataStream::Ok) {
 		LOG(("App Error: "
 			"Bad data for SessionSettings::addFromSerialized()"));
@@ -394,6 +476,9 @@ void SessionSettings::addFromSerialized(const QByteArray &serialized) {
 	_dialogsFiltersEnabled = (dialogsFiltersEnabled == 1);
 	_supportAllSilent = (supportAllSilent == 1);
 	_photoEditorHintShowsCount = std::move(photoEditorHintShowsCount);
+	_chatOpenCounts = std::move(chatOpenCounts);
+	_sharedMediaCounts = std::move(sharedMediaCounts);
+	_chatScrollAnchors = std::move(chatScrollAnchors);
 
 	if (version < 2) {
 		app.setLastSeenWarningSeen(appLastSeenWarningSeen == 1);
@@ -496,6 +581,96 @@ crl::time SessionSettings::mediaLastPlaybackPosition(DocumentId id) const {
 	return (i != _mediaLastPlaybackPosition.end()) ? i->second : 0;
 }
 
+void SessionSettings::registerChatOpen(PeerId peerId) {
+	auto &map = _chatOpenCounts;
+	const auto i = ranges::find(
+		map,
+		peerId,
+		&std::pair<PeerId, qint32>::first);
+	if (i != map.end()) {
+		++i->second;
+	} else {
+		if (map.size() >= kMaxSavedChatOpenCounts) {
+			map.erase(ranges::min_element(
+				map,
+				ranges::less(),
+				&std::pair<PeerId, qint32>::second));
+		}
+		map.emplace_back(peerId, 1);
+	}
+}
+
+void SessionSettings::setSharedMediaCount(
+		PeerId peerId,
+		int type,
+		int count) {
+	auto &map = _sharedMediaCounts;
+	const auto key = std::make_pair(peerId, qint32(type));
+	const auto i = map.find(key);
+	if (i != map.end()) {
+		i->second = count;
+	} else {
+		if (map.size() >= kMaxSavedSharedMediaCounts) {
+			map.erase(map.begin());
+		}
+		map.emplace(key, qint32(count));
+	}
+}
+
+void SessionSettings::setChatScrollAnchor(
+		PeerId peerId,
+		MsgId msgId,
+		int offset) {
+	auto &map = _chatScrollAnchors;
+	if (!msgId) {
+		map.remove(peerId);
+		return;
+	}
+	const auto i = map.find(peerId);
+	if (i != map.end()) {
+		i->second = std::make_pair(msgId, qint32(offset));
+	} else {
+		if (map.size() >= kMaxSavedScrollAnchors) {
+			map.erase(map.begin());
+		}
+		map.emplace(peerId, std::make_pair(msgId, qint32(offset)));
+	}
+}
+
+auto SessionSettings::chatScrollAnchor(PeerId peerId) const -> ScrollAnchor {
+	const auto i = _chatScrollAnchors.find(peerId);
+	return (i != end(_chatScrollAnchors))
+		? ScrollAnchor{ i->second.first, int(i->second.second) }
+		: ScrollAnchor();
+}
+
+std::optional<int> SessionSettings::sharedMediaCount(
+		PeerId peerId,
+		int type) const {
+	const auto i = _sharedMediaCounts.find(
+		std::make_pair(peerId, qint32(type)));
+	return (i != end(_sharedMediaCounts))
+		? std::make_optional(int(i->second))
+		: std::nullopt;
+}
+
+std::vector<PeerId> SessionSettings::mostOpenedChats(int limit) const {
+	auto sorted = _chatOpenCounts;
+	ranges::sort(
+		sorted,
+		ranges::greater(),
+		&std::pair<PeerId, qint32>::second);
+	if (int(sorted.size()) > limit) {
+		sorted.resize(limit);
+	}
+	auto result = std::vector<PeerId>();
+	result.reserve(sorted.size());
+	for (const auto &[peerId, count] : sorted) {
+		result.push_back(peerId);
+	}
+	return result;
+}
+
 void SessionSettings::setArchiveCollapsed(bool collapsed) {
 	_archiveCollapsed = collapsed;
 }
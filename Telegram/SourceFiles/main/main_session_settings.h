@@ -123,6 +123,21 @@ public:
 	[[nodiscard]] bool photoEditorHintShown() const;
 	void incrementPhotoEditorHintShown();
 
+	void registerChatOpen(PeerId peerId);
+	[[nodiscard]] std::vector<PeerId> mostOpenedChats(int limit) const;
+
+	void setSharedMediaCount(PeerId peerId, int type, int count);
+	[[nodiscard]] std::optional<int> sharedMediaCount(
+		PeerId peerId,
+		int type) const;
+
+	struct ScrollAnchor {
+		MsgId msgId = 0;
+		int offset = 0;
+	};
+	void setChatScrollAnchor(PeerId peerId, MsgId msgId, int offset);
+	[[nodiscard]] ScrollAnchor chatScrollAnchor(PeerId peerId) const;
+
 private:
 	static constexpr auto kDefaultSupportChatsLimitSlice = 7 * 24 * 60 * 60;
 	static constexpr auto kPhotoEditorHintMaxShowsCount = 5;
@@ -136,6 +151,9 @@ private:
 	rpl::variable<bool> _skipArchiveInSearch = false;
 	std::vector<std::pair<DocumentId, crl::time>> _mediaLastPlaybackPosition;
 	base::flat_map<PeerId, MsgId> _hiddenPinnedMessages;
+	std::vector<std::pair<PeerId, qint32>> _chatOpenCounts;
+	base::flat_map<std::pair<PeerId, qint32>, qint32> _sharedMediaCounts;
+	base::flat_map<PeerId, std::pair<MsgId, qint32>> _chatScrollAnchors;
 	bool _dialogsFiltersEnabled = false;
 	int _photoEditorHintShowsCount = 0;
 
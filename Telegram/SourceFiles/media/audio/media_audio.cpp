@@ -301,12 +301,18 @@ constexpr auto kCheckFadingTimeout = crl::time(7); // 7ms
 
 base::Observable<AudioMsgId> UpdatedObservable;
 
+std::atomic<int> UnderrunsCounter = 0;
+
 } // namespace
 
 base::Observable<AudioMsgId> &Updated() {
 	return UpdatedObservable;
 }
 
+int UnderrunsCount() {
+	return UnderrunsCounter.load();
+}
+
 // Thread: Any. Must be locked: AudioMutex.
 float64 ComputeVolume(AudioMsgId::Type type) {
 	switch (type) {
@@ -465,6 +471,9 @@ void Mixer::Track::clear() {
 	setExternalData(nullptr);
 	lastUpdateWhen = 0;
 	lastUpdatePosition = 0;
+	syncWhen = 0;
+	syncPosition = 0;
+	syncPlayId = 0;
 }
 
 void Mixer::Track::started() {
@@ -908,14 +917,25 @@ Streaming::TimePoint Mixer::getExternalSyncTimePoint(
 		const AudioMsgId &audio) const {
 	Expects(audio.externalPlayId() != 0);
 
+	// Polled by the video track thread on every frame, so it reads a
+	// lock-free copy instead of waiting on AudioMutex, which the fader
+	// thread may be holding across blocking OpenAL calls.
 	auto result = Streaming::TimePoint();
-	const auto type = audio.type();
-
-	QMutexLocker lock(&AudioMutex);
-	const auto track = trackForType(type);
-	if (track && track->state.id == audio && track->lastUpdateWhen > 0) {
-		result.trackTime = track->lastUpdatePosition;
-		result.worldTime = track->lastUpdateWhen;
+	const auto track = trackForType(audio.type());
+	if (!track) {
+		return result;
+	}
+	while (true) {
+		const auto when = track->syncWhen.load();
+		if (when <= 0 || track->syncPlayId.load() != audio.externalPlayId()) {
+			break;
+		}
+		const auto position = track->syncPosition.load();
+		if (track->syncWhen.load() == when) {
+			result.trackTime = position;
+			result.worldTime = when;
+			break;
+		}
 	}
 	return result;
 }
@@ -944,6 +964,9 @@ void Mixer::externalSoundProgress(const AudioMsgId &audio) {
 		if (current->state.id == audio && current->state.state == State::Playing) {
 			current->lastUpdateWhen = crl::now();
 			current->lastUpdatePosition = (current->state.position * 1000ULL) / current->state.frequency;
+			current->syncPlayId = audio.externalPlayId();
+			current->syncPosition = current->lastUpdatePosition;
+			current->syncWhen = current->lastUpdateWhen;
 		}
 	}
 }
@@ -1002,6 +1025,7 @@ void Mixer::pause(const AudioMsgId &audio, bool fast) {
 
 		track->lastUpdateWhen = 0;
 		track->lastUpdatePosition = 0;
+		track->syncWhen = 0;
 	}
 	if (current) updated(current);
 }
@@ -1475,6 +1499,7 @@ int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasF
 		track->state.position = fullPosition;
 		emitSignals |= EmitPositionUpdated;
 	} else if (track->state.waitingForData && !waitingForDataOld) {
+		++UnderrunsCounter;
 		if (fullPosition > track->state.position) {
 			track->state.position = fullPosition;
 		}
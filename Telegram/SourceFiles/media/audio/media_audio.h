@@ -64,6 +64,9 @@ base::Observable<AudioMsgId> &Updated();
 
 float64 ComputeVolume(AudioMsgId::Type type);
 
+// Thread: Any. How many times the playback ran out of buffered data.
+int UnderrunsCount();
+
 enum class State {
 	Stopped = 0x01,
 	StoppedAtEnd = 0x02,
@@ -152,6 +155,7 @@ public:
 	// Thread: Main. Locks: AudioMutex.
 	void setSpeedFromExternal(const AudioMsgId &audioId, float64 speed);
 
+	// Thread: Any. Lock-free.
 	Streaming::TimePoint getExternalSyncTimePoint(
 		const AudioMsgId &audio) const;
 	crl::time getExternalCorrectedTime(
@@ -257,6 +261,14 @@ private:
 		crl::time lastUpdateWhen = 0;
 		crl::time lastUpdatePosition = 0;
 
+		// A copy of the sync point that the video track thread polls
+		// on every frame without locking AudioMutex, so that it never
+		// waits while the fader thread holds the mutex across blocking
+		// OpenAL calls. Only the main thread writes, 'syncWhen' last.
+		std::atomic<uint64> syncPlayId = 0;
+		std::atomic<crl::time> syncPosition = 0;
+		std::atomic<crl::time> syncWhen = 0;
+
 	private:
 		void createStream(AudioMsgId::Type type);
 		void destroyStream();
@@ -19,6 +19,15 @@ constexpr auto kSkipInvalidDataPackets = 10;
 constexpr auto kMaxInlineArea = 1280 * 720;
 constexpr auto kMaxSendingArea = 3840 * 2160; // usual 4K
 
+// Short loops replay from rendered frames instead of spinning the
+// decoder forever, as long as they fit in the per-reader budget and
+// in the total budget shared by all the clip readers.
+constexpr auto kMaxLoopCacheDuration = crl::time(2000);
+constexpr auto kMaxLoopCacheBytes = int64(16 * 1024 * 1024);
+constexpr auto kMaxLoopCachesTotalBytes = int64(96 * 1024 * 1024);
+
+std::atomic<int64> LoopCachesTotalBytes = 0;
+
 // See https://github.com/telegramdesktop/tdesktop/issues/7225
 constexpr auto kAlignImageBy = 64;
 
@@ -55,6 +64,13 @@ FFMpegReaderImplementation::FFMpegReaderImplementation(
 }
 
 ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
+	if (_loopCacheReady) {
+		return readFromLoopCache();
+	} else if (loopCacheCollecting() && _frameRead) {
+		// The previous decoded frame is dropped without a render, so
+		// the loop wouldn't be complete in the cache.
+		dropLoopCache();
+	}
 	do {
 		int res = avcodec_receive_frame(_codecContext, _frame.get());
 		if (res >= 0) {
@@ -75,6 +91,10 @@ ReaderImplementation::ReadResult FFMpegReaderImplementation::readNextFrame() {
 				return ReadResult::Error;
 			}
 
+			if (finishLoopCache()) {
+				return readFromLoopCache();
+			}
+
 			if ((res = avformat_seek_file(_fmtContext, _streamId, std::numeric_limits<int64_t>::min(), 0, std::numeric_limits<int64_t>::max(), 0)) < 0) {
 				if ((res = av_seek_frame(_fmtContext, _streamId, 0, AVSEEK_FLAG_BYTE)) < 0) {
 					if ((res = av_seek_frame(_fmtContext, _streamId, 0, AVSEEK_FLAG_FRAME)) < 0) {
@@ -204,6 +224,9 @@ bool FFMpegReaderImplementation::renderFrame(QImage &to, bool &hasAlpha, const Q
 	Expects(_frameRead);
 	_frameRead = false;
 
+	if (_loopCacheReady) {
+		return renderFromLoopCache(to, hasAlpha, size);
+	}
 	if (!_width || !_height) {
 		_width = _frame->width;
 		_height = _frame->height;
@@ -253,11 +276,93 @@ bool FFMpegReaderImplementation::renderFrame(QImage &to, bool &hasAlpha, const Q
 		to = to.transformed(rotationTransform);
 	}
 
+	if (loopCacheCollecting()) {
+		const auto bytes = int64(to.sizeInBytes());
+		if (_frameMs > kMaxLoopCacheDuration
+			|| _loopCacheBytes + bytes > kMaxLoopCacheBytes
+			|| LoopCachesTotalBytes.load() + bytes > kMaxLoopCachesTotalBytes) {
+			dropLoopCache();
+		} else {
+			LoopCachesTotalBytes += bytes;
+			_loopCacheBytes += bytes;
+			_loopCache.push_back({
+				to,
+				_frameMs,
+				_currentFrameDelay,
+				hasAlpha,
+			});
+		}
+	}
+
 	FFmpeg::ClearFrameMemory(_frame.get());
 
 	return true;
 }
 
+bool FFMpegReaderImplementation::loopCacheCollecting() const {
+	return _loopCacheAllowed && !_loopCacheBroken && !_loopCacheReady;
+}
+
+bool FFMpegReaderImplementation::finishLoopCache() {
+	if (!loopCacheCollecting() || _loopCache.empty()) {
+		return false;
+	}
+	// The first frame got a zero delay on the initial pass, while on
+	// a real loop restart it plays after the last frame duration.
+	_loopCache.front().delay = _nextFrameDelay;
+	_loopCacheReady = true;
+	_loopCacheIndex = -1;
+	return true;
+}
+
+void FFMpegReaderImplementation::dropLoopCache() {
+	LoopCachesTotalBytes -= _loopCacheBytes;
+	_loopCacheBytes = 0;
+	_loopCache.clear();
+	_loopCacheIndex = -1;
+	_loopCacheReady = false;
+	_loopCacheBroken = true;
+}
+
+ReaderImplementation::ReadResult FFMpegReaderImplementation::readFromLoopCache() {
+	Expects(_loopCacheReady && !_loopCache.empty());
+
+	_loopCacheIndex = (_loopCacheIndex + 1) % int(_loopCache.size());
+	const auto &cached = _loopCache[_loopCacheIndex];
+	_currentFrameDelay = cached.delay;
+	_frameTime += _currentFrameDelay;
+	_frameMs = cached.frameMs;
+	_hadFrame = _frameRead = true;
+	return ReadResult::Success;
+}
+
+bool FFMpegReaderImplementation::renderFromLoopCache(
+		QImage &to,
+		bool &hasAlpha,
+		const QSize &size) {
+	Expects(_loopCacheIndex >= 0
+		&& _loopCacheIndex < int(_loopCache.size()));
+
+	const auto &cached = _loopCache[_loopCacheIndex];
+	hasAlpha = cached.hasAlpha;
+	auto toSize = size.isEmpty() ? QSize(_width, _height) : size;
+	if (!size.isEmpty() && rotationSwapWidthHeight()) {
+		toSize.transpose();
+	}
+	if (cached.image.size() != toSize) {
+		// The requested size changed - serve a scaled frame once and
+		// go back to the decoder, it resumes through the EOF path.
+		to = cached.image.scaled(
+			toSize,
+			Qt::IgnoreAspectRatio,
+			Qt::SmoothTransformation);
+		dropLoopCache();
+		return true;
+	}
+	to = cached.image;
+	return true;
+}
+
 FFMpegReaderImplementation::Rotation FFMpegReaderImplementation::rotationFromDegrees(int degrees) const {
 	switch (degrees) {
 	case 90: return Rotation::Degrees90;
@@ -269,6 +374,7 @@ FFMpegReaderImplementation::Rotation FFMpegReaderImplementation::rotationFromDeg
 
 bool FFMpegReaderImplementation::start(Mode mode, crl::time &positionMs) {
 	_mode = mode;
+	_loopCacheAllowed = (mode == Mode::Silent) && (positionMs <= 0);
 
 	initDevice();
 	if (!_device->open(QIODevice::ReadOnly)) {
@@ -420,6 +526,7 @@ QString FFMpegReaderImplementation::logData() const {
 }
 
 FFMpegReaderImplementation::~FFMpegReaderImplementation() {
+	LoopCachesTotalBytes -= _loopCacheBytes;
 	if (_codecContext) avcodec_free_context(&_codecContext);
 	if (_swsContext) sws_freeContext(_swsContext);
 	if (_opened) {
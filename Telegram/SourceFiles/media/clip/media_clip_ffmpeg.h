@@ -48,9 +48,22 @@ public:
 	~FFMpegReaderImplementation();
 
 private:
+	struct LoopCacheFrame {
+		QImage image;
+		crl::time frameMs = 0;
+		int delay = 0;
+		bool hasAlpha = false;
+	};
+
 	ReadResult readNextFrame();
 	void processReadFrame();
 
+	[[nodiscard]] bool loopCacheCollecting() const;
+	[[nodiscard]] bool finishLoopCache();
+	void dropLoopCache();
+	[[nodiscard]] ReadResult readFromLoopCache();
+	bool renderFromLoopCache(QImage &to, bool &hasAlpha, const QSize &size);
+
 	enum class PacketResult {
 		Ok,
 		EndOfFile,
@@ -108,6 +121,14 @@ private:
 	crl::time _frameTime = 0;
 	crl::time _frameTimeCorrection = 0;
 
+	// Frames of one full short loop, replayed instead of re-decoding.
+	std::vector<LoopCacheFrame> _loopCache;
+	int64 _loopCacheBytes = 0;
+	int _loopCacheIndex = -1;
+	bool _loopCacheAllowed = false;
+	bool _loopCacheBroken = false;
+	bool _loopCacheReady = false;
+
 };
 
 } // namespace internal
@@ -52,6 +52,10 @@ constexpr auto kRememberShuffledOrderItems = 16;
 
 constexpr auto kMinLengthForSavePosition = 20 * TimeId(60); // 20 minutes.
 
+// Start pulling the next track into the media cache when that little
+// is left of the current one, so the switch doesn't wait for the network.
+constexpr auto kReadaheadRemaining = 30 * crl::time(1000);
+
 auto VoicePlaybackSpeed() {
 	return std::clamp(Core::App().settings().voicePlaybackSpeed(), 0.6, 1.7);
 }
@@ -596,6 +600,68 @@ bool Instance::moveInPlaylist(
 	return false;
 }
 
+HistoryItem *Instance::nextItemInPlaylist(not_null<Data*> data) {
+	if (!data->playlistIndex || !data->playlistSlice) {
+		return nullptr;
+	}
+	const auto repeatAll = (repeat(data) == RepeatMode::All);
+	const auto newIndex = *data->playlistIndex
+		+ ((order(data) == OrderMode::Reverse) ? -1 : 1);
+	const auto useIndex = (!repeatAll
+		|| data->playlistSlice->skippedAfter() != 0
+		|| data->playlistSlice->skippedBefore() != 0
+		|| !data->playlistSlice->size())
+		? newIndex
+		: ((newIndex + int(data->playlistSlice->size()))
+			% int(data->playlistSlice->size()));
+	if (const auto item = itemByIndex(data, useIndex)) {
+		return item;
+	} else if (repeatAll
+		&& data->playlistOtherSlice
+		&& data->playlistOtherSlice->size() > 0) {
+		const auto &other = *data->playlistOtherSlice;
+		if (newIndex < 0 && other.skippedAfter() == 0) {
+			return data->history->owner().message(other[other.size() - 1]);
+		} else if (newIndex > 0 && other.skippedBefore() == 0) {
+			return data->history->owner().message(other[0]);
+		}
+	}
+	return nullptr;
+}
+
+void Instance::checkNextTrackReadahead(
+		not_null<Data*> data,
+		const TrackState &state) {
+	// Cloud audio produces an audible gap between playlist tracks while
+	// the player waits for the first bytes of the next file, so the next
+	// track is loaded into the media cache while the tail of the current
+	// one still plays and the switch streams from the local cache.
+	// Shuffle is skipped because the next track is chosen at the switch.
+	if (data->type != AudioMsgId::Type::Song
+		|| order(data) == OrderMode::Shuffle
+		|| repeat(data) == RepeatMode::One
+		|| OptionDisableAutoplayNext.value()
+		|| data->readaheadFor == data->current.contextId()
+		|| state.length == kTimeUnknown
+		|| state.position == kTimeUnknown
+		|| !state.frequency
+		|| ((state.length - state.position) * crl::time(1000)
+			> kReadaheadRemaining * state.frequency)) {
+		return;
+	}
+	data->readaheadFor = data->current.contextId();
+	const auto item = nextItemInPlaylist(data);
+	const auto media = item ? item->media() : nullptr;
+	const auto document = media ? media->document() : nullptr;
+	if (!document
+		|| !document->isAudioFile()
+		|| document->loading()
+		|| document->loadedInMediaCache()) {
+		return;
+	}
+	document->save(item->fullId(), QString());
+}
+
 void Instance::updatePowerSaveBlocker(
 		not_null<Data*> data,
 		const TrackState &state) {
@@ -1216,6 +1282,7 @@ void Instance::emitUpdate(AudioMsgId::Type type, CheckCallback check) {
 			}
 		}
 		updatePowerSaveBlocker(data, state);
+		checkNextTrackReadahead(data, state);
 
 		auto finished = false;
 		_updatedNotifier.fire_copy({state});
@@ -198,6 +198,7 @@ private:
 		Main::Session *session = nullptr;
 		bool isPlaying = false;
 		bool resumeOnCallEnd = false;
+		FullMsgId readaheadFor;
 		std::unique_ptr<Streamed> streamed;
 		std::unique_ptr<ShuffleData> shuffleData;
 		std::unique_ptr<base::PowerSaveBlocker> powerSaveBlocker;
@@ -241,6 +242,10 @@ private:
 	void validateOtherPlaylist(not_null<Data*> data);
 	void playlistUpdated(not_null<Data*> data);
 	bool moveInPlaylist(not_null<Data*> data, int delta, bool autonext);
+	HistoryItem *nextItemInPlaylist(not_null<Data*> data);
+	void checkNextTrackReadahead(
+		not_null<Data*> data,
+		const TrackState &state);
 	void updatePowerSaveBlocker(
 		not_null<Data*> data,
 		const TrackState &state);
@@ -175,19 +175,24 @@ Stream File::Context::initStream(
 			// ignore cover streams
 			return Stream();
 		}
-		const auto hwAccelTypes = std::array{
+		// Hardware decode contexts are a scarce resource, so they are
+		// only negotiated where the caller allowed them (full screen
+		// viewer, Picture-in-Picture), not for inline autoplay.
+		const auto hwAccelTypes = hwAllowed
+			? std::vector<AVHWDeviceType>{
 #ifdef Q_OS_WIN
-			AV_HWDEVICE_TYPE_D3D11VA,
-			AV_HWDEVICE_TYPE_DXVA2,
+				AV_HWDEVICE_TYPE_D3D11VA,
+				AV_HWDEVICE_TYPE_DXVA2,
 #elif defined Q_OS_MAC // Q_OS_WIN
-			AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+				AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
 #else // Q_OS_WIN || Q_OS_MAC
-			AV_HWDEVICE_TYPE_VAAPI,
-			AV_HWDEVICE_TYPE_VDPAU,
+				AV_HWDEVICE_TYPE_VAAPI,
+				AV_HWDEVICE_TYPE_VDPAU,
 #endif // Q_OS_WIN || Q_OS_MAC
-			AV_HWDEVICE_TYPE_CUDA,
-			AV_HWDEVICE_TYPE_NONE,
-		};
+				AV_HWDEVICE_TYPE_CUDA,
+				AV_HWDEVICE_TYPE_NONE,
+			}
+			: std::vector<AVHWDeviceType>{ AV_HWDEVICE_TYPE_NONE };
 		for (const auto type : hwAccelTypes) {
 			if (tryCreateCodec(type)) {
 				break;
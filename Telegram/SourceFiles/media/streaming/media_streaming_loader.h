@@ -56,6 +56,7 @@ public:
 	bool remove(int value);
 	void resetPriorities();
 	[[nodiscard]] bool empty() const;
+	[[nodiscard]] int size() const;
 	[[nodiscard]] std::optional<int> front() const;
 	[[nodiscard]] std::optional<int> take();
 	[[nodiscard]] base::flat_set<int> takeInRange(int from, int till);
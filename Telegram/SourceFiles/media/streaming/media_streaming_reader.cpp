@@ -23,10 +23,17 @@ constexpr auto kMaxOnlyInHeader = 80 * kPartSize;
 constexpr auto kPartsOutsideFirstSliceGood = 8;
 constexpr auto kSlicesInMemory = 2;
 
-// 1 MB of parts are requested from cloud ahead of reading demand.
-constexpr auto kPreloadPartsAhead = 8;
 constexpr auto kDownloaderRequestsLimit = 4;
 
+// How often the readahead window is recomputed and how much playback
+// it should cover at the measured consumption rate.
+constexpr auto kReadaheadRefreshEach = 2 * crl::time(1000);
+constexpr auto kReadaheadCoverDuration = 4 * crl::time(1000);
+
+// A seek this far away from the last read position drops the parts
+// queued for the old position.
+constexpr auto kSeekCancelDistance = kPartsInSlice * kPartSize;
+
 using PartsMap = base::flat_map<int, QByteArray>;
 
 struct ParsedCacheEntry {
@@ -262,14 +269,17 @@ void Reader::Slice::addPart(int offset, QByteArray bytes) {
 	}
 }
 
-auto Reader::Slice::prepareFill(int from, int till) -> PrepareFillResult {
+auto Reader::Slice::prepareFill(
+	int from,
+	int till,
+	int aheadParts)
+-> PrepareFillResult {
 	auto result = PrepareFillResult();
 
 	result.ready = false;
 	const auto fromOffset = (from / kPartSize) * kPartSize;
 	const auto tillPart = (till + kPartSize - 1) / kPartSize;
-	const auto preloadTillOffset = (tillPart + kPreloadPartsAhead)
-		* kPartSize;
+	const auto preloadTillOffset = (tillPart + aheadParts) * kPartSize;
 
 	const auto after = ranges::upper_bound(
 		parts,
@@ -540,7 +550,11 @@ void Reader::Slices::processPart(
 	checkSliceFullLoaded(index + 1);
 }
 
-auto Reader::Slices::fill(int offset, bytes::span buffer) -> FillResult {
+auto Reader::Slices::fill(
+	int offset,
+	bytes::span buffer,
+	int aheadParts)
+-> FillResult {
 	Expects(!buffer.empty());
 	Expects(offset >= 0 && offset < _size);
 	Expects(offset + buffer.size() <= _size);
@@ -554,7 +568,7 @@ auto Reader::Slices::fill(int offset, bytes::span buffer) -> FillResult {
 		Assert(waitingForHeaderCache());
 		return {};
 	} else if (isFullInHeader()) {
-		return fillFromHeader(offset, buffer);
+		return fillFromHeader(offset, buffer, aheadParts);
 	}
 
 	auto result = FillResult();
@@ -596,9 +610,12 @@ auto Reader::Slices::fill(int offset, bytes::span buffer) -> FillResult {
 	const auto firstTill = std::min(kInSlice, till - fromSlice * kInSlice);
 	const auto secondFrom = 0;
 	const auto secondTill = till - (fromSlice + 1) * kInSlice;
-	const auto first = _data[fromSlice].prepareFill(firstFrom, firstTill);
+	const auto first = _data[fromSlice].prepareFill(
+		firstFrom,
+		firstTill,
+		aheadParts);
 	const auto second = (fromSlice + 1 < tillSlice)
-		? _data[fromSlice + 1].prepareFill(secondFrom, secondTill)
+		? _data[fromSlice + 1].prepareFill(secondFrom, secondTill, aheadParts)
 		: Slice::PrepareFillResult();
 	handlePrepareResult(fromSlice, first);
 	if (fromSlice + 1 < tillSlice) {
@@ -630,13 +647,16 @@ auto Reader::Slices::fill(int offset, bytes::span buffer) -> FillResult {
 	return result;
 }
 
-auto Reader::Slices::fillFromHeader(int offset, bytes::span buffer)
+auto Reader::Slices::fillFromHeader(
+	int offset,
+	bytes::span buffer,
+	int aheadParts)
 -> FillResult {
 	auto result = FillResult();
 	const auto from = offset;
 	const auto till = int(offset + buffer.size());
 
-	const auto prepared = _header.prepareFill(from, till);
+	const auto prepared = _header.prepareFill(from, till, aheadParts);
 	for (const auto full : prepared.offsetsFromLoader.values()) {
 		if (full < _size) {
 			result.offsetsFromLoader.add(full);
@@ -1199,6 +1219,15 @@ std::optional<Error> Reader::streamingError() const {
 	return _streamingError;
 }
 
+Reader::PrefetchStats Reader::prefetchStats() const {
+	return {
+		.readaheadParts = _readaheadParts,
+		.loadingParts = _loadingOffsets.size(),
+		.loadedBytes = _totalLoadedBytes,
+		.consumedBytes = _totalConsumedBytes,
+	};
+}
+
 void Reader::headerDone() {
 	_slices.headerDone(false);
 }
@@ -1244,6 +1273,15 @@ Reader::FillState Reader::fill(
 		return FillState::Failed;
 	}
 
+	_consumedBytesSinceCheck += buffer.size();
+	_totalConsumedBytes += buffer.size();
+	refreshReadaheadParts();
+	if (_lastFillOffset >= 0
+		&& std::abs(offset - _lastFillOffset) >= kSeekCancelDistance) {
+		cancelStaleLoads(offset);
+	}
+	_lastFillOffset = offset;
+
 	auto lastResult = FillState();
 	do {
 		lastResult = fillFromSlices(offset, buffer);
@@ -1259,7 +1297,7 @@ Reader::FillState Reader::fill(
 Reader::FillState Reader::fillFromSlices(int offset, bytes::span buffer) {
 	using namespace rpl::mappers;
 
-	auto result = _slices.fill(offset, buffer);
+	auto result = _slices.fill(offset, buffer, _readaheadParts);
 	if (result.state != FillState::Success && _slices.headerWontBeFilled()) {
 		_streamingError = Error::NotStreamable;
 		return FillState::Failed;
@@ -1306,6 +1344,55 @@ void Reader::checkLoadWillBeFirst(int offset) {
 	}
 }
 
+void Reader::refreshReadaheadParts() {
+	const auto now = crl::now();
+	if (!_readaheadCheckStart) {
+		_readaheadCheckStart = now;
+		return;
+	}
+	const auto elapsed = now - _readaheadCheckStart;
+	if (elapsed < kReadaheadRefreshEach) {
+		return;
+	}
+	// Cover kReadaheadCoverDuration of playback at the measured consume
+	// rate. If the network doesn't keep up with playback, pipeline as
+	// many requests as possible instead.
+	const auto consumePerSecond = (_consumedBytesSinceCheck * 1000)
+		/ elapsed;
+	const auto loadPerSecond = (_loadedBytesSinceCheck * 1000) / elapsed;
+	const auto lagging = (loadPerSecond > 0)
+		&& (loadPerSecond < consumePerSecond);
+	const auto desired = lagging
+		? kLoadFromRemoteMax
+		: int(std::clamp(
+			1 + (consumePerSecond * kReadaheadCoverDuration)
+				/ (1000 * int64(kPartSize)),
+			int64(kPreloadPartsAheadMin),
+			int64(kLoadFromRemoteMax)));
+	if (_readaheadParts != desired) {
+		DEBUG_LOG(("Streaming Info: readahead window changed "
+			"%1 -> %2 parts.").arg(_readaheadParts).arg(desired));
+		_readaheadParts = desired;
+	}
+	_readaheadCheckStart = now;
+	_consumedBytesSinceCheck = 0;
+	_loadedBytesSinceCheck = 0;
+}
+
+void Reader::cancelStaleLoads(int offset) {
+	// After a far seek the parts queued for the old position won't be
+	// read any time soon - cancel them so the connection works for the
+	// new playhead first. They will be re-requested if needed again.
+	const auto fromOffset = (offset / kPartSize) * kPartSize;
+	const auto keepTill = fromOffset + kSeekCancelDistance;
+	if (fromOffset > 0) {
+		cancelLoadInRange(0, fromOffset);
+	}
+	if (keepTill < size()) {
+		cancelLoadInRange(keepTill, size());
+	}
+}
+
 bool Reader::processCacheResults() {
 	if (!_cacheHelper) {
 		return false;
@@ -1353,7 +1440,10 @@ bool Reader::processLoadedParts() {
 		if (!part.valid(size())) {
 			_streamingError = Error::LoadFailed;
 			return false;
-		} else if (!_loadingOffsets.remove(part.offset)) {
+		}
+		_loadedBytesSinceCheck += part.bytes.size();
+		_totalLoadedBytes += part.bytes.size();
+		if (!_loadingOffsets.remove(part.offset)) {
 			continue;
 		}
 		_slices.processPart(
@@ -38,6 +38,12 @@ public:
 		WaitingRemote,
 		Failed,
 	};
+	struct PrefetchStats {
+		int readaheadParts = 0;
+		int loadingParts = 0;
+		int64 loadedBytes = 0;
+		int64 consumedBytes = 0;
+	};
 
 	// Main thread.
 	explicit Reader(
@@ -56,6 +62,7 @@ public:
 		bytes::span buffer,
 		not_null<crl::semaphore*> notify);
 	[[nodiscard]] std::optional<Error> streamingError() const;
+	[[nodiscard]] PrefetchStats prefetchStats() const;
 	void headerDone();
 	[[nodiscard]] int headerSize() const;
 	[[nodiscard]] bool fullInCache() const;
@@ -81,7 +88,13 @@ public:
 	~Reader();
 
 private:
-	static constexpr auto kLoadFromRemoteMax = 8;
+	static constexpr auto kLoadFromRemoteMax = 16;
+
+	// The readahead window starts at kPreloadPartsAhead parts and adapts
+	// to the measured playback bitrate and network throughput in between
+	// kPreloadPartsAheadMin and kLoadFromRemoteMax parts.
+	static constexpr auto kPreloadPartsAhead = 8;
+	static constexpr auto kPreloadPartsAheadMin = 2;
 
 	struct CacheHelper;
 
@@ -129,7 +142,7 @@ private:
 
 		void processCacheData(PartsMap &&data);
 		void addPart(int offset, QByteArray bytes);
-		PrepareFillResult prepareFill(int from, int till);
+		PrepareFillResult prepareFill(int from, int till, int aheadParts);
 
 		// Get up to kLoadFromRemoteMax not loaded parts in from-till range.
 		StackIntVector<kLoadFromRemoteMax> offsetsFromLoader(
@@ -160,7 +173,10 @@ private:
 		void processCachedSizes(const std::vector<int> &sizes);
 		void processPart(int offset, QByteArray &&bytes);
 
-		[[nodiscard]] FillResult fill(int offset, bytes::span buffer);
+		[[nodiscard]] FillResult fill(
+			int offset,
+			bytes::span buffer,
+			int aheadParts);
 		[[nodiscard]] SerializedSlice unloadToCache();
 
 		[[nodiscard]] QByteArray partForDownloader(int offset) const;
@@ -187,7 +203,8 @@ private:
 		[[nodiscard]] bool computeIsGoodHeader() const;
 		[[nodiscard]] FillResult fillFromHeader(
 			int offset,
-			bytes::span buffer);
+			bytes::span buffer,
+			int aheadParts);
 		void unloadSlice(Slice &slice) const;
 		void checkSliceFullLoaded(int sliceNumber);
 		[[nodiscard]] bool checkFullInCache() const;
@@ -211,6 +228,8 @@ private:
 	void cancelLoadInRange(int from, int till);
 	void loadAtOffset(int offset);
 	void checkLoadWillBeFirst(int offset);
+	void refreshReadaheadParts();
+	void cancelStaleLoads(int offset);
 	bool processLoadedParts();
 
 	bool checkForSomethingMoreReceived();
@@ -261,6 +280,13 @@ private:
 	bool _streamingActive = false;
 
 	// Streaming thread.
+	crl::time _readaheadCheckStart = 0;
+	int64 _loadedBytesSinceCheck = 0;
+	int64 _consumedBytesSinceCheck = 0;
+	int64 _totalLoadedBytes = 0;
+	int64 _totalConsumedBytes = 0;
+	int _readaheadParts = kPreloadPartsAhead;
+	int _lastFillOffset = -1;
 	std::deque<int> _offsetsForDownloader;
 	base::flat_set<int> _downloaderOffsetsRequested;
 	base::flat_map<int, std::optional<PartsMap>> _downloaderReadCache;
@@ -17,6 +17,96 @@ namespace {
 
 constexpr auto kSkipInvalidDataPackets = 10;
 
+// Conversion of large frames is split into horizontal bands converted
+// in parallel on the crl::async pool, each through its own SwsContext.
+constexpr auto kSliceConvertMinHeight = 540;
+constexpr auto kConvertSlices = 4;
+
+[[nodiscard]] bool CanConvertInSlices(
+		not_null<AVFrame*> frame,
+		QSize resize) {
+	// Only planar 4:2:0 without rescaling - then each even-aligned band
+	// converts independently of its neighbours.
+	return (frame->format == AV_PIX_FMT_YUV420P
+		|| frame->format == AV_PIX_FMT_YUVJ420P)
+		&& (resize == QSize(frame->width, frame->height))
+		&& (frame->height >= kSliceConvertMinHeight);
+}
+
+[[nodiscard]] bool ConvertFrameInSlices(
+		Stream &stream,
+		not_null<AVFrame*> frame,
+		QImage &storage) {
+	const auto width = frame->width;
+	const auto height = frame->height;
+	const auto bandHeight = ((height / kConvertSlices) + 1) & ~1;
+	stream.swscaleSlices.resize(kConvertSlices);
+
+	// Detach the storage once, the workers share the resulting bits.
+	const auto bits = storage.bits();
+	const auto perLine = int(storage.bytesPerLine());
+	const auto convertBand = [&](int index, int from, int till) {
+		const auto rows = till - from;
+		auto &context = stream.swscaleSlices[index];
+		context = FFmpeg::MakeSwscalePointer(
+			QSize(width, rows),
+			frame->format,
+			QSize(width, rows),
+			AV_PIX_FMT_BGRA,
+			&context);
+		if (!context) {
+			return false;
+		}
+		const uint8_t *data[AV_NUM_DATA_POINTERS] = {
+			frame->data[0] + from * frame->linesize[0],
+			frame->data[1] + (from / 2) * frame->linesize[1],
+			frame->data[2] + (from / 2) * frame->linesize[2],
+			nullptr,
+		};
+		uint8_t *dst[AV_NUM_DATA_POINTERS] = {
+			bits + from * perLine,
+			nullptr,
+		};
+		int dstLinesize[AV_NUM_DATA_POINTERS] = { perLine, 0 };
+		sws_scale(
+			context.get(),
+			data,
+			frame->linesize,
+			0,
+			rows,
+			dst,
+			dstLinesize);
+		return true;
+	};
+
+	auto semaphore = crl::semaphore();
+	auto good = std::atomic<bool>(true);
+	auto spawned = 0;
+	for (auto index = 1; index != kConvertSlices; ++index) {
+		const auto from = index * bandHeight;
+		const auto till = (index + 1 == kConvertSlices)
+			? height
+			: std::min(from + bandHeight, height);
+		if (from >= till) {
+			break;
+		}
+		crl::async([&, index, from, till] {
+			if (!convertBand(index, from, till)) {
+				good = false;
+			}
+			semaphore.release();
+		});
+		++spawned;
+	}
+	if (!convertBand(0, 0, std::min(bandHeight, height))) {
+		good = false;
+	}
+	while (spawned-- > 0) {
+		semaphore.acquire();
+	}
+	return good;
+}
+
 } // namespace
 
 crl::time FramePosition(const Stream &stream) {
@@ -167,6 +257,10 @@ QImage ConvertFrame(
 			to += deltaTo;
 			from += deltaFrom;
 		}
+	} else if (CanConvertInSlices(frame, resize)
+		&& ConvertFrameInSlices(stream, frame, storage)) {
+		FFmpeg::ClearFrameMemory(frame);
+		return storage;
 	} else {
 		stream.swscale = MakeSwscalePointer(
 			frame,
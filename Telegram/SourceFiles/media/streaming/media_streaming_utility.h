@@ -42,6 +42,7 @@ struct Stream {
 	int rotation = 0;
 	AVRational aspect = FFmpeg::kNormalAspect;
 	FFmpeg::SwscalePointer swscale;
+	std::vector<FFmpeg::SwscalePointer> swscaleSlices;
 };
 
 [[nodiscard]] crl::time FramePosition(const Stream &stream);
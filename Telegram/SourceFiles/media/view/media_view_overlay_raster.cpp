@@ -91,7 +91,35 @@ void OverlayWidget::RendererSW::paintTransformedStaticContent(
 	if (image.isNull()) {
 		return;
 	}
-	paintTransformedImage(image, rect, rotation);
+	paintTransformedImage(
+		downscaledStaticContent(image, rect, rotation),
+		rect,
+		rotation);
+}
+
+QImage OverlayWidget::RendererSW::downscaledStaticContent(
+		const QImage &image,
+		QRect rect,
+		int rotation) {
+	const auto transposed = (rotation == 90) || (rotation == 270);
+	const auto wanted = (transposed
+		? QSize(rect.height(), rect.width())
+		: rect.size()) * cIntRetinaFactor();
+	if (wanted.isEmpty()
+		|| image.width() < 2 * wanted.width()
+		|| image.height() < 2 * wanted.height()) {
+		return image;
+	}
+	if (_downscaledContentKey != image.cacheKey()
+		|| _downscaledContent.size() != wanted) {
+		_downscaledContent = image.scaled(
+			wanted,
+			Qt::IgnoreAspectRatio,
+			Qt::SmoothTransformation);
+		_downscaledContent.setDevicePixelRatio(cRetinaFactor());
+		_downscaledContentKey = image.cacheKey();
+	}
+	return _downscaledContent;
 }
 
 void OverlayWidget::RendererSW::paintTransformedImage(
@@ -32,6 +32,10 @@ private:
 		const QImage &image,
 		QRect rect,
 		int rotation);
+	[[nodiscard]] QImage downscaledStaticContent(
+		const QImage &image,
+		QRect rect,
+		int rotation);
 	void paintRadialLoading(
 		QRect inner,
 		bool radial,
@@ -60,6 +64,12 @@ private:
 	const QRegion *_clip = nullptr;
 	QRect _clipOuter;
 
+	// Smooth-scaling a huge photo into the viewport on every paint
+	// makes panning unbearably slow, so the content downscaled to the
+	// shown size is cached here and the paints just blit it.
+	QImage _downscaledContent;
+	qint64 _downscaledContentKey = 0;
+
 };
 
 } // namespace Media::View
@@ -18,6 +18,8 @@ namespace MTP {
 namespace details {
 namespace {
 
+constexpr auto kMaxPooledPacketBuffers = 4;
+
 std::atomic<int> GlobalConnectionCounter/* = 0*/;
 
 } // namespace
@@ -82,11 +84,28 @@ ConnectionPointer::~ConnectionPointer() {
 	reset();
 }
 
+mtpBuffer AbstractConnection::takePacketBuffer(uint32 reserveSize) const {
+	auto result = mtpBuffer();
+	if (!_packetBufferPool.empty()) {
+		result = std::move(_packetBufferPool.back());
+		_packetBufferPool.pop_back();
+		result.resize(0);
+	}
+	result.reserve(reserveSize);
+	return result;
+}
+
+void AbstractConnection::recyclePacketBuffer(mtpBuffer &&buffer) const {
+	if (_packetBufferPool.size() < kMaxPooledPacketBuffers) {
+		buffer.resize(0);
+		_packetBufferPool.push_back(std::move(buffer));
+	}
+}
+
 mtpBuffer AbstractConnection::prepareSecurePacket(
 		uint64 keyId,
 		MTPint128 msgKey,
 		uint32 size) const {
-	auto result = mtpBuffer();
 	constexpr auto kTcpPrefixInts = 2;
 	constexpr auto kAuthKeyIdPosition = kTcpPrefixInts;
 	constexpr auto kAuthKeyIdInts = 2;
@@ -97,7 +116,7 @@ mtpBuffer AbstractConnection::prepareSecurePacket(
 		+ kAuthKeyIdInts
 		+ kMessageKeyInts;
 	constexpr auto kTcpPostfixInts = 4;
-	result.reserve(kPrefixInts + size + kTcpPostfixInts);
+	auto result = takePacketBuffer(kPrefixInts + size + kTcpPostfixInts);
 	result.resize(kPrefixInts);
 	*reinterpret_cast<uint64*>(&result[kAuthKeyIdPosition]) = keyId;
 	*reinterpret_cast<MTPint128*>(&result[kMessageKeyPosition]) = msgKey;
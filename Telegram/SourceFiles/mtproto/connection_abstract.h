@@ -124,6 +124,12 @@ public:
 	[[nodiscard]] gsl::span<const mtpPrime> parseNotSecureResponse(
 		const mtpBuffer &buffer) const;
 
+	// Packet buffers are allocated through these so that a buffer already
+	// written to the socket can be reused for the next packet instead of
+	// being freed and allocated again on every send.
+	[[nodiscard]] mtpBuffer takePacketBuffer(uint32 reserveSize) const;
+	void recyclePacketBuffer(mtpBuffer &&buffer) const;
+
 	[[nodiscard]] static QString ProtocolDcDebugId(int16 protocolDcId);
 	[[nodiscard]] QString debugId() const {
 		return _debugId;
@@ -162,6 +168,7 @@ private:
 	[[nodiscard]] uint32 extendedNotSecurePadding() const;
 
 	uint64 _sentEncryptedWithKeyId = 0;
+	mutable std::vector<mtpBuffer> _packetBufferPool;
 
 };
 
@@ -172,7 +179,6 @@ mtpBuffer AbstractConnection::prepareNotSecurePacket(
 	const auto intsSize = tl::count_length(request) >> 2;
 	const auto intsPadding = extendedNotSecurePadding();
 
-	auto result = mtpBuffer();
 	constexpr auto kTcpPrefixInts = 2;
 	constexpr auto kAuthKeyIdInts = 2;
 	constexpr auto kMessageIdInts = 2;
@@ -183,7 +189,8 @@ mtpBuffer AbstractConnection::prepareNotSecurePacket(
 		+ kMessageLengthInts;
 	constexpr auto kTcpPostfixInts = 4;
 
-	result.reserve(kPrefixInts + intsSize + intsPadding + kTcpPostfixInts);
+	auto result = takePacketBuffer(
+		kPrefixInts + intsSize + intsPadding + kTcpPostfixInts);
 	result.resize(kPrefixInts);
 
 	const auto messageId = &result[kTcpPrefixInts + kAuthKeyIdInts];
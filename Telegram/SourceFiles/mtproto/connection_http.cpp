@@ -45,6 +45,7 @@ void HttpConnection::sendData(mtpBuffer &&buffer) {
 
 	CONNECTION_LOG_INFO(u"Sending %1 len request."_q.arg(requestSize));
 	_requests.insert(_manager.post(request, QByteArray((const char*)(&buffer[2]), requestSize)));
+	recyclePacketBuffer(std::move(buffer));
 }
 
 void HttpConnection::disconnectFromServer() {
@@ -441,6 +441,7 @@ void TcpConnection::sendData(mtpBuffer &&buffer) {
 		.arg(bytes.size()));
 	aesCtrEncrypt(bytes, _sendKey, &_sendState);
 	_socket->write(connectionStartPrefix, bytes);
+	recyclePacketBuffer(std::move(buffer));
 }
 
 bytes::const_span TcpConnection::prepareConnectionStartPrefix(
@@ -135,7 +135,10 @@ private:
 	void gotPart(int offset, const MTPupload_File &result);
 	Fn<void(const Error &)> failHandler();
 
-	static constexpr auto kRequestsCount = 2;
+	// Two in-flight parts capped throughput at 256 KB per round trip,
+	// which on high-latency links stretched emoji set and dictionary
+	// downloads to minutes; eight parts keep the pipe full instead.
+	static constexpr auto kRequestsCount = 8;
 	static constexpr auto kNextRequestDelay = crl::time(20);
 
 	std::deque<Request> _requests;
@@ -0,0 +1,276 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/details/mtproto_aes_ige.h"
+
+#include "base/openssl_help.h"
+
+#if defined Q_PROCESSOR_X86
+#include <immintrin.h>
+#if defined Q_CC_MSVC
+#include <intrin.h>
+#endif // Q_CC_MSVC
+#endif // Q_PROCESSOR_X86
+
+namespace MTP::details {
+namespace {
+
+using IgeFunction = void (*)(
+	const uchar *src,
+	uchar *dst,
+	uint32 len,
+	const uchar *key,
+	const uchar *iv);
+
+void AesIgeEncryptSoftware(
+		const uchar *src,
+		uchar *dst,
+		uint32 len,
+		const uchar *key,
+		const uchar *iv) {
+	uchar aes_iv[32];
+	memcpy(aes_iv, iv, 32);
+
+	AES_KEY aes;
+	AES_set_encrypt_key(key, 256, &aes);
+	AES_ige_encrypt(src, dst, len, &aes, aes_iv, AES_ENCRYPT);
+}
+
+void AesIgeDecryptSoftware(
+		const uchar *src,
+		uchar *dst,
+		uint32 len,
+		const uchar *key,
+		const uchar *iv) {
+	uchar aes_iv[32];
+	memcpy(aes_iv, iv, 32);
+
+	AES_KEY aes;
+	AES_set_decrypt_key(key, 256, &aes);
+	AES_ige_encrypt(src, dst, len, &aes, aes_iv, AES_DECRYPT);
+}
+
+#if defined Q_PROCESSOR_X86
+
+#if defined Q_CC_MSVC
+#define AES_IGE_TARGET_AESNI
+#else // Q_CC_MSVC
+#define AES_IGE_TARGET_AESNI __attribute__((target("aes,sse2")))
+#endif // !Q_CC_MSVC
+
+// 15 round keys of AES-256, [0] is the whitening key.
+struct Aes256Schedule {
+	__m128i rounds[15];
+};
+
+AES_IGE_TARGET_AESNI inline __m128i ExpandStepEven(
+		__m128i previous,
+		__m128i assist) {
+	assist = _mm_shuffle_epi32(assist, 0xff);
+	previous = _mm_xor_si128(previous, _mm_slli_si128(previous, 4));
+	previous = _mm_xor_si128(previous, _mm_slli_si128(previous, 4));
+	previous = _mm_xor_si128(previous, _mm_slli_si128(previous, 4));
+	return _mm_xor_si128(previous, assist);
+}
+
+AES_IGE_TARGET_AESNI inline __m128i ExpandStepOdd(
+		__m128i previous,
+		__m128i even) {
+	const auto assist = _mm_shuffle_epi32(
+		_mm_aeskeygenassist_si128(even, 0),
+		0xaa);
+	previous = _mm_xor_si128(previous, _mm_slli_si128(previous, 4));
+	previous = _mm_xor_si128(previous, _mm_slli_si128(previous, 4));
+	previous = _mm_xor_si128(previous, _mm_slli_si128(previous, 4));
+	return _mm_xor_si128(previous, assist);
+}
+
+AES_IGE_TARGET_AESNI void ExpandEncryptKey(
+		const uchar *key,
+		Aes256Schedule &to) {
+	auto &rounds = to.rounds;
+	rounds[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+	rounds[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16));
+#define TDESKTOP_AES_EXPAND(i, rcon) \
+	rounds[i] = ExpandStepEven( \
+		rounds[i - 2], \
+		_mm_aeskeygenassist_si128(rounds[i - 1], rcon)); \
+	rounds[i + 1] = ExpandStepOdd(rounds[i - 1], rounds[i]);
+	TDESKTOP_AES_EXPAND(2, 0x01);
+	TDESKTOP_AES_EXPAND(4, 0x02);
+	TDESKTOP_AES_EXPAND(6, 0x04);
+	TDESKTOP_AES_EXPAND(8, 0x08);
+	TDESKTOP_AES_EXPAND(10, 0x10);
+	TDESKTOP_AES_EXPAND(12, 0x20);
+#undef TDESKTOP_AES_EXPAND
+	rounds[14] = ExpandStepEven(
+		rounds[12],
+		_mm_aeskeygenassist_si128(rounds[13], 0x40));
+}
+
+AES_IGE_TARGET_AESNI void ExpandDecryptKey(
+		const uchar *key,
+		Aes256Schedule &to) {
+	auto encrypt = Aes256Schedule();
+	ExpandEncryptKey(key, encrypt);
+	to.rounds[0] = encrypt.rounds[14];
+	for (auto i = 1; i != 14; ++i) {
+		to.rounds[i] = _mm_aesimc_si128(encrypt.rounds[14 - i]);
+	}
+	to.rounds[14] = encrypt.rounds[0];
+}
+
+AES_IGE_TARGET_AESNI inline __m128i EncryptBlock(
+		const Aes256Schedule &schedule,
+		__m128i block) {
+	block = _mm_xor_si128(block, schedule.rounds[0]);
+	for (auto i = 1; i != 14; ++i) {
+		block = _mm_aesenc_si128(block, schedule.rounds[i]);
+	}
+	return _mm_aesenclast_si128(block, schedule.rounds[14]);
+}
+
+AES_IGE_TARGET_AESNI inline __m128i DecryptBlock(
+		const Aes256Schedule &schedule,
+		__m128i block) {
+	block = _mm_xor_si128(block, schedule.rounds[0]);
+	for (auto i = 1; i != 14; ++i) {
+		block = _mm_aesdec_si128(block, schedule.rounds[i]);
+	}
+	return _mm_aesdeclast_si128(block, schedule.rounds[14]);
+}
+
+// IGE chains both the previous ciphertext and the previous plaintext
+// into each block, so the stream can't be pipelined or multi-buffered,
+// the win here is the hardware round function itself.
+AES_IGE_TARGET_AESNI void AesIgeEncryptHardware(
+		const uchar *src,
+		uchar *dst,
+		uint32 len,
+		const uchar *key,
+		const uchar *iv) {
+	auto schedule = Aes256Schedule();
+	ExpandEncryptKey(key, schedule);
+	auto chainC = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+	auto chainP = _mm_loadu_si128(
+		reinterpret_cast<const __m128i*>(iv + 16));
+	for (auto offset = uint32(0); offset != len; offset += 16) {
+		const auto plain = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(src + offset));
+		const auto cipher = _mm_xor_si128(
+			EncryptBlock(schedule, _mm_xor_si128(plain, chainC)),
+			chainP);
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i*>(dst + offset),
+			cipher);
+		chainC = cipher;
+		chainP = plain;
+	}
+}
+
+AES_IGE_TARGET_AESNI void AesIgeDecryptHardware(
+		const uchar *src,
+		uchar *dst,
+		uint32 len,
+		const uchar *key,
+		const uchar *iv) {
+	auto schedule = Aes256Schedule();
+	ExpandDecryptKey(key, schedule);
+	auto chainC = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+	auto chainP = _mm_loadu_si128(
+		reinterpret_cast<const __m128i*>(iv + 16));
+	for (auto offset = uint32(0); offset != len; offset += 16) {
+		const auto cipher = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(src + offset));
+		const auto plain = _mm_xor_si128(
+			DecryptBlock(schedule, _mm_xor_si128(cipher, chainP)),
+			chainC);
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i*>(dst + offset),
+			plain);
+		chainC = cipher;
+		chainP = plain;
+	}
+}
+
+[[nodiscard]] bool CpuHasAesNi() {
+#if defined Q_CC_MSVC
+	int data[4] = { 0 };
+	__cpuid(data, 1);
+	return (data[2] & (1 << 25)) != 0;
+#else // Q_CC_MSVC
+	return __builtin_cpu_supports("aes");
+#endif // !Q_CC_MSVC
+}
+
+#endif // Q_PROCESSOR_X86
+
+[[nodiscard]] bool ChooseHardware() {
+#if defined Q_PROCESSOR_X86
+	return CpuHasAesNi();
+#else // Q_PROCESSOR_X86
+	return false;
+#endif // !Q_PROCESSOR_X86
+}
+
+[[nodiscard]] IgeFunction SelectedEncrypt() {
+#if defined Q_PROCESSOR_X86
+	static const auto result = ChooseHardware()
+		? AesIgeEncryptHardware
+		: AesIgeEncryptSoftware;
+	return result;
+#else // Q_PROCESSOR_X86
+	return AesIgeEncryptSoftware;
+#endif // !Q_PROCESSOR_X86
+}
+
+[[nodiscard]] IgeFunction SelectedDecrypt() {
+#if defined Q_PROCESSOR_X86
+	static const auto result = ChooseHardware()
+		? AesIgeDecryptHardware
+		: AesIgeDecryptSoftware;
+	return result;
+#else // Q_PROCESSOR_X86
+	return AesIgeDecryptSoftware;
+#endif // !Q_PROCESSOR_X86
+}
+
+} // namespace
+
+void AesIgeEncrypt(
+		const void *src,
+		void *dst,
+		uint32 len,
+		const void *key,
+		const void *iv) {
+	SelectedEncrypt()(
+		static_cast<const uchar*>(src),
+		static_cast<uchar*>(dst),
+		len,
+		static_cast<const uchar*>(key),
+		static_cast<const uchar*>(iv));
+}
+
+void AesIgeDecrypt(
+		const void *src,
+		void *dst,
+		uint32 len,
+		const void *key,
+		const void *iv) {
+	SelectedDecrypt()(
+		static_cast<const uchar*>(src),
+		static_cast<uchar*>(dst),
+		len,
+		static_cast<const uchar*>(key),
+		static_cast<const uchar*>(iv));
+}
+
+bool AesIgeHardwareAvailable() {
+	return ChooseHardware();
+}
+
+} // namespace MTP::details
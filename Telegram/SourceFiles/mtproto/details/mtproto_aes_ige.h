@@ -0,0 +1,33 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace MTP::details {
+
+// AES-256-IGE with an AES-NI fast path chosen once at runtime. OpenSSL
+// keeps IGE out of EVP, so AES_ige_encrypt always runs the software
+// tables - on upload-sized parts the hardware path is several times
+// faster. The key is 32 bytes, the iv is 32 bytes, len is in bytes and
+// must be a multiple of the 16 byte block.
+void AesIgeEncrypt(
+	const void *src,
+	void *dst,
+	uint32 len,
+	const void *key,
+	const void *iv);
+void AesIgeDecrypt(
+	const void *src,
+	void *dst,
+	uint32 len,
+	const void *key,
+	const void *iv);
+
+// Whether the hardware path is used, for logging and benchmarks.
+[[nodiscard]] bool AesIgeHardwareAvailable();
+
+} // namespace MTP::details
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/connection_abstract.h"
 #include "mtproto/mtproto_dh_utils.h"
 #include "base/openssl_help.h"
+#include "base/invoke_queued.h"
 #include "base/random.h"
 #include "base/unixtime.h"
 #include "scheme.h"
@@ -387,10 +388,13 @@ DcKeyCreator::DcKeyCreator(
 , _dcId(dcId)
 , _protocolDcId(protocolDcId)
 , _request(request)
-, _delegate(std::move(delegate)) {
+, _delegate(std::move(delegate))
+, _guard(std::make_shared<LivenessGuard>()) {
 	Expects(_request.temporaryExpiresIn > 0);
 	Expects(_delegate.done != nullptr);
 
+	_guard->creator = this;
+
 	QObject::connect(_connection, &AbstractConnection::receivedData, [=] {
 		answered();
 	});
@@ -403,6 +407,10 @@ DcKeyCreator::DcKeyCreator(
 }
 
 DcKeyCreator::~DcKeyCreator() {
+	{
+		QMutexLocker lock(&_guard->mutex);
+		_guard->creator = nullptr;
+	}
 	if (_delegate.done) {
 		stopReceiving();
 	}
@@ -701,21 +709,65 @@ void DcKeyCreator::dhClientParamsSend(not_null<Attempt*> attempt) {
 		return failed();
 	}
 
-	// gen rand 'b'
-	auto randomSeed = bytes::vector(ModExpFirst::kRandomPowerSize);
-	bytes::set_random(randomSeed);
-	auto g_b_data = CreateModExp(attempt->data.g, attempt->dhPrime, randomSeed);
-	if (g_b_data.modexp.empty()) {
+	// The 2048-bit modexp-s below eat almost all of the handshake CPU
+	// time, so they are computed on a worker thread. Otherwise handshakes
+	// of different data centers, that share a single session thread,
+	// would run their crypto strictly one after another on first login.
+	const auto guard = _guard;
+	const auto connection = _connection;
+	crl::async([
+			guard,
+			connection,
+			attempt = attempt.get(),
+			g = attempt->data.g,
+			dhPrime = attempt->dhPrime,
+			g_a = attempt->g_a] {
+		// gen rand 'b'
+		auto randomSeed = bytes::vector(ModExpFirst::kRandomPowerSize);
+		bytes::set_random(randomSeed);
+		auto g_b_data = CreateModExp(g, dhPrime, randomSeed);
+		auto authKey = g_b_data.modexp.empty()
+			? bytes::vector()
+			: CreateAuthKey(g_a, g_b_data.randomPower, dhPrime);
+
+		QMutexLocker lock(&guard->mutex);
+		if (!guard->creator) {
+			return;
+		}
+
+		// While the creator is alive the connection is alive as well,
+		// so the result can be posted back to the session thread.
+		InvokeQueued(connection, [
+				guard,
+				attempt,
+				g_b = std::move(g_b_data.modexp),
+				authKey = std::move(authKey)]() mutable {
+			QMutexLocker lock(&guard->mutex);
+			const auto creator = guard->creator;
+			lock.unlock();
+			if (creator) {
+				creator->dhClientParamsComputed(
+					attempt,
+					std::move(g_b),
+					std::move(authKey));
+			}
+		});
+	});
+}
+
+void DcKeyCreator::dhClientParamsComputed(
+		not_null<Attempt*> attempt,
+		bytes::vector &&g_b,
+		bytes::vector &&authKey) {
+	if (g_b.empty()) {
 		LOG(("AuthKey Error: could not generate good g_b."));
 		return failed();
 	}
-
-	auto computedAuthKey = CreateAuthKey(attempt->g_a, g_b_data.randomPower, attempt->dhPrime);
-	if (computedAuthKey.empty()) {
+	if (authKey.empty()) {
 		LOG(("AuthKey Error: could not generate auth_key."));
 		return failed();
 	}
-	AuthKey::FillData(attempt->authKey, computedAuthKey);
+	AuthKey::FillData(attempt->authKey, authKey);
 
 	auto auth_key_sha = openssl::Sha1(attempt->authKey);
 	memcpy(&attempt->data.auth_key_aux_hash.v, auth_key_sha.data(), 8);
@@ -725,7 +777,7 @@ void DcKeyCreator::dhClientParamsSend(not_null<Attempt*> attempt) {
 		attempt->data.nonce,
 		attempt->data.server_nonce,
 		attempt->data.retry_id,
-		MTP_bytes(g_b_data.modexp));
+		MTP_bytes(g_b));
 
 	auto sdhEncString = EncryptClientDHInner(
 		client_dh_inner,
@@ -13,6 +13,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/basic_types.h"
 #include "base/expected.h"
 
+#include <QtCore/QMutex>
+
 namespace MTP {
 class DcOptions;
 } // namespace MTP
@@ -95,6 +97,14 @@ private:
 		Stage stage = Stage::None;
 	};
 
+	// The client DH values are computed on a worker thread, this guard
+	// lets the result callback check that the creator is still alive
+	// (compare SessionData::withSession).
+	struct LivenessGuard {
+		QMutex mutex;
+		DcKeyCreator *creator = nullptr;
+	};
+
 	template <typename RequestType>
 	void sendNotSecureRequest(const RequestType &request);
 
@@ -116,6 +126,10 @@ private:
 		not_null<Attempt*> attempt,
 		const MTPserver_DH_Params &data);
 	void dhClientParamsSend(not_null<Attempt*> attempt);
+	void dhClientParamsComputed(
+		not_null<Attempt*> attempt,
+		bytes::vector &&g_b,
+		bytes::vector &&authKey);
 	void dhClientParamsAnswered(
 		not_null<Attempt*> attempt,
 		const MTPset_client_DH_params_answer &data);
@@ -134,6 +148,8 @@ private:
 	Attempt _temporary;
 	Attempt _persistent;
 
+	const std::shared_ptr<LivenessGuard> _guard;
+
 };
 
 } // namespace MTP::details
@@ -104,6 +104,7 @@ public:
 	[[nodiscard]] int32 dcstate(ShiftedDcId shiftedDcId = 0);
 	[[nodiscard]] QString dctransport(ShiftedDcId shiftedDcId = 0);
 	void ping();
+	void keepWarm(ShiftedDcId shiftedDcId);
 	void cancel(mtpRequestId requestId);
 	[[nodiscard]] int32 state(mtpRequestId requestId); // < 0 means waiting for such count of ms
 	void killSession(ShiftedDcId shiftedDcId);
@@ -256,25 +257,25 @@ private:
 	rpl::event_stream<> _allKeysDestroyed;
 
 	// holds dcWithShift for request to this dc or -dc for request to main dc
-	std::map<mtpRequestId, ShiftedDcId> _requestsByDc;
+	base::flat_map<mtpRequestId, ShiftedDcId> _requestsByDc;
 	mutable QMutex _requestByDcLock;
 
 	// holds target dcWithShift for auth export request
-	std::map<mtpRequestId, ShiftedDcId> _authExportRequests;
+	base::flat_map<mtpRequestId, ShiftedDcId> _authExportRequests;
 
-	std::map<mtpRequestId, ResponseHandler> _parserMap;
+	base::flat_map<mtpRequestId, ResponseHandler> _parserMap;
 	mutable QMutex _parserMapLock;
 
-	std::map<mtpRequestId, SerializedRequest> _requestMap;
+	base::flat_map<mtpRequestId, SerializedRequest> _requestMap;
 	QReadWriteLock _requestMapLock;
 
 	std::deque<std::pair<mtpRequestId, crl::time>> _delayedRequests;
 	base::flat_map<mtpRequestId, mtpRequestId> _dependentRequests;
 	mutable QMutex _dependentRequestsLock;
 
-	std::map<mtpRequestId, int> _requestsDelays;
+	base::flat_map<mtpRequestId, int> _requestsDelays;
 
-	std::set<mtpRequestId> _badGuestDcRequests;
+	base::flat_set<mtpRequestId> _badGuestDcRequests;
 
 	std::map<DcId, std::vector<mtpRequestId>> _authWaiters;
 
@@ -641,6 +642,14 @@ void Instance::Private::ping() {
 	getSession(0)->ping();
 }
 
+void Instance::Private::keepWarm(ShiftedDcId shiftedDcId) {
+	Expects(BareDcId(shiftedDcId) != 0);
+
+	// Establishes the session and its transport if they don't exist yet,
+	// so that a request sent there later finds a ready connection.
+	getSession(shiftedDcId)->ping();
+}
+
 void Instance::Private::cancel(mtpRequestId requestId) {
 	if (!requestId) return;
 
@@ -662,7 +671,7 @@ void Instance::Private::cancel(mtpRequestId requestId) {
 	}
 
 	QMutexLocker locker(&_parserMapLock);
-	_parserMap.erase(requestId);
+	_parserMap.remove(requestId);
 }
 
 // result < 0 means waiting for such count of ms.
@@ -1030,15 +1039,15 @@ void Instance::Private::registerRequest(
 void Instance::Private::unregisterRequest(mtpRequestId requestId) {
 	DEBUG_LOG(("MTP Info: unregistering request %1.").arg(requestId));
 
-	_requestsDelays.erase(requestId);
+	_requestsDelays.remove(requestId);
 
 	{
 		QWriteLocker locker(&_requestMapLock);
-		_requestMap.erase(requestId);
+		_requestMap.remove(requestId);
 	}
 	{
 		QMutexLocker locker(&_requestByDcLock);
-		_requestsByDc.erase(requestId);
+		_requestsByDc.remove(requestId);
 	}
 	{
 		auto toRemove = base::flat_set<mtpRequestId>();
@@ -1313,7 +1322,7 @@ void Instance::Private::exportDone(
 	}, [this](const Error &error, const Response &response) {
 		return importFail(error, response);
 	}, it->second);
-	_authExportRequests.erase(response.requestId);
+	_authExportRequests.remove(response.requestId);
 }
 
 bool Instance::Private::exportFail(
@@ -1542,7 +1551,7 @@ bool Instance::Private::onErrorDefault(
 	} else if (type == qstr("CONNECTION_LANG_CODE_INVALID")) {
 		Lang::CurrentCloudManager().resetToDefault();
 	}
-	if (badGuestDc) _badGuestDcRequests.erase(requestId);
+	if (badGuestDc) _badGuestDcRequests.remove(requestId);
 	return false;
 }
 
@@ -1892,6 +1901,10 @@ void Instance::ping() {
 	_private->ping();
 }
 
+void Instance::keepWarm(ShiftedDcId shiftedDcId) {
+	_private->keepWarm(shiftedDcId);
+}
+
 void Instance::cancel(mtpRequestId requestId) {
 	_private->cancel(requestId);
 }
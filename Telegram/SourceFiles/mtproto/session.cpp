@@ -327,7 +327,13 @@ void Session::needToResumeAndSend() {
 	}
 	const auto captured = _private;
 	const auto ping = base::take(_ping);
+	const auto queued = _resumeAndSendQueued;
+	if (!ping && queued->exchange(true)) {
+		// A tryToSend() is already queued and will pick this up as well.
+		return;
+	}
 	InvokeQueued(captured, [=] {
+		queued->store(false);
 		if (ping) {
 			captured->sendPingForce();
 		} else {
@@ -569,6 +575,9 @@ void Session::killConnection() {
 		return;
 	}
 
+	// Events queued for the dying SessionPrivate are dropped with it.
+	_resumeAndSendQueued->store(false);
+
 	base::take(_private)->deleteLater();
 
 	Ensures(_private == nullptr);
@@ -203,6 +203,12 @@ private:
 	bool _killed = false;
 	bool _needToReceive = false;
 
+	// Shared with the queued tryToSend() call, so several requests sent
+	// in a row wake the SessionPrivate thread with one event, not one
+	// event per request.
+	const std::shared_ptr<std::atomic<bool>> _resumeAndSendQueued
+		= std::make_shared<std::atomic<bool>>(false);
+
 	AuthKeyPtr _dcKeyForCheck;
 	CreatingKeyType _myKeyCreation = CreatingKeyType();
 
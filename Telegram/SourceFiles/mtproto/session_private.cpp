@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/openssl_help.h"
 #include "base/unixtime.h"
 #include "base/platform/base_platform_info.h"
+#include "core/perf_trace.h"
 #include "zlib.h"
 
 namespace MTP {
@@ -1237,6 +1238,7 @@ void SessionPrivate::requestCDNConfig() {
 void SessionPrivate::handleReceived() {
 	Expects(_encryptionKey != nullptr);
 
+	TRACE_SCOPE("SessionPrivate::handleReceived");
 	onReceivedSome();
 
 	while (!_connection->received().empty()) {
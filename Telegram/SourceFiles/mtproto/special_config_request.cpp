@@ -22,6 +22,13 @@ namespace MTP::details {
 namespace {
 
 constexpr auto kSendNextTimeout = crl::time(800);
+constexpr auto kParallelRequests = 2;
+
+// The kind of attempt that provided a valid config most recently. The
+// next request races it first, so that a reconnect after suspend on the
+// same network goes straight to the probe known to work there instead
+// of walking the whole list with a timeout between the steps.
+auto LastSuccessfulType = -1;
 
 constexpr auto kPublicKey = "\
 -----BEGIN RSA PUBLIC KEY-----\n\
@@ -243,7 +250,19 @@ SpecialConfigRequest::SpecialConfigRequest(
 	}
 	ranges::reverse(_attempts); // We go from last to first.
 
-	sendNextRequest();
+	if (LastSuccessfulType >= 0) {
+		const auto i = ranges::find(
+			_attempts,
+			static_cast<Type>(LastSuccessfulType),
+			&Attempt::type);
+		if (i != end(_attempts)) {
+			std::rotate(i, i + 1, end(_attempts));
+		}
+	}
+
+	for (auto i = 0; i != kParallelRequests && !_attempts.empty(); ++i) {
+		sendNextRequest();
+	}
 }
 
 SpecialConfigRequest::SpecialConfigRequest(
@@ -388,17 +407,17 @@ void SpecialConfigRequest::requestFinished(
 	case Type::Mozilla:
 	case Type::Google: {
 		constexpr auto kTypeRestriction = 16; // TXT
-		handleResponse(ConcatenateDnsTxtFields(
+		handleResponse(type, ConcatenateDnsTxtFields(
 			ParseDnsResponse(result, kTypeRestriction)));
 	} break;
 	case Type::RemoteConfig: {
-		handleResponse(ParseRemoteConfigResponse(result));
+		handleResponse(type, ParseRemoteConfigResponse(result));
 	} break;
 	case Type::Realtime: {
-		handleResponse(ParseRealtimeResponse(result));
+		handleResponse(type, ParseRealtimeResponse(result));
 	} break;
 	case Type::FireStore: {
-		handleResponse(ParseFireStoreResponse(result));
+		handleResponse(type, ParseFireStoreResponse(result));
 	} break;
 	default: Unexpected("Type in SpecialConfigRequest::requestFinished.");
 	}
@@ -486,10 +505,11 @@ bool SpecialConfigRequest::decryptSimpleConfig(const QByteArray &bytes) {
 	return true;
 }
 
-void SpecialConfigRequest::handleResponse(const QByteArray &bytes) {
+void SpecialConfigRequest::handleResponse(Type type, const QByteArray &bytes) {
 	if (!decryptSimpleConfig(bytes)) {
 		return;
 	}
+	LastSuccessfulType = static_cast<int>(type);
 	Assert(_simpleConfig.type() == mtpc_help_configSimple);
 	const auto &config = _simpleConfig.c_help_configSimple();
 	const auto now = base::unixtime::http_now();
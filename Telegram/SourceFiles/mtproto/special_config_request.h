@@ -60,7 +60,7 @@ private:
 	void requestFinished(Type type, not_null<QNetworkReply*> reply);
 	void handleHeaderUnixtime(not_null<QNetworkReply*> reply);
 	QByteArray finalizeRequest(not_null<QNetworkReply*> reply);
-	void handleResponse(const QByteArray &bytes);
+	void handleResponse(Type type, const QByteArray &bytes);
 	bool decryptSimpleConfig(const QByteArray &bytes);
 
 	Fn<void(
@@ -42,6 +42,7 @@ constexpr auto kDocumentScansLimit = 20;
 constexpr auto kTranslationScansLimit = 20;
 constexpr auto kShortPollTimeout = crl::time(3000);
 constexpr auto kRememberCredentialsDelay = crl::time(1800 * 1000);
+constexpr auto kScanUploadProgressInterval = crl::time(100);
 
 bool ForwardServiceErrorRequired(const QString &error) {
 	return (error == qstr("BOT_INVALID"))
@@ -1622,6 +1623,17 @@ void FormController::scanUploadProgress(
 	if (const auto file = findEditFile(data.fullId)) {
 		Assert(file->uploadData != nullptr);
 
+		// Parts are small, so a large scan reports progress many times a
+		// second and every event repaints the edit panel row. Intermediate
+		// events are throttled, the finishing one always goes through.
+		const auto now = crl::now();
+		if (data.offset < data.size
+			&& (now - file->uploadData->lastProgressTime
+				< kScanUploadProgressInterval)) {
+			return;
+		}
+		file->uploadData->lastProgressTime = now;
+
 		file->uploadData->status.set(
 			LoadStatus::Status::InProgress,
 			data.offset);
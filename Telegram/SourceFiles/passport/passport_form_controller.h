@@ -99,6 +99,7 @@ struct UploadScanData {
 	QByteArray md5checksum;
 	bytes::vector hash;
 	bytes::vector bytes;
+	crl::time lastProgressTime = 0;
 
 	LoadStatus status;
 };
@@ -23,6 +23,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtp_instance.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "core/file_utilities.h"
+#include "core/memory_stats.h"
+#include "core/perf_trace.h"
 #include "core/update_checker.h"
 #include "window/themes/window_theme.h"
 #include "window/themes/window_theme_editor.h"
@@ -86,6 +88,77 @@ auto GenerateCodes() {
 	codes.emplace(qsl("viewlogs"), [](SessionController *window) {
 		File::ShowInFolder(cWorkingDir() + "log.txt");
 	});
+	codes.emplace(qsl("tracing"), [](SessionController *window) {
+		if (Core::Trace::Enabled()) {
+			Core::Trace::Toggle(false);
+			const auto path = cWorkingDir() + qsl("trace.json");
+			auto file = QFile(path);
+			if (file.open(QIODevice::WriteOnly)) {
+				file.write(Core::Trace::ExportJson());
+				file.close();
+				Core::Trace::Clear();
+				Ui::Toast::Show("Tracing stopped, saved to trace.json.");
+				File::ShowInFolder(path);
+			} else {
+				Ui::Toast::Show("Tracing stopped, could not save file.");
+			}
+		} else {
+			Core::Trace::Clear();
+			Core::Trace::Toggle(true);
+			Ui::Toast::Show("Tracing started, repeat to stop and save.");
+		}
+	});
+	codes.emplace(qsl("jankreport"), [](SessionController *window) {
+		const auto report = Core::Trace::JankReport();
+		if (report.isEmpty()) {
+			Ui::Toast::Show("No main-thread janks recorded yet.");
+			return;
+		}
+		const auto path = cWorkingDir() + qsl("jank_report.txt");
+		auto file = QFile(path);
+		if (file.open(QIODevice::WriteOnly)) {
+			file.write(report);
+			file.close();
+			Core::Trace::ClearJankReport();
+			Ui::Toast::Show("Jank report saved, counters reset.");
+			File::ShowInFolder(path);
+		} else {
+			Ui::Toast::Show("Could not save jank_report.txt.");
+		}
+	});
+	codes.emplace(qsl("memorystats"), [](SessionController *window) {
+		const auto dump = Core::MemoryStats::Dump();
+		if (dump.isEmpty()) {
+			Ui::Toast::Show("Allocator stats are not available here.");
+			return;
+		}
+		const auto path = cWorkingDir() + qsl("memory_stats.txt");
+		auto file = QFile(path);
+		if (file.open(QIODevice::WriteOnly)) {
+			file.write(dump);
+			file.close();
+			Ui::Toast::Show(Core::MemoryStats::Brief());
+			File::ShowInFolder(path);
+		} else {
+			Ui::Toast::Show("Could not save memory_stats.txt.");
+		}
+	});
+	codes.emplace(qsl("heapprofile"), [](SessionController *window) {
+		const auto active = Core::MemoryStats::ToggleHeapProfile();
+		if (!active) {
+			Ui::Toast::Show("Heap profiling is not available here.");
+		} else if (*active) {
+			Ui::Toast::Show("Heap profiling started, repeat to capture.");
+		} else {
+			const auto path = Core::MemoryStats::CaptureHeapProfile();
+			if (path.isEmpty()) {
+				Ui::Toast::Show("Heap profiling stopped, dump failed.");
+			} else {
+				Ui::Toast::Show("Heap profiling stopped, dump saved.");
+				File::ShowInFolder(path);
+			}
+		}
+	});
 	if (!Core::UpdaterDisabled()) {
 		codes.emplace(qsl("testupdate"), [](SessionController *window) {
 			Core::UpdateChecker().test();
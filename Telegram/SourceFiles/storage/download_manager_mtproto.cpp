@@ -18,8 +18,12 @@ namespace Storage {
 namespace {
 
 constexpr auto kKillSessionTimeout = 15 * crl::time(1000);
+constexpr auto kKeepWarmTimeout = 5 * 60 * crl::time(1000);
+constexpr auto kKeepWarmDcCount = 2;
 constexpr auto kStartWaitedInSession = 4 * kDownloadPartSize;
 constexpr auto kMaxWaitedInSession = 16 * kDownloadPartSize;
+constexpr auto kMaxWaitedInSessionFast = 32 * kDownloadPartSize;
+constexpr auto kFastRequestDurationThreshold = crl::time(500);
 constexpr auto kStartSessionsCount = 1;
 constexpr auto kMaxSessionsCount = 8;
 constexpr auto kMaxTrackedSessionRemoves = 64;
@@ -131,6 +135,21 @@ DownloadManagerMtproto::DownloadManagerMtproto(not_null<ApiWrap*> api)
 
 DownloadManagerMtproto::~DownloadManagerMtproto() {
 	killSessions();
+	for (const auto &[dcId, when] : base::take(_keepWarmUntil)) {
+		_api->instance().stopSession(MTP::downloadDcId(dcId, 0));
+	}
+}
+
+void DownloadManagerMtproto::warmUpDc(MTP::DcId dcId) {
+	if (!dcId) {
+		return;
+	}
+	const auto i = _balanceData.find(dcId);
+	if (i != end(_balanceData) && i->second.totalRequested > 0) {
+		return; // Already downloading from there right now.
+	}
+	api().instance().keepWarm(MTP::downloadDcId(dcId, 0));
+	scheduleKeepWarm(dcId);
 }
 
 void DownloadManagerMtproto::enqueue(not_null<Task*> task, int priority) {
@@ -218,6 +237,7 @@ int DownloadManagerMtproto::changeRequestedAmount(
 	};
 	if (delta > 0) {
 		killSessionsCancel(dcId);
+		_keepWarmUntil.remove(dcId);
 	} else if (findNonEmptySession(i->second) == end(i->second.sessions)) {
 		killSessionsSchedule(dcId);
 	}
@@ -257,11 +277,16 @@ void DownloadManagerMtproto::requestSucceeded(
 		});
 		return;
 	}
+	// Requests coming back quickly mean the link has headroom, so grow
+	// the in-flight window faster and allow it to go twice as high.
+	const auto fast = (duration < kFastRequestDurationThreshold);
+	const auto limit = fast ? kMaxWaitedInSessionFast : kMaxWaitedInSession;
+	const auto step = (fast ? 2 : 1) * kDownloadPartSize;
 	if (amountAtRequestStart == data.maxWaitedAmount
-		&& data.maxWaitedAmount < kMaxWaitedInSession) {
+		&& data.maxWaitedAmount < limit) {
 		data.maxWaitedAmount = std::min(
-			data.maxWaitedAmount + kDownloadPartSize,
-			kMaxWaitedInSession);
+			data.maxWaitedAmount + step,
+			limit);
 		DEBUG_LOG(("Download (%1,%2) increased max waited amount %3."
 			).arg(dcId
 			).arg(index
@@ -376,19 +401,30 @@ void DownloadManagerMtproto::killSessionsCancel(MTP::DcId dcId) {
 
 void DownloadManagerMtproto::killSessions() {
 	const auto now = crl::now();
-	auto left = kKillSessionTimeout;
+	auto left = crl::time(0);
 	for (auto i = begin(_killSessionsWhen); i != end(_killSessionsWhen); ) {
 		if (i->second <= now) {
 			killSessions(i->first);
 			i = _killSessionsWhen.erase(i);
 		} else {
-			if (i->second - now < left) {
+			if (!left || i->second - now < left) {
+				left = i->second - now;
+			}
+			++i;
+		}
+	}
+	for (auto i = begin(_keepWarmUntil); i != end(_keepWarmUntil); ) {
+		if (i->second <= now) {
+			api().instance().stopSession(MTP::downloadDcId(i->first, 0));
+			i = _keepWarmUntil.erase(i);
+		} else {
+			if (!left || i->second - now < left) {
 				left = i->second - now;
 			}
 			++i;
 		}
 	}
-	if (!_killSessionsWhen.empty()) {
+	if (left) {
 		_killSessionsTimer.callOnce(left);
 	}
 }
@@ -403,9 +439,31 @@ void DownloadManagerMtproto::killSessions(MTP::DcId dcId) {
 		for (auto j = 0; j != int(sessions.size()); ++j) {
 			Assert(sessions[j].requested == 0);
 			sessions[j] = DcSessionBalanceData();
-			api().instance().stopSession(MTP::downloadDcId(dcId, j));
+			// Keep the base session of this just-used DC connected for
+			// a while - the next download there starts without paying
+			// transport re-establishment in first-byte latency.
+			if (j > 0) {
+				api().instance().stopSession(MTP::downloadDcId(dcId, j));
+			}
 		}
 		dc.sessions = base::take(sessions);
+		scheduleKeepWarm(dcId);
+	}
+}
+
+void DownloadManagerMtproto::scheduleKeepWarm(MTP::DcId dcId) {
+	_keepWarmUntil[dcId] = crl::now() + kKeepWarmTimeout;
+	while (int(_keepWarmUntil.size()) > kKeepWarmDcCount) {
+		const auto coldest = ranges::min_element(
+			_keepWarmUntil,
+			ranges::less(),
+			[](const auto &pair) { return pair.second; });
+		api().instance().stopSession(
+			MTP::downloadDcId(coldest->first, 0));
+		_keepWarmUntil.erase(coldest);
+	}
+	if (!_killSessionsTimer.isActive()) {
+		_killSessionsTimer.callOnce(kKeepWarmTimeout + 5);
 	}
 }
 
@@ -41,6 +41,10 @@ public:
 	void enqueue(not_null<Task*> task, int priority);
 	void remove(not_null<Task*> task);
 
+	// Predictively establish transport to a media DC, so the first
+	// download request there doesn't pay connection setup latency.
+	void warmUpDc(MTP::DcId dcId);
+
 	void notifyTaskFinished() {
 		_taskFinished.fire({});
 	}
@@ -101,6 +105,7 @@ private:
 	void killSessionsCancel(MTP::DcId dcId);
 	void killSessions();
 	void killSessions(MTP::DcId dcId);
+	void scheduleKeepWarm(MTP::DcId dcId);
 
 	void resetGeneration();
 	void sessionTimedOut(MTP::DcId dcId, int index);
@@ -116,6 +121,10 @@ private:
 	base::flat_map<MTP::DcId, crl::time> _killSessionsWhen;
 	base::Timer _killSessionsTimer;
 
+	// Base download sessions of recently used DCs, kept connected till
+	// the stored time, so a download after a short idle starts warm.
+	base::flat_map<MTP::DcId, crl::time> _keepWarmUntil;
+
 	base::flat_map<MTP::DcId, Queue> _queues;
 	rpl::lifetime _lifetime;
 
@@ -249,17 +249,30 @@ void FileLoader::start() {
 }
 
 bool FileLoader::checkForOpen() {
-	if (_filename.isEmpty()
-		|| (_toCache != LoadToFileOnly)
-		|| _fileIsOpen) {
+	if (_filename.isEmpty() || _fileIsOpen) {
 		return true;
 	}
-	_fileIsOpen = _file.open(QIODevice::WriteOnly);
-	if (_fileIsOpen) {
+	// Files too big for the cache are written straight to disk as well,
+	// accumulating them in _data first would only double memory traffic:
+	// the cache put is skipped for them in finalizeResult() anyway.
+	const auto directWrite = (_toCache == LoadToFileOnly)
+		|| ((_toCache == LoadToCacheAsWell)
+			&& (_locationType != UnknownFileLocation)
+			&& (_fullSize > Storage::kMaxFileInMemory));
+	if (!directWrite) {
 		return true;
 	}
-	cancel(true);
-	return false;
+	_fileIsOpen = _file.open(QIODevice::WriteOnly);
+	if (!_fileIsOpen) {
+		cancel(true);
+		return false;
+	}
+	// Preallocate the full size, so that each part is written straight
+	// to its final offset into already reserved contiguous blocks.
+	if (_loadSize > 0 && _file.resize(_loadSize)) {
+		_filePreallocated = true;
+	}
+	return true;
 }
 
 void FileLoader::loadLocal(const Storage::Cache::Key &key) {
@@ -359,6 +372,9 @@ void FileLoader::cancel(bool fail) {
 }
 
 int FileLoader::currentOffset() const {
+	if (_filePreallocated) {
+		return _writtenBytes;
+	}
 	return (_fileIsOpen ? _file.size() : _data.size()) - _skippedBytes;
 }
 
@@ -369,11 +385,15 @@ bool FileLoader::writeResultPart(int offset, bytes::const_span buffer) {
 		return true;
 	}
 	if (_fileIsOpen) {
-		auto fsize = _file.size();
-		if (offset < fsize) {
-			_skippedBytes -= buffer.size();
-		} else if (offset > fsize) {
-			_skippedBytes += offset - fsize;
+		if (_filePreallocated) {
+			_writtenBytes += buffer.size();
+		} else {
+			auto fsize = _file.size();
+			if (offset < fsize) {
+				_skippedBytes -= buffer.size();
+			} else if (offset > fsize) {
+				_skippedBytes += offset - fsize;
+			}
 		}
 		_file.seek(offset);
 		if (_file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()) != qint64(buffer.size())) {
@@ -428,7 +448,9 @@ QByteArray FileLoader::readLoadedPartBack(int offset, int size) {
 bool FileLoader::finalizeResult() {
 	Expects(!_finished);
 
-	if (!_filename.isEmpty() && (_toCache == LoadToCacheAsWell)) {
+	if (!_filename.isEmpty()
+		&& (_toCache == LoadToCacheAsWell)
+		&& !_filePreallocated) {
 		if (!_fileIsOpen) {
 			_fileIsOpen = _file.open(QIODevice::WriteOnly);
 		}
@@ -456,6 +478,7 @@ bool FileLoader::finalizeResult() {
 		}
 		const auto key = cacheKey();
 		if ((_toCache == LoadToCacheAsWell)
+			&& !_filePreallocated
 			&& (_data.size() <= Storage::kMaxFileInMemory)
 			&& (key.low || key.high)) {
 			_session->data().cache().put(
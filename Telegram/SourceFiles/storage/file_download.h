@@ -163,6 +163,8 @@ protected:
 	QString _filename;
 	QFile _file;
 	bool _fileIsOpen = false;
+	bool _filePreallocated = false;
+	int _writtenBytes = 0;
 
 	LoadToCacheSetting _toCache;
 	LoadFromCloudSetting _fromCloud;
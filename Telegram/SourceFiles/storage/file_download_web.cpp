@@ -19,6 +19,14 @@ constexpr auto kMaxWebFileQueries = 8;
 constexpr auto kMaxHttpRedirects = 5;
 constexpr auto kResetDownloadPrioritiesTimeout = crl::time(200);
 
+// A file with that much left after the first progress notification is
+// split into parallel HTTP range requests for the tail, each at least
+// kParallelSegmentSize, while the original stream keeps filling the
+// head. Segments don't count against kMaxWebFileQueries - they only
+// exist while their file downloads.
+constexpr auto kParallelSegmentSize = int64(512 * 1024);
+constexpr auto kMaxParallelSegments = 3;
+
 std::weak_ptr<WebLoadManager> GlobalLoadManager;
 
 [[nodiscard]] std::shared_ptr<WebLoadManager> GetManager() {
@@ -69,12 +77,28 @@ private:
 		QString url;
 	};
 	struct Sent {
+		struct Segment {
+			QNetworkReply *reply = nullptr;
+			int64 from = 0;
+			int64 till = 0;
+			int64 ready = 0;
+			bool done = false;
+		};
+
 		QString url;
 		not_null<QNetworkReply*> reply;
 		QByteArray data;
 		int64 ready = 0;
 		int64 total = 0;
 		int redirectsLeft = kMaxHttpRedirects;
+
+		// Parallel range requests for the tail of a large file, the
+		// data is preallocated to the full size and written in place.
+		// Either all segments are alive or the list is empty and the
+		// primary stream finishes the file alone.
+		std::vector<Segment> segments;
+		int64 written = 0;
+		bool segmented = false;
 	};
 
 	// Constructor.
@@ -106,6 +130,19 @@ private:
 		int64 total);
 	void failed(int id, not_null<QNetworkReply*> reply);
 	void finished(int id, not_null<QNetworkReply*> reply);
+	void maybeStartSegments(
+		int id,
+		Sent &sent,
+		not_null<QNetworkReply*> reply);
+	[[nodiscard]] QNetworkReply *sendSegment(
+		int id,
+		const QString &url,
+		int64 from,
+		int64 till);
+	void segmentProgress(int id, not_null<QNetworkReply*> reply);
+	void segmentFailed(int id, not_null<QNetworkReply*> reply);
+	void dropSegments(Sent &sent);
+	void checkSegmentedFinished(int id, Sent &sent);
 	void deleteDeferred(not_null<QNetworkReply*> reply);
 	void queueProgressUpdate(int id, int64 ready, int64 total);
 	void queueFailedUpdate(int id);
@@ -258,8 +295,17 @@ void WebLoadManager::send(const Enqueued &entry) {
 
 void WebLoadManager::removeSent(int id) {
 	if (const auto i = _sent.find(id); i != end(_sent)) {
-		deleteDeferred(i->second.reply);
+		const auto primary = i->second.reply;
+		const auto segments = base::take(i->second.segments);
 		_sent.erase(i);
+		primary->abort();
+		deleteDeferred(primary);
+		for (const auto &segment : segments) {
+			if (segment.reply) {
+				segment.reply->abort();
+				deleteDeferred(segment.reply);
+			}
+		}
 		checkSendNext();
 	}
 }
@@ -335,25 +381,196 @@ void WebLoadManager::notify(
 		not_null<QNetworkReply*> reply,
 		int64 ready,
 		int64 total) {
-	if (const auto sent = findSent(id, reply)) {
-		sent->ready = ready;
-		sent->total = std::max(total, int64(0));
-		sent->data.append(reply->readAll());
-		if (total == 0
-			|| total > Storage::kMaxFileInMemory
-			|| sent->data.size() > Storage::kMaxFileInMemory) {
-			LOG(("Network Error: "
-				"Bad size received for HTTP download progress "
-				"in WebLoadManager::onProgress(): %1 / %2 (bytes %3)"
-				).arg(ready
-				).arg(total
-				).arg(sent->data.size()));
-			failed(id, reply);
-		} else if (total > 0 && ready >= total) {
-			finished(id, reply);
-		} else {
-			queueProgressUpdate(id, sent->ready, sent->total);
+	const auto sent = findSent(id, reply);
+	if (!sent) {
+		return;
+	}
+	sent->ready = ready;
+	sent->total = std::max(total, int64(0));
+	if (sent->segmented) {
+		const auto bytes = reply->readAll();
+		const auto copy = std::min(
+			int64(bytes.size()),
+			sent->total - sent->written);
+		if (copy > 0) {
+			memcpy(
+				sent->data.data() + sent->written,
+				bytes.constData(),
+				copy);
+			sent->written += copy;
 		}
+		checkSegmentedFinished(id, *sent);
+		return;
+	}
+	sent->data.append(reply->readAll());
+	if (total == 0
+		|| total > Storage::kMaxFileInMemory
+		|| sent->data.size() > Storage::kMaxFileInMemory) {
+		LOG(("Network Error: "
+			"Bad size received for HTTP download progress "
+			"in WebLoadManager::onProgress(): %1 / %2 (bytes %3)"
+			).arg(ready
+			).arg(total
+			).arg(sent->data.size()));
+		failed(id, reply);
+	} else if (total > 0 && ready >= total) {
+		finished(id, reply);
+	} else {
+		maybeStartSegments(id, *sent, reply);
+		queueProgressUpdate(id, sent->ready, sent->total);
+	}
+}
+
+void WebLoadManager::maybeStartSegments(
+		int id,
+		Sent &sent,
+		not_null<QNetworkReply*> reply) {
+	const auto total = sent.total;
+	const auto head = int64(sent.data.size());
+	const auto left = total - head;
+	if (!total
+		|| (left < 2 * kParallelSegmentSize)
+		|| reply->rawHeader("Accept-Ranges") != "bytes") {
+		return;
+	}
+	const auto count = std::min(
+		int64(kMaxParallelSegments),
+		(left / kParallelSegmentSize) - 1);
+	const auto from = head + (left / (count + 1));
+	const auto chunk = (total - from + count - 1) / count;
+	sent.segmented = true;
+	sent.written = head;
+	sent.data.resize(total);
+	sent.segments.reserve(count);
+	for (auto i = int64(0); i != count; ++i) {
+		const auto segmentFrom = from + i * chunk;
+		const auto segmentTill = std::min(segmentFrom + chunk, total);
+		sent.segments.push_back({
+			.reply = sendSegment(id, sent.url, segmentFrom, segmentTill),
+			.from = segmentFrom,
+			.till = segmentTill,
+		});
+	}
+}
+
+QNetworkReply *WebLoadManager::sendSegment(
+		int id,
+		const QString &url,
+		int64 from,
+		int64 till) {
+	auto request = QNetworkRequest(url);
+	request.setRawHeader(
+		"Range",
+		"bytes="
+			+ QByteArray::number(qlonglong(from))
+			+ "-"
+			+ QByteArray::number(qlonglong(till - 1)));
+	const auto result = _network->get(request);
+	const auto handleProgress = [=](qint64, qint64) {
+		segmentProgress(id, result);
+	};
+	const auto handleError = [=](QNetworkReply::NetworkError) {
+		segmentFailed(id, result);
+	};
+	QObject::connect(
+		result,
+		&QNetworkReply::downloadProgress,
+		handleProgress);
+	QObject::connect(result, base::QNetworkReply_error, handleError);
+	return result;
+}
+
+void WebLoadManager::segmentProgress(
+		int id,
+		not_null<QNetworkReply*> reply) {
+	const auto i = _sent.find(id);
+	if (i == end(_sent)) {
+		return;
+	}
+	auto &sent = i->second;
+	const auto j = ranges::find(
+		sent.segments,
+		reply.get(),
+		&Sent::Segment::reply);
+	if (j == end(sent.segments) || j->done) {
+		return;
+	}
+	const auto statusCode = reply->attribute(
+		QNetworkRequest::HttpStatusCodeAttribute);
+	if (statusCode.isValid() && statusCode.toInt() != 206) {
+		// The server advertised ranges but didn't honour ours, drop
+		// the segments and let the primary stream finish the file.
+		dropSegments(sent);
+		return;
+	}
+	const auto bytes = reply->readAll();
+	const auto size = j->till - j->from;
+	const auto copy = std::min(int64(bytes.size()), size - j->ready);
+	if (copy > 0) {
+		memcpy(
+			sent.data.data() + j->from + j->ready,
+			bytes.constData(),
+			copy);
+		j->ready += copy;
+	}
+	if (j->ready >= size) {
+		j->done = true;
+		deleteDeferred(reply);
+		j->reply = nullptr;
+	}
+	checkSegmentedFinished(id, sent);
+}
+
+void WebLoadManager::segmentFailed(
+		int id,
+		not_null<QNetworkReply*> reply) {
+	const auto i = _sent.find(id);
+	if (i == end(_sent)) {
+		return;
+	}
+	auto &sent = i->second;
+	const auto j = ranges::find(
+		sent.segments,
+		reply.get(),
+		&Sent::Segment::reply);
+	if (j == end(sent.segments) || j->done) {
+		return;
+	}
+	// Only the optimization failed, not the download - the primary
+	// stream is still running and covers the whole file by itself.
+	LOG(("Network Warning: "
+		"Failed HTTP range request for '%1', "
+		"falling back to the single stream.").arg(sent.url));
+	dropSegments(sent);
+}
+
+void WebLoadManager::dropSegments(Sent &sent) {
+	for (const auto &segment : base::take(sent.segments)) {
+		if (segment.reply) {
+			segment.reply->abort();
+			deleteDeferred(segment.reply);
+		}
+	}
+}
+
+void WebLoadManager::checkSegmentedFinished(int id, Sent &sent) {
+	const auto allDone = ranges::all_of(
+		sent.segments,
+		&Sent::Segment::done);
+	const auto covered = (sent.written >= sent.total)
+		|| (allDone
+			&& !sent.segments.empty()
+			&& sent.written >= sent.segments.front().from);
+	if (covered) {
+		const auto data = base::take(sent.data);
+		removeSent(id);
+		queueFinishedUpdate(id, data);
+	} else {
+		auto ready = sent.written;
+		for (const auto &segment : sent.segments) {
+			ready += segment.ready;
+		}
+		queueProgressUpdate(id, std::min(ready, sent.total), sent.total);
 	}
 }
 
@@ -398,6 +615,12 @@ void WebLoadManager::clear() {
 	for (const auto &[id, sent] : base::take(_sent)) {
 		sent.reply->abort();
 		delete sent.reply;
+		for (const auto &segment : sent.segments) {
+			if (segment.reply) {
+				segment.reply->abort();
+				delete segment.reply;
+			}
+		}
 	}
 	for (const auto &reply : base::take(_repliesBeingDeleted)) {
 		if (reply) {
@@ -78,6 +78,7 @@ struct Uploader::File {
 	HashMd5 md5Hash;
 
 	std::unique_ptr<QFile> docFile;
+	const uchar *docMapped = nullptr;
 	int32 docSentParts = 0;
 	int32 docSize = 0;
 	int32 docPartSize = 0;
@@ -400,8 +401,15 @@ void Uploader::stopSessions() {
 }
 
 void Uploader::sendNext() {
+	// Keep the pipeline full: push parts until the in-flight window is
+	// filled, then let acknowledgements in partLoaded() clock new sends.
+	while (sendNextPart()) {
+	}
+}
+
+bool Uploader::sendNextPart() {
 	if (sentSize >= kMaxUploadFileParallelSize || _pausedId.msg) {
-		return;
+		return false;
 	}
 
 	const auto stopping = _stopSessionsTimer.isActive();
@@ -409,7 +417,7 @@ void Uploader::sendNext() {
 		if (!stopping) {
 			_stopSessionsTimer.callOnce(kKillSessionTimeout);
 		}
-		return;
+		return false;
 	}
 
 	if (stopping) {
@@ -529,9 +537,9 @@ void Uploader::sendNext() {
 				}
 				queue.erase(uploadingId);
 				uploadingId = FullMsgId();
-				sendNext();
+				return true;
 			}
-			return;
+			return false;
 		}
 
 		auto &content = uploadingData.file
@@ -546,10 +554,29 @@ void Uploader::sendNext() {
 				uploadingData.docFile = std::make_unique<QFile>(filepath);
 				if (!uploadingData.docFile->open(QIODevice::ReadOnly)) {
 					currentFailed();
-					return;
+					return false;
 				}
+				// Map the source once - parts are then sliced from the
+				// mapping without per-part read() syscalls. Fall back to
+				// sequential reads if mapping is not available.
+				uploadingData.docMapped = uploadingData.docFile->map(
+					0,
+					uploadingData.docSize);
+			}
+			if (uploadingData.docMapped) {
+				const auto offset = int64(uploadingData.docSentParts)
+					* uploadingData.docPartSize;
+				const auto bytes = std::min(
+					int64(uploadingData.docPartSize),
+					int64(uploadingData.docSize) - offset);
+				toSend = QByteArray(
+					reinterpret_cast<const char*>(uploadingData.docMapped)
+						+ offset,
+					bytes);
+			} else {
+				toSend = uploadingData.docFile->read(
+					uploadingData.docPartSize);
 			}
-			toSend = uploadingData.docFile->read(uploadingData.docPartSize);
 			if (uploadingData.docSize <= kUseBigFilesFrom) {
 				uploadingData.md5Hash.feed(toSend.constData(), toSend.size());
 			}
@@ -568,7 +595,7 @@ void Uploader::sendNext() {
 			|| ((toSend.size() < uploadingData.docPartSize
 				&& uploadingData.docSentParts + 1 != uploadingData.docPartsCount))) {
 			currentFailed();
-			return;
+			return false;
 		}
 		mtpRequestId requestId;
 		if (uploadingData.docSize > kUseBigFilesFrom) {
@@ -619,6 +646,7 @@ void Uploader::sendNext() {
 		parts.erase(part);
 	}
 	_nextTimer.callOnce(kUploadRequestInterval);
+	return true;
 }
 
 void Uploader::cancel(const FullMsgId &msgId) {
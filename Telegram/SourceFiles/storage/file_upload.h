@@ -105,6 +105,7 @@ public:
 private:
 	struct File;
 
+	bool sendNextPart();
 	void partLoaded(const MTPBool &result, mtpRequestId requestId);
 	void partFailed(const MTP::Error &error, mtpRequestId requestId);
 
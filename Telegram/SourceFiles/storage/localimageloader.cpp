@@ -25,6 +25,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item.h"
 #include "boxes/send_files_box.h"
 #include "ui/boxes/confirm_box.h"
+#include "ui/image/image_downscale.h"
 #include "ui/image/image_prepare.h"
 #include "lang/lang_keys.h"
 #include "storage/file_download.h"
@@ -44,6 +45,7 @@ constexpr auto kThumbnailQuality = 87;
 constexpr auto kThumbnailSize = 320;
 constexpr auto kPhotoUploadPartSize = 32 * 1024;
 constexpr auto kRecompressAfterBpp = 4;
+constexpr auto kMaxTaskQueueWorkers = 8;
 
 using Ui::ValidateThumbDimensions;
 
@@ -75,11 +77,11 @@ struct PreparedFileThumbnail {
 			: kThumbnailSize;
 	};
 	result.image = scaled
-		? original.scaled(
+		? Images::SmoothDownscale(
+			std::move(original),
 			scaledWidth(),
 			scaledHeight(),
-			Qt::IgnoreAspectRatio,
-			Qt::SmoothTransformation)
+			Qt::IgnoreAspectRatio)
 		: std::move(original);
 	result.mtpSize = MTP_photoSize(
 		MTP_string(),
@@ -298,58 +300,70 @@ TaskId TaskQueue::addTask(std::unique_ptr<Task> &&task) {
 		QMutexLocker lock(&_tasksToProcessMutex);
 		_tasksToProcess.push_back(std::move(task));
 	}
+	{
+		QMutexLocker lock(&_tasksToFinishMutex);
+		_finishOrder.push_back(result);
+	}
 
-	wakeThread();
+	wakeThreads();
 
 	return result;
 }
 
 void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 	{
-		QMutexLocker lock(&_tasksToProcessMutex);
+		QMutexLocker lockToProcess(&_tasksToProcessMutex);
+		QMutexLocker lockToFinish(&_tasksToFinishMutex);
 		for (auto &task : tasks) {
+			_finishOrder.push_back(task->id());
 			_tasksToProcess.push_back(std::move(task));
 		}
 	}
 
-	wakeThread();
+	wakeThreads();
 }
 
-void TaskQueue::wakeThread() {
-	if (!_thread) {
-		_thread = new QThread();
-
-		_worker = new TaskQueueWorker(this);
-		_worker->moveToThread(_thread);
-
-		connect(this, SIGNAL(taskAdded()), _worker, SLOT(onTaskAdded()));
-		connect(_worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
-
-		_thread->start();
+void TaskQueue::wakeThreads() {
+	const auto backlog = [&] {
+		QMutexLocker lock(&_tasksToProcessMutex);
+		return int(_tasksToProcess.size());
+	}();
+	const auto limit = std::clamp(
+		QThread::idealThreadCount(),
+		1,
+		kMaxTaskQueueWorkers);
+	while (int(_threads.size()) < std::min(backlog, limit)) {
+		const auto thread = _threads.emplace_back(new QThread());
+		const auto worker = _workers.emplace_back(new TaskQueueWorker(this));
+		worker->moveToThread(thread);
+
+		connect(this, SIGNAL(taskAdded()), worker, SLOT(onTaskAdded()));
+		connect(worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
+
+		thread->start();
 	}
 	if (_stopTimer) _stopTimer->stop();
 	taskAdded();
 }
 
 void TaskQueue::cancelTask(TaskId id) {
-	const auto removeFrom = [&](std::deque<std::unique_ptr<Task>> &queue) {
+	{
+		QMutexLocker lock(&_tasksToProcessMutex);
 		const auto proj = [](const std::unique_ptr<Task> &task) {
 			return task->id();
 		};
-		auto i = ranges::find(queue, id, proj);
-		if (i != queue.end()) {
-			queue.erase(i);
-		}
-	};
-	{
-		QMutexLocker lock(&_tasksToProcessMutex);
-		removeFrom(_tasksToProcess);
-		if (_taskInProcessId == id) {
-			_taskInProcessId = TaskId();
+		const auto i = ranges::find(_tasksToProcess, id, proj);
+		if (i != _tasksToProcess.end()) {
+			_tasksToProcess.erase(i);
 		}
+		_tasksInProcess.remove(id);
 	}
 	QMutexLocker lock(&_tasksToFinishMutex);
-	removeFrom(_tasksToFinish);
+	const auto i = ranges::find(_finishOrder, id);
+	if (i != _finishOrder.end()) {
+		_finishOrder.erase(i);
+	}
+	_doneTasks.remove(id);
 }
 
 void TaskQueue::onTaskProcessed() {
@@ -357,33 +371,46 @@ void TaskQueue::onTaskProcessed() {
 		auto task = std::unique_ptr<Task>();
 		{
 			QMutexLocker lock(&_tasksToFinishMutex);
-			if (_tasksToFinish.empty()) break;
-			task = std::move(_tasksToFinish.front());
-			_tasksToFinish.pop_front();
+			if (_finishOrder.empty()) break;
+			const auto i = _doneTasks.find(_finishOrder.front());
+			if (i == _doneTasks.end()) {
+				// The next task in order is still being processed.
+				break;
+			}
+			task = std::move(i->second);
+			_doneTasks.erase(i);
+			_finishOrder.pop_front();
 		}
 		task->finish();
 	} while (true);
 
 	if (_stopTimer) {
 		QMutexLocker lock(&_tasksToProcessMutex);
-		if (_tasksToProcess.empty() && !_taskInProcessId) {
+		if (_tasksToProcess.empty() && _tasksInProcess.empty()) {
 			_stopTimer->start();
 		}
 	}
 }
 
 void TaskQueue::stop() {
-	if (_thread) {
-		_thread->requestInterruption();
-		_thread->quit();
-		DEBUG_LOG(("Waiting for taskThread to finish"));
-		_thread->wait();
-		delete base::take(_worker);
-		delete base::take(_thread);
+	for (const auto thread : _threads) {
+		thread->requestInterruption();
+		thread->quit();
+	}
+	DEBUG_LOG(("Waiting for task threads to finish"));
+	for (const auto thread : _threads) {
+		thread->wait();
+	}
+	for (const auto worker : base::take(_workers)) {
+		delete worker;
+	}
+	for (const auto thread : base::take(_threads)) {
+		delete thread;
 	}
 	_tasksToProcess.clear();
-	_tasksToFinish.clear();
-	_taskInProcessId = TaskId();
+	_finishOrder.clear();
+	_doneTasks.clear();
+	_tasksInProcess.clear();
 }
 
 TaskQueue::~TaskQueue() {
@@ -403,7 +430,7 @@ void TaskQueueWorker::onTaskAdded() {
 			if (!_queue->_tasksToProcess.empty()) {
 				task = std::move(_queue->_tasksToProcess.front());
 				_queue->_tasksToProcess.pop_front();
-				_queue->_taskInProcessId = task->id();
+				_queue->_tasksInProcess.emplace(task->id());
 			}
 		}
 
@@ -412,13 +439,12 @@ void TaskQueueWorker::onTaskAdded() {
 			bool emitTaskProcessed = false;
 			{
 				QMutexLocker lockToProcess(&_queue->_tasksToProcessMutex);
-				if (_queue->_taskInProcessId == task->id()) {
-					_queue->_taskInProcessId = TaskId();
+				if (_queue->_tasksInProcess.remove(task->id())) {
 					someTasksLeft = !_queue->_tasksToProcess.empty();
 
 					QMutexLocker lockToFinish(&_queue->_tasksToFinishMutex);
-					emitTaskProcessed = _queue->_tasksToFinish.empty();
-					_queue->_tasksToFinish.push_back(std::move(task));
+					_queue->_doneTasks.emplace(task->id(), std::move(task));
+					emitTaskProcessed = true;
 				}
 			}
 			if (emitTaskProcessed) {
@@ -931,10 +957,10 @@ void FileLoadTask::process(Args &&args) {
 				attributes.push_back(MTP_documentAttributeAnimated());
 			} else if (filemime.startsWith(u"image/"_q)
 				&& _type != SendMediaType::File) {
-				auto medium = (w > 320 || h > 320) ? fullimage.scaled(320, 320, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
+				auto medium = (w > 320 || h > 320) ? Images::SmoothDownscale(fullimage, 320, 320) : fullimage;
 
 				const auto downscaled = (w > 1280 || h > 1280);
-				auto full = downscaled ? fullimage.scaled(1280, 1280, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
+				auto full = downscaled ? Images::SmoothDownscale(fullimage, 1280, 1280) : fullimage;
 				if (downscaled) {
 					fullimagebytes = fullimageformat = QByteArray();
 				}
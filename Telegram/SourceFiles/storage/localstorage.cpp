@@ -84,6 +84,7 @@ bool _backgroundCanWrite = true;
 int32 _oldSettingsVersion = 0;
 bool _settingsRewriteNeeded = false;
 bool _settingsWriteAllowed = false;
+QByteArray _lastWrittenSettings;
 
 enum class WriteMapWhen {
 	Now,
@@ -443,15 +444,14 @@ void writeSettings() {
 	// We dropped old test authorizations when migrated to multi auth.
 	//const auto name = cTestMode() ? qsl("settings_test") : qsl("settings");
 	const auto name = u"settings"_q;
-	FileWriteDescriptor settings(name, _basePath);
 	if (_settingsSalt.isEmpty() || !SettingsKey) {
 		_settingsSalt.resize(LocalEncryptSaltSize);
 		base::RandomFill(_settingsSalt.data(), _settingsSalt.size());
 		SettingsKey = CreateLegacyLocalKey(QByteArray(), _settingsSalt);
 	}
-	settings.writeData(_settingsSalt);
-
 	if (!_settingsWriteAllowed) {
+		FileWriteDescriptor settings(name, _basePath);
+		settings.writeData(_settingsSalt);
 		EncryptedDescriptor data(0);
 		settings.writeEncrypted(data, SettingsKey);
 		return;
@@ -507,6 +507,17 @@ void writeSettings() {
 		data.stream << quint32(dbiLanguagesKey) << quint64(_languagesKey);
 	}
 
+	// The delayed savers schedule a write on every possibly-changing
+	// event, so geometry updates and periodic saves often come here with
+	// nothing actually changed - and each write re-encrypts and rewrites
+	// the whole settings file. Serialize first and skip identical blobs.
+	if (data.data == _lastWrittenSettings) {
+		return;
+	}
+	_lastWrittenSettings = data.data;
+
+	FileWriteDescriptor settings(name, _basePath);
+	settings.writeData(_settingsSalt);
 	settings.writeEncrypted(data, SettingsKey);
 }
 
@@ -580,7 +591,81 @@ QString readAutoupdatePrefix() {
 	return result.replace(QRegularExpression("/+$"), QString());
 }
 
-void writeBackground(const Data::WallPaper &paper, const QImage &image) {
+[[nodiscard]] QByteArray SerializeBackgroundImage(const QImage &image) {
+	auto result = QByteArray();
+	if (image.isNull()) {
+		return result;
+	}
+	const auto width = qint32(image.width());
+	const auto height = qint32(image.height());
+	const auto perpixel = (image.depth() >> 3);
+	const auto srcperline = image.bytesPerLine();
+	const auto srcsize = srcperline * height;
+	const auto dstperline = width * perpixel;
+	const auto dstsize = dstperline * height;
+	const auto copy = (image.format() != kSavedBackgroundFormat)
+		? image.convertToFormat(kSavedBackgroundFormat)
+		: image;
+	result.resize(2 * sizeof(qint32) + dstsize);
+
+	auto dst = bytes::make_detached_span(result);
+	bytes::copy(dst, bytes::object_as_span(&width));
+	dst = dst.subspan(sizeof(qint32));
+	bytes::copy(dst, bytes::object_as_span(&height));
+	dst = dst.subspan(sizeof(qint32));
+	const auto src = bytes::make_span(image.constBits(), srcsize);
+	if (srcsize == dstsize) {
+		bytes::copy(dst, src);
+	} else {
+		for (auto y = 0; y != height; ++y) {
+			bytes::copy(dst, src.subspan(y * srcperline, dstperline));
+			dst = dst.subspan(dstperline);
+		}
+	}
+	return result;
+}
+
+[[nodiscard]] QImage DeserializeBackgroundImage(const QByteArray &data) {
+	auto result = QImage();
+	const auto perpixel = 4;
+	auto src = bytes::make_span(data);
+	auto width = qint32();
+	auto height = qint32();
+	if (src.size() <= 2 * sizeof(qint32)) {
+		return result;
+	}
+	bytes::copy(
+		bytes::object_as_span(&width),
+		src.subspan(0, sizeof(qint32)));
+	src = src.subspan(sizeof(qint32));
+	bytes::copy(
+		bytes::object_as_span(&height),
+		src.subspan(0, sizeof(qint32)));
+	src = src.subspan(sizeof(qint32));
+	if (width + height <= kWallPaperSidesLimit
+		&& src.size() == width * height * perpixel) {
+		result = QImage(
+			width,
+			height,
+			QImage::Format_ARGB32_Premultiplied);
+		if (!result.isNull()) {
+			const auto srcperline = width * perpixel;
+			const auto srcsize = srcperline * height;
+			const auto dstperline = result.bytesPerLine();
+			const auto dstsize = dstperline * height;
+			Assert(srcsize == dstsize);
+			bytes::copy(
+				bytes::make_span(result.bits(), dstsize),
+				src);
+		}
+	}
+	return result;
+}
+
+void writeBackground(
+		const Data::WallPaper &paper,
+		const QImage &image,
+		const QImage &prepared) {
 	Expects(_settingsWriteAllowed);
 
 	if (!_backgroundCanWrite) {
@@ -591,35 +676,8 @@ void writeBackground(const Data::WallPaper &paper, const QImage &image) {
 	auto &backgroundKey = Window::Theme::IsNightMode()
 		? _backgroundKeyNight
 		: _backgroundKeyDay;
-	auto imageData = QByteArray();
-	if (!image.isNull()) {
-		const auto width = qint32(image.width());
-		const auto height = qint32(image.height());
-		const auto perpixel = (image.depth() >> 3);
-		const auto srcperline = image.bytesPerLine();
-		const auto srcsize = srcperline * height;
-		const auto dstperline = width * perpixel;
-		const auto dstsize = dstperline * height;
-		const auto copy = (image.format() != kSavedBackgroundFormat)
-			? image.convertToFormat(kSavedBackgroundFormat)
-			: image;
-		imageData.resize(2 * sizeof(qint32) + dstsize);
-
-		auto dst = bytes::make_detached_span(imageData);
-		bytes::copy(dst, bytes::object_as_span(&width));
-		dst = dst.subspan(sizeof(qint32));
-		bytes::copy(dst, bytes::object_as_span(&height));
-		dst = dst.subspan(sizeof(qint32));
-		const auto src = bytes::make_span(image.constBits(), srcsize);
-		if (srcsize == dstsize) {
-			bytes::copy(dst, src);
-		} else {
-			for (auto y = 0; y != height; ++y) {
-				bytes::copy(dst, src.subspan(y * srcperline, dstperline));
-				dst = dst.subspan(dstperline);
-			}
-		}
-	}
+	const auto imageData = SerializeBackgroundImage(image);
+	const auto preparedData = SerializeBackgroundImage(prepared);
 	if (!backgroundKey) {
 		backgroundKey = GenerateKey(_basePath);
 		writeSettings();
@@ -627,12 +685,14 @@ void writeBackground(const Data::WallPaper &paper, const QImage &image) {
 	const auto serialized = paper.serialize();
 	quint32 size = sizeof(qint32)
 		+ Serialize::bytearraySize(serialized)
-		+ Serialize::bytearraySize(imageData);
+		+ Serialize::bytearraySize(imageData)
+		+ Serialize::bytearraySize(preparedData);
 	EncryptedDescriptor data(size);
 	data.stream
 		<< qint32(kWallPaperSerializeTagId)
 		<< serialized
-		<< imageData;
+		<< imageData
+		<< preparedData;
 
 	FileWriteDescriptor file(backgroundKey, _basePath);
 	file.writeEncrypted(data, SettingsKey);
@@ -706,37 +766,16 @@ bool readBackground() {
 		return true;
 	}
 	auto image = QImage();
+	auto prepared = QImage();
 	if (legacyId == kWallPaperSerializeTagId) {
-		const auto perpixel = 4;
-		auto src = bytes::make_span(imageData);
-		auto width = qint32();
-		auto height = qint32();
-		if (src.size() > 2 * sizeof(qint32)) {
-			bytes::copy(
-				bytes::object_as_span(&width),
-				src.subspan(0, sizeof(qint32)));
-			src = src.subspan(sizeof(qint32));
-			bytes::copy(
-				bytes::object_as_span(&height),
-				src.subspan(0, sizeof(qint32)));
-			src = src.subspan(sizeof(qint32));
-			if (width + height <= kWallPaperSidesLimit
-				&& src.size() == width * height * perpixel) {
-				image = QImage(
-					width,
-					height,
-					QImage::Format_ARGB32_Premultiplied);
-				if (!image.isNull()) {
-					const auto srcperline = width * perpixel;
-					const auto srcsize = srcperline * height;
-					const auto dstperline = image.bytesPerLine();
-					const auto dstsize = dstperline * height;
-					Assert(srcsize == dstsize);
-					bytes::copy(
-						bytes::make_span(image.bits(), dstsize),
-						src);
-				}
-			}
+		image = DeserializeBackgroundImage(imageData);
+
+		// The prepared (pattern-composed) image was added later, so it
+		// may be missing - then it is generated from 'image' on apply.
+		auto preparedData = QByteArray();
+		bg.stream >> preparedData;
+		if (bg.stream.status() == QDataStream::Ok) {
+			prepared = DeserializeBackgroundImage(preparedData);
 		}
 	} else {
 		auto buffer = QBuffer(&imageData);
@@ -748,7 +787,10 @@ bool readBackground() {
 	}
 	if (!image.isNull() || !paper->backgroundColors().empty()) {
 		_backgroundCanWrite = false;
-		Window::Theme::Background()->set(*paper, std::move(image));
+		Window::Theme::Background()->set(
+			*paper,
+			std::move(image),
+			std::move(prepared));
 		_backgroundCanWrite = true;
 		return true;
 	}
@@ -823,6 +865,11 @@ public:
 			if (!_waveform.isEmpty()) {
 				voice->waveform = _waveform;
 				voice->wavemax = _wavemax;
+				_doc->owner().cache().put(
+					_doc->waveformCacheKey(),
+					Storage::Cache::Database::TaggedValue(
+						documentWaveformEncode5bit(_waveform),
+						_doc->cacheTag()));
 			}
 			if (voice->waveform.isEmpty()) {
 				voice->waveform.resize(1);
@@ -850,7 +897,7 @@ protected:
 
 };
 
-void countVoiceWaveform(not_null<Data::DocumentMedia*> media) {
+void scheduleVoiceWaveformCount(not_null<Data::DocumentMedia*> media) {
 	const auto document = media->owner();
 	if (const auto voice = document->voice()) {
 		if (_localLoader) {
@@ -863,6 +910,40 @@ void countVoiceWaveform(not_null<Data::DocumentMedia*> media) {
 	}
 }
 
+void countVoiceWaveform(not_null<Data::DocumentMedia*> media) {
+	const auto document = media->owner();
+	const auto voice = document->voice();
+	if (!voice || !_localLoader) {
+		return;
+	}
+
+	// Counted waveforms are persisted in the media cache, so revisiting
+	// a voice-heavy chat reads them back instead of decoding the audio.
+	voice->waveform.resize(1);
+	voice->waveform[0] = -1; // counting
+	const auto guard = base::make_weak(&document->session());
+	const auto shared = document->activeMediaView();
+	document->owner().cache().get(document->waveformCacheKey(), [=](
+			QByteArray value) {
+		crl::on_main(guard, [=] {
+			const auto voice = document->voice();
+			if (!voice
+				|| voice->waveform.size() != 1
+				|| voice->waveform[0] != -1) {
+				return;
+			}
+			const auto waveform = documentWaveformDecode(value);
+			if (!waveform.isEmpty()) {
+				voice->waveform = waveform;
+				voice->wavemax = *ranges::max_element(waveform);
+				document->owner().requestDocumentViewRepaint(document);
+			} else if (shared) {
+				scheduleVoiceWaveformCount(shared.get());
+			}
+		});
+	});
+}
+
 void cancelTask(TaskId id) {
 	if (_localLoader) {
 		_localLoader->cancelTask(id);
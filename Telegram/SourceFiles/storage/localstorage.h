@@ -58,7 +58,10 @@ void rewriteSettingsIfNeeded();
 void writeAutoupdatePrefix(const QString &prefix);
 QString readAutoupdatePrefix();
 
-void writeBackground(const Data::WallPaper &paper, const QImage &image);
+void writeBackground(
+	const Data::WallPaper &paper,
+	const QImage &image,
+	const QImage &prepared = QImage());
 bool readBackground();
 void moveLegacyBackground(
 	const QString &fromBasePath,
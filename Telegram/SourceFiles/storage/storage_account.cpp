@@ -23,6 +23,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtproto_dc_options.h"
 #include "mtproto/mtp_instance.h"
 #include "history/history.h"
+#include "dialogs/dialogs_indexed_list.h"
+#include "dialogs/dialogs_main_list.h"
 #include "core/application.h"
 #include "core/file_location.h"
 #include "data/stickers/data_stickers.h"
@@ -42,7 +44,7 @@ using Database = Cache::Database;
 constexpr auto kDelayedWriteTimeout = crl::time(1000);
 
 constexpr auto kStickersVersionTag = quint32(-1);
-constexpr auto kStickersSerializeVersion = 2;
+constexpr auto kStickersSerializeVersion = 3; // 3 - deflated payload.
 constexpr auto kMaxSavedStickerSetsCount = 1000;
 constexpr auto kDefaultStickerInstallDate = TimeId(1);
 
@@ -54,6 +56,8 @@ constexpr auto kSinglePeerTypeChat = qint32(8 + 2);
 constexpr auto kSinglePeerTypeChannel = qint32(8 + 3);
 constexpr auto kSinglePeerTypeSelf = qint32(4);
 constexpr auto kSinglePeerTypeEmpty = qint32(0);
+constexpr auto kDialogsSnapshotLimit = 100;
+constexpr auto kContactsSnapshotLimit = 3000;
 constexpr auto kMultiDraftTagOld = quint64(0xFFFF'FFFF'FFFF'FF01ULL);
 constexpr auto kMultiDraftCursorsTagOld = quint64(0xFFFF'FFFF'FFFF'FF02ULL);
 constexpr auto kMultiDraftTag = quint64(0xFFFF'FFFF'FFFF'FF03ULL);
@@ -83,6 +87,8 @@ enum { // Local Storage Keys
 	lskBackgroundOld = 0x14, // no data
 	lskSelfSerialized = 0x15, // serialized self
 	lskMasksKeys = 0x16, // no data
+	lskDialogsSnapshot = 0x17, // no data
+	lskContactsSnapshot = 0x18, // no data
 };
 
 auto EmptyMessageDraftSources()
@@ -197,6 +203,8 @@ base::flat_set<QString> Account::collectGoodNames() const {
 		_legacyBackgroundKeyNight,
 		_legacyBackgroundKeyDay,
 		_recentHashtagsAndBotsKey,
+		_dialogsSnapshotKey,
+		_contactsSnapshotKey,
 		_exportSettingsKey,
 		_trustedBotsKey,
 		_installedMasksKey,
@@ -286,6 +294,7 @@ Account::ReadMapResult Account::readMapWith(
 	quint64 savedGifsKey = 0;
 	quint64 legacyBackgroundKeyDay = 0, legacyBackgroundKeyNight = 0;
 	quint64 userSettingsKey = 0, recentHashtagsAndBotsKey = 0, exportSettingsKey = 0;
+	quint64 dialogsSnapshotKey = 0, contactsSnapshotKey = 0;
 	while (!map.stream.atEnd()) {
 		quint32 keyType;
 		map.stream >> keyType;
@@ -356,6 +365,12 @@ Account::ReadMapResult Account::readMapWith(
 		case lskRecentHashtagsAndBots: {
 			map.stream >> recentHashtagsAndBotsKey;
 		} break;
+		case lskDialogsSnapshot: {
+			map.stream >> dialogsSnapshotKey;
+		} break;
+		case lskContactsSnapshot: {
+			map.stream >> contactsSnapshotKey;
+		} break;
 		case lskStickersOld: {
 			map.stream >> installedStickersKey;
 		} break;
@@ -416,6 +431,8 @@ Account::ReadMapResult Account::readMapWith(
 	_legacyBackgroundKeyNight = legacyBackgroundKeyNight;
 	_settingsKey = userSettingsKey;
 	_recentHashtagsAndBotsKey = recentHashtagsAndBotsKey;
+	_dialogsSnapshotKey = dialogsSnapshotKey;
+	_contactsSnapshotKey = contactsSnapshotKey;
 	_exportSettingsKey = exportSettingsKey;
 	_oldMapVersion = mapData.version;
 
@@ -425,9 +442,8 @@ Account::ReadMapResult Account::readMapWith(
 		_mapChanged = false;
 	}
 
-	if (_locationsKey) {
-		readLocations();
-	}
+	// Locations are read lazily on the first file location request,
+	// parsing hundreds of thousands of entries here slows down startup.
 	if (_legacyBackgroundKeyDay || _legacyBackgroundKeyNight) {
 		Local::moveLegacyBackground(
 			_basePath,
@@ -515,6 +531,8 @@ void Account::writeMap() {
 	if (_savedGifsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_settingsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_recentHashtagsAndBotsKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_dialogsSnapshotKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_contactsSnapshotKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_exportSettingsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_installedMasksKey || _recentMasksKey || _archivedMasksKey) {
 		mapSize += sizeof(quint32) + 3 * sizeof(quint64);
@@ -561,6 +579,12 @@ void Account::writeMap() {
 	if (_recentHashtagsAndBotsKey) {
 		mapData.stream << quint32(lskRecentHashtagsAndBots) << quint64(_recentHashtagsAndBotsKey);
 	}
+	if (_dialogsSnapshotKey) {
+		mapData.stream << quint32(lskDialogsSnapshot) << quint64(_dialogsSnapshotKey);
+	}
+	if (_contactsSnapshotKey) {
+		mapData.stream << quint32(lskContactsSnapshot) << quint64(_contactsSnapshotKey);
+	}
 	if (_exportSettingsKey) {
 		mapData.stream << quint32(lskExportSettings) << quint64(_exportSettingsKey);
 	}
@@ -581,6 +605,9 @@ void Account::reset() {
 	_draftsMap.clear();
 	_draftCursorsMap.clear();
 	_draftsNotReadMap.clear();
+	_draftsWrittenHashes.clear();
+	_settingsWrittenHash = std::nullopt;
+	_mtpDataWrittenHash = std::nullopt;
 	_locationsKey = _trustedBotsKey = 0;
 	_recentStickersKeyOld = 0;
 	_installedStickersKey = 0;
@@ -594,10 +621,13 @@ void Account::reset() {
 	_archivedMasksKey = 0;
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
+	_dialogsSnapshotKey = 0;
+	_contactsSnapshotKey = 0;
 	_oldMapVersion = 0;
 	_fileLocations.clear();
 	_fileLocationPairs.clear();
 	_fileLocationAliases.clear();
+	_locationsRead = true;
 	_downloadsSerialize = nullptr;
 	_downloadsSerialized = QByteArray();
 	_cacheTotalSizeLimit = Database::Settings().totalSizeLimit;
@@ -629,6 +659,7 @@ void Account::writeLocations() {
 	if (!_locationsChanged) {
 		return;
 	}
+	readLocationsIfNeeded();
 	_locationsChanged = false;
 
 	if (_downloadsSerialize) {
@@ -715,6 +746,16 @@ void Account::writeLocationsDelayed() {
 	_writeLocationsTimer.callOnce(kDelayedWriteTimeout);
 }
 
+void Account::readLocationsIfNeeded() {
+	if (_locationsRead) {
+		return;
+	}
+	_locationsRead = true;
+	if (_locationsKey) {
+		readLocations();
+	}
+}
+
 void Account::readLocations() {
 	FileReadDescriptor locations;
 	if (!ReadEncryptedFile(locations, _locationsKey, _basePath, _localKey)) {
@@ -783,7 +824,8 @@ void Account::updateDownloads(
 	writeLocationsDelayed();
 }
 
-QByteArray Account::downloadsSerialized() const {
+QByteArray Account::downloadsSerialized() {
+	readLocationsIfNeeded();
 	return _downloadsSerialized;
 }
 
@@ -837,6 +879,15 @@ void Account::writeSessionSettings(Main::SessionSettings *stored) {
 	}
 	data.stream << quint32(dbiRecentStickers) << recentStickers;
 
+	// Settings are rewritten on lots of triggers, most of which don't
+	// change the serialized state, so don't encrypt and rewrite the
+	// file if the plain data matches what was already written.
+	const auto hash = hashMd5(data.data.constData(), data.data.size());
+	if (_settingsWrittenHash == hash) {
+		return;
+	}
+	_settingsWrittenHash = hash;
+
 	FileWriteDescriptor file(_settingsKey, _basePath);
 	file.writeEncrypted(data, _localKey);
 }
@@ -929,9 +980,16 @@ void Account::writeMtpData() {
 	const auto serialized = _owner->serializeMtpAuthorization();
 	const auto size = sizeof(quint32) + Serialize::bytearraySize(serialized);
 
-	FileWriteDescriptor mtp(ToFilePart(_dataNameKey), BaseGlobalPath());
 	EncryptedDescriptor data(size);
 	data.stream << quint32(dbiMtpAuthorization) << serialized;
+
+	const auto hash = hashMd5(data.data.constData(), data.data.size());
+	if (_mtpDataWrittenHash == hash) {
+		return;
+	}
+	_mtpDataWrittenHash = hash;
+
+	FileWriteDescriptor mtp(ToFilePart(_dataNameKey), BaseGlobalPath());
 	mtp.writeEncrypted(data, _localKey);
 }
 
@@ -1079,6 +1137,7 @@ void Account::writeDrafts(not_null<History*> history) {
 			writeMapDelayed();
 		}
 
+		_draftsWrittenHashes.remove(peerId);
 		_draftsNotReadMap.remove(peerId);
 		return;
 	}
@@ -1134,6 +1193,17 @@ void Account::writeDrafts(not_null<History*> history) {
 		sources,
 		writeCallback);
 
+	// Drafts are written on a timer while the user is typing, so most
+	// of the time the serialized content hasn't changed since the last
+	// write and we can skip the encrypt-and-rewrite entirely.
+	const auto hash = hashMd5(data.data.constData(), data.data.size());
+	const auto written = _draftsWrittenHashes.find(peerId);
+	if (written != _draftsWrittenHashes.cend() && written->second == hash) {
+		_draftsNotReadMap.remove(peerId);
+		return;
+	}
+	_draftsWrittenHashes[peerId] = hash;
+
 	FileWriteDescriptor file(i->second, _basePath);
 	file.writeEncrypted(data, _localKey);
 
@@ -1462,6 +1532,7 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 	if (local.fname.isEmpty()) {
 		return;
 	}
+	readLocationsIfNeeded();
 	if (!local.inMediaCache()) {
 		const auto aliasIt = _fileLocationAliases.constFind(location);
 		if (aliasIt != _fileLocationAliases.cend()) {
@@ -1501,6 +1572,7 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 }
 
 void Account::removeFileLocation(MediaKey location) {
+	readLocationsIfNeeded();
 	auto i = _fileLocations.find(location);
 	if (i == _fileLocations.end()) {
 		return;
@@ -1512,6 +1584,7 @@ void Account::removeFileLocation(MediaKey location) {
 }
 
 Core::FileLocation Account::readFileLocation(MediaKey location) {
+	readLocationsIfNeeded();
 	const auto aliasIt = _fileLocationAliases.constFind(location);
 	if (aliasIt != _fileLocationAliases.cend()) {
 		location = aliasIt.value();
@@ -1713,21 +1786,36 @@ void Account::writeStickerSets(
 		stickersKey = GenerateKey(_basePath);
 		writeMapQueued();
 	}
-	EncryptedDescriptor data(size);
+
+	// The sets are serialized to a buffer that is deflated before the
+	// encryption - the data is mostly short strings and ids, so it
+	// shrinks several times and each full rewrite costs that much less.
+	auto serialized = QByteArray();
+	serialized.reserve(size);
+	{
+		QDataStream stream(&serialized, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_1);
+		stream << qint32(setsCount);
+		for (const auto &[id, set] : sets) {
+			auto result = checkSet(*set);
+			if (result == StickerSetCheckResult::Abort) {
+				return;
+			} else if (result == StickerSetCheckResult::Skip) {
+				continue;
+			}
+			writeStickerSet(stream, *set);
+		}
+		stream << order;
+	}
+	const auto compressed = qCompress(serialized);
+
+	EncryptedDescriptor data(sizeof(quint32)
+		+ sizeof(qint32)
+		+ Serialize::bytearraySize(compressed));
 	data.stream
 		<< quint32(kStickersVersionTag)
 		<< qint32(kStickersSerializeVersion)
-		<< qint32(setsCount);
-	for (const auto &[id, set] : sets) {
-		auto result = checkSet(*set);
-		if (result == StickerSetCheckResult::Abort) {
-			return;
-		} else if (result == StickerSetCheckResult::Skip) {
-			continue;
-		}
-		writeStickerSet(data.stream, *set);
-	}
-	data.stream << order;
+		<< compressed;
 
 	FileWriteDescriptor file(stickersKey, _basePath);
 	file.writeEncrypted(data, _localKey);
@@ -1760,12 +1848,24 @@ void Account::readStickerSets(
 	stickers.stream >> versionTag >> version;
 	if (versionTag != kStickersVersionTag
 		|| version != kStickersSerializeVersion) {
-		// Old data, without sticker set thumbnails.
+		// Old data, without sticker set thumbnails or not deflated.
+		return failed();
+	}
+	QByteArray compressed;
+	stickers.stream >> compressed;
+	if (!CheckStreamStatus(stickers.stream)) {
+		return failed();
+	}
+	const auto serialized = qUncompress(compressed);
+	if (serialized.isEmpty()) {
 		return failed();
 	}
+	QDataStream stream(serialized);
+	stream.setVersion(QDataStream::Qt_5_1);
+
 	qint32 count = 0;
-	stickers.stream >> count;
-	if (!CheckStreamStatus(stickers.stream)
+	stream >> count;
+	if (!CheckStreamStatus(stream)
 		|| (count < 0)
 		|| (count > kMaxSavedStickerSetsCount)) {
 		return failed();
@@ -1779,7 +1879,7 @@ void Account::readStickerSets(
 		qint32 setFlagsValue = 0;
 		ImageLocation setThumbnail;
 
-		stickers.stream
+		stream
 			>> setId
 			>> setAccessHash
 			>> setHash
@@ -1790,8 +1890,8 @@ void Account::readStickerSets(
 			>> setInstallDate;
 		const auto thumbnail = Serialize::readImageLocation(
 			stickers.version,
-			stickers.stream);
-		if (!thumbnail || !CheckStreamStatus(stickers.stream)) {
+			stream);
+		if (!thumbnail || !CheckStreamStatus(stream)) {
 			return failed();
 		} else if (thumbnail->valid() && thumbnail->isLegacy()) {
 			// No thumb_version information in legacy location.
@@ -1860,8 +1960,8 @@ void Account::readStickerSets(
 			auto document = Serialize::Document::readStickerFromStream(
 				&_owner->session(),
 				stickers.version,
-				stickers.stream, info);
-			if (!CheckStreamStatus(stickers.stream)) {
+				stream, info);
+			if (!CheckStreamStatus(stream)) {
 				return failed();
 			} else if (!document
 				|| !document->sticker()
@@ -1881,7 +1981,7 @@ void Account::readStickerSets(
 		}
 
 		qint32 datesCount = 0;
-		stickers.stream >> datesCount;
+		stream >> datesCount;
 		if (datesCount > 0) {
 			if (datesCount != scnt) {
 				return failed();
@@ -1896,7 +1996,7 @@ void Account::readStickerSets(
 			}
 			for (auto i = 0; i != datesCount; ++i) {
 				qint32 date = 0;
-				stickers.stream >> date;
+				stream >> date;
 				if (fillDates) {
 					set->dates.push_back(TimeId(date));
 				}
@@ -1904,19 +2004,19 @@ void Account::readStickerSets(
 		}
 
 		qint32 emojiCount = 0;
-		stickers.stream >> emojiCount;
-		if (!CheckStreamStatus(stickers.stream) || emojiCount < 0) {
+		stream >> emojiCount;
+		if (!CheckStreamStatus(stream) || emojiCount < 0) {
 			return failed();
 		}
 		for (int32 j = 0; j < emojiCount; ++j) {
 			QString emojiString;
 			qint32 stickersCount;
-			stickers.stream >> emojiString >> stickersCount;
+			stream >> emojiString >> stickersCount;
 			Data::StickersPack pack;
 			pack.reserve(stickersCount);
 			for (int32 k = 0; k < stickersCount; ++k) {
 				quint64 id;
-				stickers.stream >> id;
+				stream >> id;
 				const auto doc = _owner->session().data().document(id);
 				if (!doc->sticker()) continue;
 
@@ -1934,22 +2034,22 @@ void Account::readStickerSets(
 	// Read orders of installed and featured stickers.
 	if (outOrder) {
 		auto outOrderCount = quint32();
-		stickers.stream >> outOrderCount;
-		if (!CheckStreamStatus(stickers.stream) || outOrderCount > 1000) {
+		stream >> outOrderCount;
+		if (!CheckStreamStatus(stream) || outOrderCount > 1000) {
 			return failed();
 		}
 		outOrder->reserve(outOrderCount);
 		for (auto i = 0; i != outOrderCount; ++i) {
 			auto value = uint64();
-			stickers.stream >> value;
-			if (!CheckStreamStatus(stickers.stream)) {
+			stream >> value;
+			if (!CheckStreamStatus(stream)) {
 				outOrder->clear();
 				return failed();
 			}
 			outOrder->push_back(value);
 		}
 	}
-	if (!CheckStreamStatus(stickers.stream)) {
+	if (!CheckStreamStatus(stream)) {
 		return failed();
 	}
 
@@ -2463,6 +2563,170 @@ void Account::readRecentHashtagsAndBots() {
 	}
 }
 
+void Account::writeDialogsSnapshot() {
+	if (!_localKey || !_owner->sessionExists()) {
+		return;
+	}
+
+	// A small skeleton of the chats list (row order, unread counts) that
+	// lets the main window paint real content right at launch, before
+	// the dialogs arrive from the server.
+	auto &owner = _owner->session().data();
+	auto histories = std::vector<not_null<History*>>();
+	histories.reserve(kDialogsSnapshotLimit);
+	for (const auto &row : *owner.chatsList()->indexed()) {
+		if (const auto history = row->history()) {
+			histories.push_back(history);
+			if (int(histories.size()) == kDialogsSnapshotLimit) {
+				break;
+			}
+		}
+	}
+	if (histories.empty()) {
+		if (_dialogsSnapshotKey) {
+			ClearKey(_dialogsSnapshotKey, _basePath);
+			_dialogsSnapshotKey = 0;
+			writeMapDelayed();
+		}
+		return;
+	}
+	if (!_dialogsSnapshotKey) {
+		_dialogsSnapshotKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	quint32 size = sizeof(quint32);
+	for (const auto &history : histories) {
+		size += Serialize::peerSize(history->peer) + 2 * sizeof(qint32);
+	}
+	EncryptedDescriptor data(size);
+	data.stream << quint32(histories.size());
+	for (const auto &history : histories) {
+		Serialize::writePeer(data.stream, history->peer);
+		data.stream
+			<< qint32(history->unreadCount())
+			<< qint32(history->chatListTimeId());
+	}
+	FileWriteDescriptor file(_dialogsSnapshotKey, _basePath);
+	file.writeEncrypted(data, _localKey);
+}
+
+void Account::readDialogsSnapshot() {
+	if (!_dialogsSnapshotKey) {
+		return;
+	}
+
+	FileReadDescriptor snapshot;
+	if (!ReadEncryptedFile(snapshot, _dialogsSnapshotKey, _basePath, _localKey)) {
+		ClearKey(_dialogsSnapshotKey, _basePath);
+		_dialogsSnapshotKey = 0;
+		writeMapDelayed();
+		return;
+	}
+
+	quint32 count = 0;
+	snapshot.stream >> count;
+	if (!CheckStreamStatus(snapshot.stream)
+		|| !count
+		|| count > kDialogsSnapshotLimit) {
+		return;
+	}
+	auto &owner = _owner->session().data();
+	for (auto i = quint32(0); i != count; ++i) {
+		const auto peer = Serialize::readPeer(
+			&_owner->session(),
+			snapshot.version,
+			snapshot.stream);
+		qint32 unreadCount = 0, timeId = 0;
+		snapshot.stream >> unreadCount >> timeId;
+		if (!peer || !CheckStreamStatus(snapshot.stream)) {
+			return; // Broken data.
+		}
+		const auto history = owner.history(peer->id);
+		if (history->inChatList()) {
+			continue;
+		}
+		history->clearFolder();
+		history->setChatListTimeId(timeId);
+		history->addToChatList(FilterId(), owner.chatsList());
+		history->setUnreadCount(unreadCount);
+	}
+}
+
+void Account::writeContactsSnapshot() {
+	if (!_localKey || !_owner->sessionExists()) {
+		return;
+	}
+
+	// The full contact users list, so that the next launch can compute
+	// the contacts hash and skip re-downloading an unchanged list.
+	auto &owner = _owner->session().data();
+	auto users = std::vector<not_null<PeerData*>>();
+	users.reserve(owner.contactsList()->size());
+	for (const auto &row : *owner.contactsList()) {
+		if (const auto history = row->history()) {
+			if (history->peer->isUser()) {
+				users.push_back(history->peer);
+			}
+		}
+	}
+	if (users.empty() || int(users.size()) > kContactsSnapshotLimit) {
+		if (_contactsSnapshotKey) {
+			ClearKey(_contactsSnapshotKey, _basePath);
+			_contactsSnapshotKey = 0;
+			writeMapDelayed();
+		}
+		return;
+	}
+	if (!_contactsSnapshotKey) {
+		_contactsSnapshotKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	quint32 size = sizeof(quint32);
+	for (const auto &user : users) {
+		size += Serialize::peerSize(user);
+	}
+	EncryptedDescriptor data(size);
+	data.stream << quint32(users.size());
+	for (const auto &user : users) {
+		Serialize::writePeer(data.stream, user);
+	}
+	FileWriteDescriptor file(_contactsSnapshotKey, _basePath);
+	file.writeEncrypted(data, _localKey);
+}
+
+void Account::readContactsSnapshot() {
+	if (!_contactsSnapshotKey) {
+		return;
+	}
+
+	FileReadDescriptor snapshot;
+	if (!ReadEncryptedFile(snapshot, _contactsSnapshotKey, _basePath, _localKey)) {
+		ClearKey(_contactsSnapshotKey, _basePath);
+		_contactsSnapshotKey = 0;
+		writeMapDelayed();
+		return;
+	}
+
+	quint32 count = 0;
+	snapshot.stream >> count;
+	if (!CheckStreamStatus(snapshot.stream)
+		|| !count
+		|| count > kContactsSnapshotLimit) {
+		return;
+	}
+	for (auto i = quint32(0); i != count; ++i) {
+		// readPeer restores the contact flag, so the user lands in the
+		// contacts list and takes part in the contacts hash computation.
+		const auto peer = Serialize::readPeer(
+			&_owner->session(),
+			snapshot.version,
+			snapshot.stream);
+		if (!peer || !CheckStreamStatus(snapshot.stream)) {
+			return; // Broken data.
+		}
+	}
+}
+
 std::optional<RecentHashtagPack> Account::saveRecentHashtags(
 		Fn<RecentHashtagPack()> getPack,
 		const QString &text) {
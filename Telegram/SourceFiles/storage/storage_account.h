@@ -104,7 +104,7 @@ public:
 	void removeFileLocation(MediaKey location);
 
 	void updateDownloads(Fn<std::optional<QByteArray>()> downloadsSerialize);
-	[[nodiscard]] QByteArray downloadsSerialized() const;
+	[[nodiscard]] QByteArray downloadsSerialized();
 
 	[[nodiscard]] EncryptionKey cacheKey() const;
 	[[nodiscard]] QString cachePath() const;
@@ -136,6 +136,12 @@ public:
 	void readInstalledMasks();
 	void readRecentMasks();
 
+	void writeDialogsSnapshot();
+	void readDialogsSnapshot();
+
+	void writeContactsSnapshot();
+	void readContactsSnapshot();
+
 	void writeRecentHashtagsAndBots();
 	void readRecentHashtagsAndBots();
 	void saveRecentSentHashtags(const QString &text);
@@ -196,6 +202,7 @@ private:
 	void writeMap();
 
 	void readLocations();
+	void readLocationsIfNeeded();
 	void writeLocations();
 	void writeLocationsQueued();
 	void writeLocationsDelayed();
@@ -253,6 +260,9 @@ private:
 	base::flat_map<PeerId, FileKey> _draftsMap;
 	base::flat_map<PeerId, FileKey> _draftCursorsMap;
 	base::flat_map<PeerId, bool> _draftsNotReadMap;
+	base::flat_map<PeerId, std::array<char, 16>> _draftsWrittenHashes;
+	std::optional<std::array<char, 16>> _settingsWrittenHash;
+	std::optional<std::array<char, 16>> _mtpDataWrittenHash;
 	base::flat_map<
 		not_null<History*>,
 		base::flat_map<Data::DraftKey, MessageDraftSource>> _draftSources;
@@ -278,6 +288,8 @@ private:
 	FileKey _legacyBackgroundKeyNight = 0;
 	FileKey _settingsKey = 0;
 	FileKey _recentHashtagsAndBotsKey = 0;
+	FileKey _dialogsSnapshotKey = 0;
+	FileKey _contactsSnapshotKey = 0;
 	FileKey _exportSettingsKey = 0;
 	FileKey _installedMasksKey = 0;
 	FileKey _recentMasksKey = 0;
@@ -298,6 +310,7 @@ private:
 	base::Timer _writeLocationsTimer;
 	bool _mapChanged = false;
 	bool _locationsChanged = false;
+	bool _locationsRead = false;
 
 };
 
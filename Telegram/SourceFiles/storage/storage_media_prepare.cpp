@@ -85,6 +85,55 @@ void PrepareDetailsInParallel(PreparedList &result, int previewWidth) {
 	semaphore.acquire(result.files.size());
 }
 
+PreparedList ListFiles(const QStringList &files) {
+	auto result = PreparedList();
+	result.files.reserve(files.size());
+	for (const auto &file : files) {
+		const auto fileinfo = QFileInfo(file);
+		const auto filesize = fileinfo.size();
+		if (fileinfo.isDir()) {
+			return {
+				PreparedList::Error::Directory,
+				file
+			};
+		} else if (filesize <= 0) {
+			return {
+				PreparedList::Error::EmptyFile,
+				file
+			};
+		} else if (filesize > kFileSizeLimit) {
+			return {
+				PreparedList::Error::TooLargeFile,
+				file
+			};
+		}
+		if (result.files.size() < Ui::MaxAlbumItems()) {
+			result.files.emplace_back(file);
+			result.files.back().size = filesize;
+		} else {
+			result.filesToProcess.emplace_back(file);
+			result.files.back().size = filesize;
+		}
+	}
+	return result;
+}
+
+PreparedList ListFromImage(QImage &&image, QByteArray &&content) {
+	auto result = PreparedList();
+	auto file = PreparedFile(QString());
+	file.content = content;
+	if (file.content.isEmpty()) {
+		file.information = std::make_unique<PreparedFileInformation>();
+		const auto animated = false;
+		FileLoadTask::FillImageInformation(
+			std::move(image),
+			animated,
+			file.information);
+	}
+	result.files.push_back(std::move(file));
+	return result;
+}
+
 } // namespace
 
 bool ValidatePhotoEditorMediaDragData(not_null<const QMimeData*> data) {
@@ -179,6 +228,29 @@ MimeDataState ComputeMimeDataState(const QMimeData *data) {
 }
 
 PreparedList PrepareMediaList(const QList<QUrl> &files, int previewWidth) {
+	auto result = ListMediaFiles(files);
+	PrepareDetailsInParallel(result, previewWidth);
+	return result;
+}
+
+PreparedList PrepareMediaList(const QStringList &files, int previewWidth) {
+	auto result = ListFiles(files);
+	PrepareDetailsInParallel(result, previewWidth);
+	return result;
+}
+
+PreparedList PrepareMediaFromImage(
+		QImage &&image,
+		QByteArray &&content,
+		int previewWidth) {
+	Expects(!image.isNull());
+
+	auto result = ListFromImage(std::move(image), std::move(content));
+	PrepareDetailsInParallel(result, previewWidth);
+	return result;
+}
+
+PreparedList ListMediaFiles(const QList<QUrl> &files) {
 	auto locals = QStringList();
 	locals.reserve(files.size());
 	for (const auto &url : files) {
@@ -190,63 +262,49 @@ PreparedList PrepareMediaList(const QList<QUrl> &files, int previewWidth) {
 		}
 		locals.push_back(Platform::File::UrlToLocal(url));
 	}
-	return PrepareMediaList(locals, previewWidth);
+	return ListFiles(locals);
 }
 
-PreparedList PrepareMediaList(const QStringList &files, int previewWidth) {
-	auto result = PreparedList();
-	result.files.reserve(files.size());
-	for (const auto &file : files) {
-		const auto fileinfo = QFileInfo(file);
-		const auto filesize = fileinfo.size();
-		if (fileinfo.isDir()) {
-			return {
-				PreparedList::Error::Directory,
-				file
-			};
-		} else if (filesize <= 0) {
-			return {
-				PreparedList::Error::EmptyFile,
-				file
-			};
-		} else if (filesize > kFileSizeLimit) {
-			return {
-				PreparedList::Error::TooLargeFile,
-				file
-			};
-		}
-		if (result.files.size() < Ui::MaxAlbumItems()) {
-			result.files.emplace_back(file);
-			result.files.back().size = filesize;
-		} else {
-			result.filesToProcess.emplace_back(file);
-			result.files.back().size = filesize;
-		}
+void PrepareDetailsAsync(
+		PreparedList &&list,
+		int previewWidth,
+		Fn<void(PreparedList&&)> done) {
+	Expects(done != nullptr);
+
+	if (list.files.empty() || list.error != PreparedList::Error::None) {
+		done(std::move(list));
+		return;
 	}
-	PrepareDetailsInParallel(result, previewWidth);
-	return result;
+	crl::async([
+		list = std::move(list),
+		previewWidth,
+		done = std::move(done)
+	]() mutable {
+		// Sequentially - we're off the main thread already and blocking
+		// this worker on the fan-out semaphore could starve the pool.
+		for (auto &file : list.files) {
+			PrepareDetails(file, previewWidth);
+		}
+		crl::on_main([
+			list = std::move(list),
+			done = std::move(done)
+		]() mutable {
+			done(std::move(list));
+		});
+	});
 }
 
-PreparedList PrepareMediaFromImage(
+void PrepareMediaFromImageAsync(
 		QImage &&image,
 		QByteArray &&content,
-		int previewWidth) {
+		int previewWidth,
+		Fn<void(PreparedList&&)> done) {
 	Expects(!image.isNull());
 
-	auto result = PreparedList();
-	auto file = PreparedFile(QString());
-	file.content = content;
-	if (file.content.isEmpty()) {
-		file.information = std::make_unique<PreparedFileInformation>();
-		const auto animated = false;
-		FileLoadTask::FillImageInformation(
-			std::move(image),
-			animated,
-			file.information);
-	}
-	result.files.push_back(std::move(file));
-	PrepareDetailsInParallel(result, previewWidth);
-	return result;
+	PrepareDetailsAsync(
+		ListFromImage(std::move(image), std::move(content)),
+		previewWidth,
+		std::move(done));
 }
 
 std::optional<PreparedList> PreparedFileFromFilesDialog(
@@ -47,6 +47,21 @@ enum class MimeDataState {
 	QImage &&image,
 	QByteArray &&content,
 	int previewWidth);
+
+// Cheap part of PrepareMediaList - checks the files and fills the list
+// (with a possible error), without decoding previews. Finish the list
+// with PrepareDetailsAsync before showing it.
+[[nodiscard]] Ui::PreparedList ListMediaFiles(const QList<QUrl> &files);
+void PrepareDetailsAsync(
+	Ui::PreparedList &&list,
+	int previewWidth,
+	Fn<void(Ui::PreparedList&&)> done);
+void PrepareMediaFromImageAsync(
+	QImage &&image,
+	QByteArray &&content,
+	int previewWidth,
+	Fn<void(Ui::PreparedList&&)> done);
+
 void PrepareDetails(Ui::PreparedFile &file, int previewWidth);
 void UpdateImageDetails(Ui::PreparedFile &file, int previewWidth);
 
@@ -23,6 +23,8 @@ void SparseIdsList::Slice::merge(
 	Expects(moreNoSkipRange.from <= range.till);
 	Expects(range.from <= moreNoSkipRange.till);
 
+	messages.reserve(messages.size()
+		+ (std::end(moreMessages) - std::begin(moreMessages)));
 	messages.merge(std::begin(moreMessages), std::end(moreMessages));
 	range = {
 		qMin(range.from, moreNoSkipRange.from),
@@ -249,8 +251,7 @@ SparseIdsListResult SparseIdsList::queryFromSlice(
 	auto haveEqualOrAfter = int(slice.messages.end() - position);
 	auto before = qMin(haveBefore, query.limitBefore);
 	auto equalOrAfter = qMin(haveEqualOrAfter, query.limitAfter + 1);
-	auto ids = std::vector<MsgId>(position - before, position + equalOrAfter);
-	result.messageIds.merge(ids.begin(), ids.end());
+	result.messageIds.merge(position - before, position + equalOrAfter);
 	if (slice.range.from == 0) {
 		result.skippedBefore = haveBefore - before;
 	}
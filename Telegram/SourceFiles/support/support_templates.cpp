@@ -276,6 +276,7 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 
 	auto uniqueFirst = std::map<QChar, base::flat_set<Id>>();
 	auto uniqueFull = std::map<Id, base::flat_set<Term>>();
+	auto uniqueKeys = std::map<QString, Id>();
 	const auto pushString = [&](
 			const Id &id,
 			const QString &string,
@@ -291,6 +292,7 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 			const auto id = std::make_pair(path, normalized);
 			for (const auto &key : question.normalizedKeys) {
 				pushString(id, key, kWeightStep * kWeightStep);
+				uniqueKeys.emplace(key, id);
 			}
 			pushString(id, question.question, kWeightStep);
 			pushString(id, question.value, 1);
@@ -304,6 +306,7 @@ TemplatesIndex ComputeIndex(const TemplatesData &data) {
 	for (const auto &[id, unique] : uniqueFull) {
 		result.full.emplace(id, unique | ranges::to_vector);
 	}
+	result.keys = std::move(uniqueKeys);
 	return result;
 }
 
@@ -340,6 +343,17 @@ void ReplaceFileIndex(
 			std::make_move_iterator(end(list)));
 		ranges::sort(to);
 	}
+
+	for (auto i = begin(result.keys); i != end(result.keys);) {
+		if (i->second.first == path) {
+			i = result.keys.erase(i);
+		} else {
+			++i;
+		}
+	}
+	for (auto &[key, id] : source.keys) {
+		result.keys.emplace(key, id);
+	}
 }
 
 void MoveKeys(TemplatesFile &to, const TemplatesFile &from) {
@@ -622,16 +636,15 @@ auto Templates::matchExact(QString query) const
 
 	query = NormalizeKey(query);
 
-	for (const auto &[path, file] : _data.files) {
-		for (const auto &[normalized, question] : file.questions) {
-			for (const auto &key : question.normalizedKeys) {
-				if (key == query) {
-					return QuestionByKey{ question, key };
-				}
-			}
-		}
+	const auto i = _index.keys.find(query);
+	if (i == end(_index.keys)) {
+		return {};
 	}
-	return {};
+	const auto &id = i->second;
+	return QuestionByKey{
+		_data.files.at(id.first).questions.at(id.second),
+		i->first,
+	};
 }
 
 auto Templates::matchFromEnd(QString query) const
@@ -640,26 +653,24 @@ auto Templates::matchFromEnd(QString query) const
 		query = query.mid(query.size() - _maxKeyLength);
 	}
 
+	// Longest key first, so the first found suffix wins.
 	const auto size = query.size();
-	auto queries = std::vector<QString>();
-	queries.reserve(size);
-	for (auto i = 0; i != size; ++i) {
-		queries.push_back(NormalizeKey(query.mid(size - i - 1)));
-	}
-
-	auto result = std::optional<QuestionByKey>();
-	for (const auto &[path, file] : _data.files) {
-		for (const auto &[normalized, question] : file.questions) {
-			for (const auto &key : question.normalizedKeys) {
-				if (key.size() <= queries.size()
-					&& queries[key.size() - 1] == key
-					&& (!result || result->key.size() <= key.size())) {
-					result = QuestionByKey{ question, key };
-				}
-			}
+	for (auto length = size; length != 0; --length) {
+		const auto key = NormalizeKey(query.mid(size - length));
+		if (key.size() != length) {
+			continue;
+		}
+		const auto i = _index.keys.find(key);
+		if (i == end(_index.keys)) {
+			continue;
 		}
+		const auto &id = i->second;
+		return QuestionByKey{
+			_data.files.at(id.first).questions.at(id.second),
+			i->first,
+		};
 	}
-	return result;
+	return {};
 }
 
 Templates::~Templates() = default;
@@ -40,6 +40,7 @@ struct TemplatesIndex {
 
 	std::map<QChar, std::vector<Id>> first;
 	std::map<Id, std::vector<Term>> full;
+	std::map<QString, Id> keys;
 };
 
 } // namespace details
@@ -19,7 +19,8 @@ namespace Ui {
 namespace {
 
 std::vector<CornersPixmaps> Corners;
-base::flat_map<uint32, CornersPixmaps> CornersMap;
+bool PaletteCornersDirty/* = false*/;
+base::flat_map<uint64, CornersPixmaps> CornersMap;
 QImage CornersMaskLarge[4], CornersMaskSmall[4];
 rpl::lifetime PaletteChangedLifetime;
 
@@ -90,6 +91,20 @@ void CreatePaletteCorners() {
 	PrepareCorners(Doc4Corners, st::roundRadiusSmall, st::msgFile4Bg);
 }
 
+[[nodiscard]] const CornersPixmaps &ValidatedCorners(
+		CachedRoundCorners index) {
+	Expects(index < Corners.size());
+
+	// Theme switches and palette animations fire PaletteChanged many
+	// times in a row, so the regeneration is coalesced and runs once
+	// before the next paint that actually uses the corners.
+	if (PaletteCornersDirty) {
+		PaletteCornersDirty = false;
+		CreatePaletteCorners();
+	}
+	return Corners[index];
+}
+
 } // namespace
 
 void StartCachedCorners() {
@@ -99,7 +114,8 @@ void StartCachedCorners() {
 
 	style::PaletteChanged(
 	) | rpl::start_with_next([=] {
-		CreatePaletteCorners();
+		PaletteCornersDirty = true;
+		CornersMap.clear();
 	}, PaletteChangedLifetime);
 }
 
@@ -154,11 +170,11 @@ void FillRoundRect(Painter &p, int32 x, int32 y, int32 w, int32 h, style::color
 }
 
 void FillRoundRect(Painter &p, int32 x, int32 y, int32 w, int32 h, style::color bg, CachedRoundCorners index, const style::color *shadow, RectParts parts) {
-	FillRoundRect(p, x, y, w, h, bg, Corners[index], shadow, parts);
+	FillRoundRect(p, x, y, w, h, bg, ValidatedCorners(index), shadow, parts);
 }
 
 void FillRoundShadow(Painter &p, int32 x, int32 y, int32 w, int32 h, style::color shadow, CachedRoundCorners index, RectParts parts) {
-	FillRoundShadow(p, x, y, w, h, shadow, Corners[index], parts);
+	FillRoundShadow(p, x, y, w, h, shadow, ValidatedCorners(index), parts);
 }
 
 void FillRoundShadow(Painter &p, int32 x, int32 y, int32 w, int32 h, style::color shadow, const CornersPixmaps &corner, RectParts parts) {
@@ -206,10 +222,11 @@ void FillRoundRect(Painter &p, int32 x, int32 y, int32 w, int32 h, style::color
 		| ((uint32(bg->c.red()) & 0xFF) << 16)
 		| ((uint32(bg->c.green()) & 0xFF) << 8)
 		| ((uint32(bg->c.blue()) & 0xFF));
-	auto i = CornersMap.find(colorKey);
+	const auto key = (uint64(radius) << 32) | colorKey;
+	auto i = CornersMap.find(key);
 	if (i == end(CornersMap)) {
 		i = CornersMap.emplace(
-			colorKey,
+			key,
 			PrepareCornerPixmaps(radius, bg, nullptr)).first;
 	}
 	FillRoundRect(p, x, y, w, h, bg, i->second, nullptr, parts);
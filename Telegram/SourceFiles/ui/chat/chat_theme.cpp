@@ -23,6 +23,11 @@ namespace {
 constexpr auto kMaxChatEntryHistorySize = 50;
 constexpr auto kCacheBackgroundTimeout = 1 * crl::time(1000);
 constexpr auto kCacheBackgroundFastTimeout = crl::time(200);
+
+// Toggling a side panel or restoring a maximized window comes back to a
+// recently used viewport size, keep a few generated backgrounds around
+// so those don't wait for the full tile / scale pass again.
+constexpr auto kBackgroundResultsLimit = 3;
 constexpr auto kBackgroundFadeDuration = crl::time(200);
 constexpr auto kMinimumTiledSize = 512;
 constexpr auto kMaxSize = 2960;
@@ -412,6 +417,7 @@ void ChatTheme::setBackground(ChatThemeBackground &&background) {
 	_mutableBackground = std::move(background);
 	_backgroundState = {};
 	_backgroundNext = {};
+	clearCachedResults();
 	_backgroundFade.stop();
 	if (_cacheBackgroundTimer) {
 		_cacheBackgroundTimer->cancel();
@@ -423,6 +429,7 @@ void ChatTheme::updateBackgroundImageFrom(ChatThemeBackground &&background) {
 	_mutableBackground.prepared = std::move(background.prepared);
 	_mutableBackground.preparedForTiled = std::move(
 		background.preparedForTiled);
+	clearCachedResults();
 	if (!_backgroundState.now.pixmap.isNull()) {
 		if (_cacheBackgroundTimer) {
 			_cacheBackgroundTimer->cancel();
@@ -510,7 +517,11 @@ const BackgroundState &ChatTheme::backgroundState(QSize area) {
 		setCachedBackground(CacheBackground(cacheBackgroundRequest(area)));
 		_cacheBackgroundTimer->cancel();
 	} else if (_backgroundState.now.area != area) {
-		if (_cacheBackgroundArea != area
+		if (const auto cached = findCachedResult(area)) {
+			setCachedBackground(CacheBackgroundResult(*cached));
+			_cacheBackgroundArea = area;
+			_cacheBackgroundTimer->cancel();
+		} else if (_cacheBackgroundArea != area
 			|| (!_cacheBackgroundTimer->isActive()
 				&& !_backgroundCachingRequest)) {
 			_cacheBackgroundArea = area;
@@ -564,6 +575,7 @@ void ChatTheme::generateNextBackgroundRotation() {
 			_mutableBackground.gradientRotation
 				= (_mutableBackground.gradientRotation
 					+ kAddRotationDoubled) % 720;
+			clearCachedResults();
 			_backgroundNext = std::move(result);
 		}
 	});
@@ -629,6 +641,7 @@ void ChatTheme::cacheBackgroundAsync(
 
 void ChatTheme::setCachedBackground(CacheBackgroundResult &&cached) {
 	_backgroundNext = {};
+	addCachedResult(cached);
 
 	if (background().gradientForFill.isNull()
 		|| _backgroundState.now.pixmap.isNull()
@@ -656,6 +669,32 @@ void ChatTheme::setCachedBackground(CacheBackgroundResult &&cached) {
 		kBackgroundFadeDuration);
 }
 
+const CacheBackgroundResult *ChatTheme::findCachedResult(QSize area) const {
+	for (const auto &result : _backgroundResults) {
+		if (result.area == area && !result.waitingForNegativePattern) {
+			return &result;
+		}
+	}
+	return nullptr;
+}
+
+void ChatTheme::addCachedResult(const CacheBackgroundResult &result) {
+	for (auto &existing : _backgroundResults) {
+		if (existing.area == result.area) {
+			existing = result;
+			return;
+		}
+	}
+	while (_backgroundResults.size() >= kBackgroundResultsLimit) {
+		_backgroundResults.erase(begin(_backgroundResults));
+	}
+	_backgroundResults.push_back(result);
+}
+
+void ChatTheme::clearCachedResults() {
+	_backgroundResults.clear();
+}
+
 auto ChatTheme::cacheBubblesRequest(QSize area) const
 -> CacheBackgroundRequest {
 	if (_bubblesBackgroundPrepared.isNull()) {
@@ -725,6 +764,7 @@ void ChatTheme::rotateComplexGradientBackground() {
 			_mutableBackground.gradientForFill
 				= std::move(_backgroundNext.gradient);
 		}
+		clearCachedResults();
 		setCachedBackground(base::take(_backgroundNext));
 	}
 }
@@ -181,6 +181,10 @@ private:
 		const CacheBackgroundRequest &request,
 		Fn<void(CacheBackgroundResult&&)> done = nullptr);
 	void setCachedBackground(CacheBackgroundResult &&cached);
+	[[nodiscard]] const CacheBackgroundResult *findCachedResult(
+		QSize area) const;
+	void addCachedResult(const CacheBackgroundResult &result);
+	void clearCachedResults();
 	[[nodiscard]] CacheBackgroundRequest cacheBackgroundRequest(
 		QSize area,
 		int addRotation = 0) const;
@@ -208,6 +212,7 @@ private:
 	Animations::Simple _backgroundFade;
 	CacheBackgroundRequest _backgroundCachingRequest;
 	CacheBackgroundResult _backgroundNext;
+	std::vector<CacheBackgroundResult> _backgroundResults;
 	QSize _cacheBackgroundArea;
 	crl::time _lastBackgroundAreaChangeTime = 0;
 	std::optional<base::Timer> _cacheBackgroundTimer;
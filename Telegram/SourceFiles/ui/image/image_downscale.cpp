@@ -0,0 +1,202 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "ui/image/image_downscale.h"
+
+#if defined Q_PROCESSOR_X86
+#include <immintrin.h>
+#if defined Q_CC_MSVC
+#include <intrin.h>
+#endif // Q_CC_MSVC
+#elif defined Q_PROCESSOR_ARM && defined(__ARM_NEON) // Q_PROCESSOR_X86
+#include <arm_neon.h>
+#endif // Q_PROCESSOR_ARM && __ARM_NEON
+
+namespace Images {
+namespace {
+
+// Each kernel averages two source rows of (2 * dstWidth) pixels into one
+// destination row of dstWidth pixels, channel-wise with rounding. Valid
+// only for 32-bit formats where channels are independent (Format_RGB32,
+// Format_ARGB32_Premultiplied).
+using HalveRowPair = void (*)(
+	const uchar *above,
+	const uchar *below,
+	uchar *dst,
+	int dstWidth);
+
+void HalveRowPairScalar(
+		const uchar *above,
+		const uchar *below,
+		uchar *dst,
+		int dstWidth) {
+	for (auto x = 0; x != dstWidth; ++x) {
+		const auto a = above + 8 * x;
+		const auto b = below + 8 * x;
+		const auto d = dst + 4 * x;
+		for (auto c = 0; c != 4; ++c) {
+			d[c] = uchar((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) >> 2);
+		}
+	}
+}
+
+#if defined Q_PROCESSOR_X86
+
+// SSE2 is our x86 build baseline, no runtime check needed.
+void HalveRowPairSse2(
+		const uchar *above,
+		const uchar *below,
+		uchar *dst,
+		int dstWidth) {
+	auto x = 0;
+	for (; x + 2 <= dstWidth; x += 2) {
+		const auto a = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(above + 8 * x));
+		const auto b = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(below + 8 * x));
+		const auto v = _mm_avg_epu8(a, b);
+		const auto h = _mm_avg_epu8(v, _mm_srli_si128(v, 4));
+		_mm_storel_epi64(
+			reinterpret_cast<__m128i*>(dst + 4 * x),
+			_mm_shuffle_epi32(h, _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+	HalveRowPairScalar(above + 8 * x, below + 8 * x, dst + 4 * x, dstWidth - x);
+}
+
+#if defined Q_CC_MSVC
+#define IMAGE_DOWNSCALE_TARGET_AVX2
+#else // Q_CC_MSVC
+#define IMAGE_DOWNSCALE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif // !Q_CC_MSVC
+
+IMAGE_DOWNSCALE_TARGET_AVX2 void HalveRowPairAvx2(
+		const uchar *above,
+		const uchar *below,
+		uchar *dst,
+		int dstWidth) {
+	const auto compact = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+	auto x = 0;
+	for (; x + 4 <= dstWidth; x += 4) {
+		const auto a = _mm256_loadu_si256(
+			reinterpret_cast<const __m256i*>(above + 8 * x));
+		const auto b = _mm256_loadu_si256(
+			reinterpret_cast<const __m256i*>(below + 8 * x));
+		const auto v = _mm256_avg_epu8(a, b);
+		const auto h = _mm256_avg_epu8(v, _mm256_srli_si256(v, 4));
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i*>(dst + 4 * x),
+			_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(h, compact)));
+	}
+	HalveRowPairSse2(above + 8 * x, below + 8 * x, dst + 4 * x, dstWidth - x);
+}
+
+[[nodiscard]] bool CpuHasAvx2() {
+#if defined Q_CC_MSVC
+	int data[4] = { 0 };
+	__cpuidex(data, 7, 0);
+	return (data[1] & (1 << 5)) != 0;
+#else // Q_CC_MSVC
+	return __builtin_cpu_supports("avx2");
+#endif // !Q_CC_MSVC
+}
+
+#elif defined Q_PROCESSOR_ARM && defined(__ARM_NEON) // Q_PROCESSOR_X86
+
+void HalveRowPairNeon(
+		const uchar *above,
+		const uchar *below,
+		uchar *dst,
+		int dstWidth) {
+	auto x = 0;
+	for (; x + 4 <= dstWidth; x += 4) {
+		const auto a = vld2q_u32(
+			reinterpret_cast<const uint32_t*>(above + 8 * x));
+		const auto b = vld2q_u32(
+			reinterpret_cast<const uint32_t*>(below + 8 * x));
+		const auto ah = vrhaddq_u8(
+			vreinterpretq_u8_u32(a.val[0]),
+			vreinterpretq_u8_u32(a.val[1]));
+		const auto bh = vrhaddq_u8(
+			vreinterpretq_u8_u32(b.val[0]),
+			vreinterpretq_u8_u32(b.val[1]));
+		vst1q_u32(
+			reinterpret_cast<uint32_t*>(dst + 4 * x),
+			vreinterpretq_u32_u8(vrhaddq_u8(ah, bh)));
+	}
+	HalveRowPairScalar(above + 8 * x, below + 8 * x, dst + 4 * x, dstWidth - x);
+}
+
+#endif // Q_PROCESSOR_ARM && __ARM_NEON
+
+[[nodiscard]] HalveRowPair ChooseHalveRowPair() {
+#if defined Q_PROCESSOR_X86
+	return CpuHasAvx2() ? HalveRowPairAvx2 : HalveRowPairSse2;
+#elif defined Q_PROCESSOR_ARM && defined(__ARM_NEON) // Q_PROCESSOR_X86
+	return HalveRowPairNeon;
+#else // Q_PROCESSOR_ARM && __ARM_NEON
+	return HalveRowPairScalar;
+#endif // !Q_PROCESSOR_X86 && !(Q_PROCESSOR_ARM && __ARM_NEON)
+}
+
+[[nodiscard]] HalveRowPair SelectedHalveRowPair() {
+	static const auto result = ChooseHalveRowPair();
+	return result;
+}
+
+[[nodiscard]] QImage Halve(QImage &&image) {
+	const auto kernel = SelectedHalveRowPair();
+	const auto width = image.width() / 2;
+	const auto height = image.height() / 2;
+	auto result = QImage(width, height, image.format());
+	result.setDevicePixelRatio(image.devicePixelRatio());
+	for (auto y = 0; y != height; ++y) {
+		kernel(
+			image.constScanLine(2 * y),
+			image.constScanLine(2 * y + 1),
+			result.scanLine(y),
+			width);
+	}
+	return result;
+}
+
+} // namespace
+
+bool IsDownscaleAccelerated() {
+	return SelectedHalveRowPair() != HalveRowPairScalar;
+}
+
+QImage SmoothDownscale(
+		QImage image,
+		int maxWidth,
+		int maxHeight,
+		Qt::AspectRatioMode mode) {
+	if (image.isNull()
+		|| maxWidth <= 0
+		|| maxHeight <= 0
+		|| (image.width() <= maxWidth && image.height() <= maxHeight)) {
+		return image;
+	}
+	if (image.format() == QImage::Format_ARGB32) {
+		// Channel-wise averaging is only correct on premultiplied data,
+		// and Qt premultiplies for smooth scaling anyway.
+		image = std::move(image).convertToFormat(
+			QImage::Format_ARGB32_Premultiplied);
+	}
+	if (image.format() == QImage::Format_RGB32
+		|| image.format() == QImage::Format_ARGB32_Premultiplied) {
+		while (image.width() >= 2 * maxWidth
+			&& image.height() >= 2 * maxHeight) {
+			image = Halve(std::move(image));
+		}
+		if (image.width() <= maxWidth && image.height() <= maxHeight) {
+			return image;
+		}
+	}
+	return image.scaled(maxWidth, maxHeight, mode, Qt::SmoothTransformation);
+}
+
+} // namespace Images
@@ -0,0 +1,25 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Images {
+
+// Returns true when a vector (AVX2 / SSE2 / NEON) halving kernel is used.
+[[nodiscard]] bool IsDownscaleAccelerated();
+
+// High quality downscale tuned for large sources (screenshots, camera
+// photos). Pre-halves 32-bit images with a 2x2 box filter while the source
+// stays more than twice the target size and finishes with Qt's smooth
+// (bilinear) scaler, so the result matches QImage::scaled() semantics.
+[[nodiscard]] QImage SmoothDownscale(
+	QImage image,
+	int maxWidth,
+	int maxHeight,
+	Qt::AspectRatioMode mode = Qt::KeepAspectRatio);
+
+} // namespace Images
@@ -0,0 +1,54 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "ui/text/cached_paint.h"
+
+#include "ui/painter.h"
+
+namespace Ui::Text {
+
+void CachedPaint::drawElided(
+		Painter &p,
+		const String &text,
+		int x,
+		int y,
+		int availableWidth,
+		const QColor &color) {
+	if (text.isEmpty() || availableWidth <= 0) {
+		return;
+	}
+	const auto ratio = style::DevicePixelRatio();
+	const auto width = std::min(availableWidth, text.maxWidth());
+	const auto height = text.minHeight();
+	const auto textKey = qHash(text.toString());
+	if (_frame.isNull()
+		|| _availableWidth != width
+		|| _color != color
+		|| _ratio != ratio
+		|| _textKey != textKey) {
+		_availableWidth = width;
+		_color = color;
+		_ratio = ratio;
+		_textKey = textKey;
+		_frame = QImage(
+			QSize(width, height) * ratio,
+			QImage::Format_ARGB32_Premultiplied);
+		_frame.setDevicePixelRatio(ratio);
+		_frame.fill(Qt::transparent);
+
+		auto q = Painter(&_frame);
+		q.setPen(color);
+		text.drawElided(q, 0, 0, width);
+	}
+	p.drawImage(x, y, _frame);
+}
+
+void CachedPaint::invalidate() {
+	_frame = QImage();
+}
+
+} // namespace Ui::Text
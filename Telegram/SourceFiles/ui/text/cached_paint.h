@@ -0,0 +1,40 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "ui/text/text.h"
+
+namespace Ui::Text {
+
+// Caches the rendered pixels of a short single-line Text::String so that
+// steady-state repaints (dialog rows while scrolling) blit ready glyphs
+// instead of re-running shaping inside String::drawElided every frame.
+// The cache re-renders itself when the text, the available width, the
+// pen color or the device pixel ratio change.
+class CachedPaint {
+public:
+	void drawElided(
+		Painter &p,
+		const String &text,
+		int x,
+		int y,
+		int availableWidth,
+		const QColor &color);
+
+	void invalidate();
+
+private:
+	QImage _frame;
+	QColor _color;
+	size_t _textKey = 0;
+	int _availableWidth = 0;
+	int _ratio = 0;
+
+};
+
+} // namespace Ui::Text
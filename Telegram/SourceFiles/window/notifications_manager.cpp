@@ -44,6 +44,10 @@ constexpr auto kMinimalDelay = crl::time(100);
 constexpr auto kMinimalForwardDelay = crl::time(500);
 constexpr auto kMinimalAlertDelay = crl::time(500);
 constexpr auto kWaitingForAllGroupedDelay = crl::time(1000);
+
+// A message burst produces that many native notification calls in one
+// event loop iteration, the rest are spread between the iterations.
+constexpr auto kMaxNotificationsPerTurn = 5;
 constexpr auto kReactionNotificationEach = 60 * 60 * crl::time(1000);
 
 #ifdef Q_OS_MAC
@@ -516,6 +520,7 @@ void System::showNext() {
 		return;
 	}
 
+	auto shownCount = 0;
 	while (true) {
 		auto next = 0LL;
 		auto notify = std::optional<ItemNotification>();
@@ -676,6 +681,7 @@ void System::showNext() {
 					.reactionFrom = notify->reactionSender,
 					.reactionEmoji = reaction,
 				});
+				++shownCount;
 			}
 		}
 
@@ -683,6 +689,14 @@ void System::showNext() {
 			_waiters.remove(history);
 			_whenMaps.remove(history);
 		}
+		if (shownCount >= kMaxNotificationsPerTurn) {
+			const auto delay = (nextAlert && nextAlert < ms + kMinimalDelay)
+				? (nextAlert - ms)
+				: kMinimalDelay;
+			nextAlert = 0;
+			_waitTimer.callOnce(delay);
+			break;
+		}
 	}
 	if (nextAlert) {
 		_waitTimer.callOnce(nextAlert - ms);
@@ -369,6 +369,27 @@ bool LoadTheme(
 	return true;
 }
 
+bool LoadThemeFromCache(const QByteArray &content, Instance &out) {
+	const auto &cache = out.cached;
+	if (cache.paletteChecksum != style::palette::Checksum()
+		|| cache.contentChecksum != base::crc32(
+			content.constData(),
+			content.size())
+		|| !out.palette.load(cache.colors)) {
+		return false;
+	}
+	if (!cache.background.isEmpty()) {
+		QDataStream stream(cache.background);
+		QImageReader reader(stream.device());
+		reader.setAutoTransform(true);
+		if (!reader.read(&out.background) || out.background.isNull()) {
+			return false;
+		}
+	}
+	out.tiled = cache.tiled;
+	return true;
+}
+
 bool InitializeFromCache(
 		const QByteArray &content,
 		const Cached &cache) {
@@ -643,7 +664,10 @@ QImage ChatBackground::postprocessBackgroundImage(QImage image) {
 	return PostprocessBackgroundImage(std::move(image), _paper);
 }
 
-void ChatBackground::set(const Data::WallPaper &paper, QImage image) {
+void ChatBackground::set(
+		const Data::WallPaper &paper,
+		QImage image,
+		QImage cachedPrepared) {
 	image = Ui::PreprocessBackgroundImage(std::move(image));
 
 	const auto needResetAdjustable = Data::IsDefaultWallPaper(paper)
@@ -673,7 +697,7 @@ void ChatBackground::set(const Data::WallPaper &paper, QImage image) {
 			image = ReadDefaultImage();
 			setPaper(Data::details::TestingDefaultWallPaper());
 		}
-		setPreparedAfterPaper(std::move(image));
+		setPreparedAfterPaper(std::move(image), QImage());
 	} else {
 		if (Data::IsLegacy1DefaultWallPaper(_paper)) {
 			image.load(qsl(":/gui/art/bg_initial.jpg"));
@@ -688,13 +712,21 @@ void ChatBackground::set(const Data::WallPaper &paper, QImage image) {
 			setPaper(Data::DefaultWallPaper().withParamsFrom(_paper));
 			image = ReadDefaultImage();
 		}
+		const auto writable = (Data::IsDefaultWallPaper(_paper)
+			|| Data::IsLegacy1DefaultWallPaper(_paper))
+			? QImage()
+			: image;
+		setPreparedAfterPaper(std::move(image), std::move(cachedPrepared));
+
+		// The prepared pattern is composed per-pixel from the original,
+		// so it is written to the cache together with it and the paper
+		// settings - the next startup reads it back instead of composing.
 		Local::writeBackground(
 			_paper,
-			((Data::IsDefaultWallPaper(_paper)
-				|| Data::IsLegacy1DefaultWallPaper(_paper))
-				? QImage()
-				: image));
-		setPreparedAfterPaper(std::move(image));
+			writable,
+			((!writable.isNull() && _paper.isPattern())
+				? _prepared
+				: QImage()));
 	}
 	Assert(colorForFill()
 		|| !_gradient.isNull()
@@ -710,24 +742,35 @@ void ChatBackground::set(const Data::WallPaper &paper, QImage image) {
 	checkUploadWallPaper();
 }
 
-void ChatBackground::setPreparedAfterPaper(QImage image) {
+void ChatBackground::setPreparedAfterPaper(
+		QImage image,
+		QImage cachedPrepared) {
+	if (!cachedPrepared.isNull()) {
+		cachedPrepared.setDevicePixelRatio(cRetinaFactor());
+	}
 	const auto &bgColors = _paper.backgroundColors();
 	if (_paper.isPattern() && !image.isNull()) {
 		if (bgColors.size() < 2) {
-			auto prepared = postprocessBackgroundImage(
-				Ui::PreparePatternImage(
-					image,
-					bgColors,
-					_paper.gradientRotation(),
-					_paper.patternOpacity()));
+			auto prepared = !cachedPrepared.isNull()
+				? std::move(cachedPrepared)
+				: postprocessBackgroundImage(
+					Ui::PreparePatternImage(
+						image,
+						bgColors,
+						_paper.gradientRotation(),
+						_paper.patternOpacity()));
 			setPrepared(
 				std::move(image),
 				std::move(prepared),
 				QImage());
 		} else {
-			image = postprocessBackgroundImage(std::move(image));
-			if (Ui::IsPatternInverted(bgColors, _paper.patternOpacity())) {
-				image = Ui::InvertPatternImage(std::move(image));
+			if (!cachedPrepared.isNull()) {
+				image = std::move(cachedPrepared);
+			} else {
+				image = postprocessBackgroundImage(std::move(image));
+				if (Ui::IsPatternInverted(bgColors, _paper.patternOpacity())) {
+					image = Ui::InvertPatternImage(std::move(image));
+				}
 			}
 			setPrepared(
 				image,
@@ -1103,12 +1146,16 @@ void ChatBackground::writeNewBackgroundSettings() {
 	if (tile() != _tileForRevert) {
 		Local::writeSettings();
 	}
+	const auto writable = (Data::IsThemeWallPaper(_paper)
+		|| Data::IsDefaultWallPaper(_paper))
+		? QImage()
+		: _original;
 	Local::writeBackground(
 		_paper,
-		((Data::IsThemeWallPaper(_paper)
-			|| Data::IsDefaultWallPaper(_paper))
-			? QImage()
-			: _original));
+		writable,
+		((!writable.isNull() && _paper.isPattern())
+			? _prepared
+			: QImage()));
 }
 
 void ChatBackground::revert() {
@@ -1167,12 +1214,20 @@ void ChatBackground::reapplyWithNightMode(
 		auto preview = std::make_unique<Preview>();
 		preview->object = std::move(read.object);
 		preview->instance.cached = std::move(read.cache);
-		const auto loaded = LoadTheme(
+		// A night mode toggle reapplies a theme that was fully loaded on
+		// some previous run, so the saved palette and background usually
+		// validate against the content and the zip unpacking, the scheme
+		// parsing and the background decoding with colorizing can all be
+		// skipped, the same way the startup path trusts this cache.
+		const auto loaded = LoadThemeFromCache(
 			preview->object.content,
-			ColorizerForTheme(path),
-			std::nullopt,
-			&preview->instance.cached,
-			&preview->instance);
+			preview->instance)
+			|| LoadTheme(
+				preview->object.content,
+				ColorizerForTheme(path),
+				std::nullopt,
+				&preview->instance.cached,
+				&preview->instance);
 		if (!loaded) {
 			return false;
 		}
@@ -161,7 +161,10 @@ public:
 	void setThemeData(QImage &&themeImage, bool themeTile);
 
 	// This method is setting the default (themed) image if none was set yet.
-	void set(const Data::WallPaper &paper, QImage image = QImage());
+	void set(
+		const Data::WallPaper &paper,
+		QImage image = QImage(),
+		QImage cachedPrepared = QImage());
 	void setTile(bool tile);
 	void setTileDayValue(bool tile);
 	void setTileNightValue(bool tile);
@@ -213,7 +216,7 @@ private:
 	[[nodiscard]] bool started() const;
 	void initialRead();
 	void saveForRevert();
-	void setPreparedAfterPaper(QImage image);
+	void setPreparedAfterPaper(QImage image, QImage cachedPrepared);
 	void setPrepared(QImage original, QImage prepared, QImage gradient);
 	void prepareImageForTiled();
 	void writeNewBackgroundSettings();
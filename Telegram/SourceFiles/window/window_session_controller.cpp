@@ -70,6 +70,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_chat_invite.h"
 #include "api/api_global_privacy.h"
 #include "support/support_helper.h"
+#include "support/support_preload.h"
 #include "storage/file_upload.h"
 #include "facades.h"
 #include "window/themes/window_theme.h"
@@ -83,6 +84,7 @@ namespace {
 
 constexpr auto kCustomThemesInMemory = 5;
 constexpr auto kMaxChatEntryHistorySize = 50;
+constexpr auto kHistoryPreloadDelay = crl::time(300);
 constexpr auto kDayBaseFile = ":/gui/day-custom-base.tdesktop-theme"_cs;
 constexpr auto kNightBaseFile = ":/gui/night-custom-base.tdesktop-theme"_cs;
 
@@ -564,6 +566,7 @@ SessionController::SessionController(
 		_window->widget(),
 		this))
 , _invitePeekTimer([=] { checkInvitePeek(); })
+, _historyPreloadTimer([=] { preloadPendingHistory(); })
 , _defaultChatTheme(std::make_shared<Ui::ChatTheme>())
 , _chatStyle(std::make_unique<Ui::ChatStyle>())
 , _cachedReactionIconFactory(std::make_unique<ReactionIconFactory>()) {
@@ -843,6 +846,32 @@ Dialogs::RowDescriptor SessionController::resolveChatPrevious(
 	return content()->resolveChatPrevious(from);
 }
 
+void SessionController::preloadHistory(not_null<History*> history) {
+	// Warm up the first viewport of a chat the user is aiming at in
+	// the dialogs list, a short dwell filters out rows just passed by.
+	if ((history == _historyPreloadPending)
+		|| (history == _historyPreloaded)
+		|| !history->isEmpty()
+		|| (activeChatCurrent().history() == history)) {
+		return;
+	}
+	_historyPreloadPending = history;
+	_historyPreloadTimer.callOnce(kHistoryPreloadDelay);
+}
+
+void SessionController::preloadPendingHistory() {
+	const auto history = base::take(_historyPreloadPending);
+	if (!history
+		|| !history->isEmpty()
+		|| (activeChatCurrent().history() == history)) {
+		return;
+	}
+	_historyPreloaded = history;
+	[[maybe_unused]] const auto requestId = Support::SendPreloadRequest(
+		history,
+		[] {});
+}
+
 void SessionController::pushToChatEntryHistory(Dialogs::RowDescriptor row) {
 	if (!_chatEntryHistory.empty()
 		&& _chatEntryHistory[_chatEntryHistoryPosition] == row) {
@@ -1364,6 +1393,11 @@ void SessionController::showPeerHistory(
 		PeerId peerId,
 		const SectionShow &params,
 		MsgId msgId) {
+	if (peerId) {
+		// Feeds the startup prefetch with the chat open frequency.
+		session().settings().registerChatOpen(peerId);
+		session().saveSettingsDelayed();
+	}
 	content()->ui_showPeerHistory(peerId, params, msgId);
 }
 
@@ -329,6 +329,8 @@ public:
 	[[nodiscard]] Dialogs::RowDescriptor resolveChatPrevious(
 		Dialogs::RowDescriptor from = {}) const;
 
+	void preloadHistory(not_null<History*> history);
+
 	void showEditPeerBox(PeerData *peer);
 
 	void enableGifPauseReason(GifPauseReason reason);
@@ -511,6 +513,7 @@ private:
 	void resetFakeUnreadWhileOpened();
 
 	void checkInvitePeek();
+	void preloadPendingHistory();
 
 	void pushDefaultChatBackground();
 	void cacheChatTheme(
@@ -546,6 +549,10 @@ private:
 
 	base::Timer _invitePeekTimer;
 
+	base::Timer _historyPreloadTimer;
+	History *_historyPreloadPending = nullptr;
+	History *_historyPreloaded = nullptr;
+
 	rpl::variable<FilterId> _activeChatsFilter;
 
 	rpl::variable<int> _connectingBottomSkip;